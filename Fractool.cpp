@@ -0,0 +1,440 @@
+/**
+ * fractool: one-pass, constant-memory statistics over streams of fractions.
+ *
+ * Usage: fractool [--bins N] [--low X] [--high Y] [--threads T] [--exact] [FILE...]
+ *
+ * Reads text files with one "n/d" per line (blank lines are skipped) or
+ * binary fraction files written by FractionWriter; with no FILE, or with
+ * "-", reads standard input. Prints the count, exact sum, mean, min and max,
+ * and a histogram of [low, high) split into N bins.
+ *
+ * The sum stays exact while its denominator fits in EXACT_SUM_BITS; past that
+ * it is reported as inexact, with the floating-point sum. --exact lifts the
+ * limit, at a cost in time and memory that grows with every distinct
+ * denominator in the input.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sources/BigFraction.hpp"
+#include "sources/FractionBinary.hpp"
+#include "sources/FractionDetail.hpp"
+#include "sources/FractionLoader.hpp"
+#include "sources/MappedFile.hpp"
+
+using namespace std;
+using namespace ariel;
+
+namespace {
+
+    const size_t READ_BUFFER_BYTES = 1 << 20;
+    // Without --exact, a sum whose denominator needs more bits than this is dropped and reported as inexact.
+    const size_t EXACT_SUM_BITS = 1024;
+
+    struct Options {
+        size_t bins = 10;
+        double low = 0;
+        double high = 1;
+        unsigned threads = 0;
+        bool exact = false;
+        vector<string> inputs;
+    };
+
+    string toString(__int128 value) {
+        if (value == 0) {
+            return "0";
+        }
+        bool negative = value < 0;
+        string digits;
+        while (value != 0) {
+            int digit = static_cast<int>(value % 10);
+            digits.push_back(static_cast<char>('0' + (digit < 0 ? -digit : digit)));
+            value /= 10;
+        }
+        if (negative) {
+            digits.push_back('-');
+        }
+        return string(digits.rbegin(), digits.rend());
+    }
+
+    // Running aggregates of one input slice; slices combine with merge().
+    struct Summary {
+        unsigned long long count = 0;
+        __int128 sumNumerator = 0;
+        __int128 sumDenominator = 1;
+        // The part of the sum that no longer fit in 128 bits; the exact sum is bigSum + sumNumerator/sumDenominator.
+        BigFraction bigSum;
+        bool spilled = false;
+        // Set once the exact sum outgrew EXACT_SUM_BITS; only approximateSum is kept from then on.
+        bool inexact = false;
+        double approximateSum = 0;
+        long long minNumerator = 0, minDenominator = 1;
+        long long maxNumerator = 0, maxDenominator = 1;
+        unsigned long long below = 0, above = 0;
+        vector<unsigned long long> histogram;
+        const Options* options = nullptr;
+
+        explicit Summary(const Options& options) : histogram(options.bins, 0), options(&options) {}
+
+        void addExact(__int128 numerator, __int128 denominator) {
+            if (inexact) {
+                return;
+            }
+            __int128 common = static_cast<__int128>(detail::gcdWide(sumDenominator, denominator));
+            __int128 scale = denominator / common;
+            __int128 left = 0;
+            __int128 right = 0;
+            __int128 total = 0;
+            __int128 newDenominator = 0;
+            if (__builtin_mul_overflow(sumNumerator, scale, &left) ||
+            __builtin_mul_overflow(numerator, sumDenominator / common, &right) ||
+            __builtin_add_overflow(left, right, &total) ||
+            __builtin_mul_overflow(sumDenominator, scale, &newDenominator)) {
+                spillSum();
+                addExact(numerator, denominator);
+                return;
+            }
+            __int128 reduce = static_cast<__int128>(detail::gcdWide(total, newDenominator));
+            sumNumerator = total / reduce;
+            sumDenominator = newDenominator / reduce;
+        }
+
+        void spillSum() {
+            absorb(BigFraction(BigInt::fromInt128(sumNumerator), BigInt::fromInt128(sumDenominator)));
+            sumNumerator = 0;
+            sumDenominator = 1;
+        }
+
+        // Adds part to bigSum, or gives up on the exact sum if the result is wider than allowed.
+        void absorb(const BigFraction& part) {
+            BigFraction total = bigSum + part;
+            if (!options->exact && total.getDenominator().bitLength() > EXACT_SUM_BITS) {
+                dropExact();
+                return;
+            }
+            bigSum = total;
+            spilled = true;
+        }
+
+        void dropExact() {
+            inexact = true;
+            spilled = false;
+            bigSum = BigFraction();
+            sumNumerator = 0;
+            sumDenominator = 1;
+        }
+
+        BigFraction exactSum() const {
+            return bigSum + BigFraction(BigInt::fromInt128(sumNumerator), BigInt::fromInt128(sumDenominator));
+        }
+
+        void add(long long numerator, long long denominator) {
+            if (denominator < 0) {
+                numerator = -numerator;
+                denominator = -denominator;
+            }
+            if (count == 0 || __int128{numerator} * minDenominator < __int128{minNumerator} * denominator) {
+                minNumerator = numerator;
+                minDenominator = denominator;
+            }
+            if (count == 0 || __int128{numerator} * maxDenominator > __int128{maxNumerator} * denominator) {
+                maxNumerator = numerator;
+                maxDenominator = denominator;
+            }
+            ++count;
+            addExact(numerator, denominator);
+            double value = static_cast<double>(numerator) / static_cast<double>(denominator);
+            approximateSum += value;
+            if (value < options->low) {
+                ++below;
+            } else if (value >= options->high) {
+                ++above;
+            } else {
+                auto bin = static_cast<size_t>((value - options->low) / (options->high - options->low) * static_cast<double>(options->bins));
+                ++histogram[min(bin, options->bins - 1)];
+            }
+        }
+
+        void merge(const Summary& other) {
+            if (other.count == 0) {
+                return;
+            }
+            if (count == 0 || __int128{other.minNumerator} * minDenominator < __int128{minNumerator} * other.minDenominator) {
+                minNumerator = other.minNumerator;
+                minDenominator = other.minDenominator;
+            }
+            if (count == 0 || __int128{other.maxNumerator} * maxDenominator > __int128{maxNumerator} * other.maxDenominator) {
+                maxNumerator = other.maxNumerator;
+                maxDenominator = other.maxDenominator;
+            }
+            count += other.count;
+            if (other.inexact) {
+                dropExact();
+            } else if (!inexact && other.spilled) {
+                absorb(other.bigSum);
+            }
+            addExact(other.sumNumerator, other.sumDenominator);
+            approximateSum += other.approximateSum;
+            below += other.below;
+            above += other.above;
+            for (size_t bin = 0; bin < histogram.size(); ++bin) {
+                histogram[bin] += other.histogram[bin];
+            }
+        }
+    };
+
+    // Aggregates the lines of [first, last); returns 0, or the 1-based line of the first error.
+    size_t consumeText(const char* first, const char* last, Summary& summary, const char*& error) {
+        size_t line = 1;
+        while (first != last) {
+            const char* newline = static_cast<const char*>(memchr(first, '\n', static_cast<size_t>(last - first)));
+            const char* lineEnd = (newline == nullptr) ? last : newline;
+            const char* content = first;
+            while (content != lineEnd && (*content == ' ' || *content == '\t' || *content == '\r')) {
+                ++content;
+            }
+            if (content != lineEnd) {
+                int numerator = 0;
+                int denominator = 1;
+                ParseResult result = parseFraction(content, lineEnd, numerator, denominator);
+                while (result.error == nullptr && result.ptr != lineEnd && (*result.ptr == ' ' || *result.ptr == '\t' || *result.ptr == '\r')) {
+                    ++result.ptr;
+                }
+                if (result.error == nullptr && result.ptr != lineEnd) {
+                    result.error = "Unexpected characters after fraction";
+                }
+                if (result.error != nullptr) {
+                    error = result.error;
+                    return line;
+                }
+                summary.add(numerator, denominator);
+            }
+            ++line;
+            first = (newline == nullptr) ? last : newline + 1;
+        }
+        return 0;
+    }
+
+    void consumeTextStream(istream& in, const string& name, Summary& summary) {
+        vector<char> buffer(READ_BUFFER_BYTES);
+        size_t kept = 0;
+        size_t linesBefore = 0;
+        while (true) {
+            in.read(buffer.data() + kept, static_cast<streamsize>(buffer.size() - kept));
+            size_t filled = kept + static_cast<size_t>(in.gcount());
+            bool done = filled == kept;
+            const char* end = buffer.data() + filled;
+            if (!done) {
+                // Only whole lines are parsed; the partial last line moves to the front of the buffer.
+                const char* lastNewline = nullptr;
+                for (const char* cursor = end; cursor != buffer.data(); --cursor) {
+                    if (cursor[-1] == '\n') {
+                        lastNewline = cursor;
+                        break;
+                    }
+                }
+                if (lastNewline == nullptr && filled == buffer.size()) {
+                    buffer.resize(buffer.size() * 2);
+                    kept = filled;
+                    continue;
+                }
+                end = (lastNewline == nullptr) ? buffer.data() : lastNewline;
+            }
+            const char* error = nullptr;
+            size_t line = consumeText(buffer.data(), end, summary, error);
+            if (line != 0) {
+                throw FractionParseError(name, linesBefore + line, error);
+            }
+            linesBefore += static_cast<size_t>(count(static_cast<const char*>(buffer.data()), end, '\n'));
+            if (done) {
+                return;
+            }
+            kept = static_cast<size_t>(buffer.data() + filled - end);
+            memmove(buffer.data(), end, kept);
+        }
+    }
+
+    void consumeTextFile(const string& path, const Options& options, Summary& summary) {
+        MappedFile file(path);
+        vector<string_view> pieces = splitLines(file.data(), file.size(), options.threads * detail::CHUNKS_PER_THREAD);
+        vector<Summary> partials(pieces.size(), Summary(options));
+        vector<const char*> errors(pieces.size(), nullptr);
+        vector<size_t> errorLines(pieces.size(), 0);
+        detail::runParallel(pieces.size(), options.threads, [&](size_t index) {
+            errorLines[index] = consumeText(pieces[index].data(), pieces[index].data() + pieces[index].size(), partials[index], errors[index]);
+        });
+        for (size_t index = 0; index < pieces.size(); ++index) {
+            if (errorLines[index] != 0) {
+                auto before = static_cast<size_t>(count(file.data(), pieces[index].data(), '\n'));
+                throw FractionParseError(path, before + errorLines[index], errors[index]);
+            }
+            summary.merge(partials[index]);
+        }
+    }
+
+    void consumeBinaryFile(const string& path, const Options& options, Summary& summary) {
+        FractionFileReader reader(path, false);
+        if (reader.encoding() != FractionEncoding::Fixed) {
+            ifstream in(path, ios::binary);
+            FractionStreamReader stream(in);
+            FractionRecord record{};
+            while (stream.next(record)) {
+                summary.add(record.numerator, record.denominator);
+            }
+            return;
+        }
+        vector<Summary> partials(options.threads, Summary(options));
+        vector<char> corrupt(reader.blockCount(), 0);
+        detail::runParallel(options.threads, options.threads, [&](size_t worker) {
+            for (size_t block = worker; block < reader.blockCount(); block += options.threads) {
+                if (!reader.verifyBlock(block)) {
+                    corrupt[block] = 1;
+                    continue;
+                }
+                for (const FractionRecord& record : reader.recordsOf(block)) {
+                    if (record.denominator == 0) {
+                        corrupt[block] = 1;
+                        break;
+                    }
+                    partials[worker].add(record.numerator, record.denominator);
+                }
+            }
+        });
+        for (size_t block = 0; block < corrupt.size(); ++block) {
+            if (corrupt[block] != 0) {
+                throw runtime_error(path + " has a corrupt block " + to_string(block));
+            }
+        }
+        for (const Summary& partial : partials) {
+            summary.merge(partial);
+        }
+    }
+
+    void consumeInput(const string& input, const Options& options, Summary& summary) {
+        if (input == "-") {
+            if (cin.peek() == 'F') {
+                FractionStreamReader stream(cin);
+                FractionRecord record{};
+                while (stream.next(record)) {
+                    summary.add(record.numerator, record.denominator);
+                }
+            } else {
+                consumeTextStream(cin, "<stdin>", summary);
+            }
+            return;
+        }
+        char magic[4] = {};
+        {
+            ifstream probe(input, ios::binary);
+            if (!probe) {
+                throw runtime_error("Cannot open " + input);
+            }
+            probe.read(magic, sizeof(magic));
+        }
+        if (memcmp(magic, "FRAC", sizeof(magic)) == 0) {
+            consumeBinaryFile(input, options, summary);
+        } else {
+            consumeTextFile(input, options, summary);
+        }
+    }
+
+    string describe(long long numerator, long long denominator) {
+        return to_string(numerator) + "/" + to_string(denominator) + " (" + to_string(static_cast<double>(numerator) / static_cast<double>(denominator)) + ")";
+    }
+
+    void report(const Summary& summary, const Options& options) {
+        cout << "count: " << summary.count << "\n";
+        if (summary.count == 0) {
+            return;
+        }
+        double mean = summary.approximateSum / static_cast<double>(summary.count);
+        __int128 count = static_cast<__int128>(summary.count);
+        __int128 common = static_cast<__int128>(detail::gcdWide(summary.sumNumerator, count));
+        __int128 meanDenominator = 0;
+        if (summary.inexact) {
+            cout << "sum: inexact (" << summary.approximateSum << "); the exact sum needs a denominator over " << EXACT_SUM_BITS
+                 << " bits, rerun with --exact to keep it\n";
+            cout << "mean: inexact (" << mean << ")\n";
+        } else if (summary.spilled || __builtin_mul_overflow(summary.sumDenominator, count / common, &meanDenominator)) {
+            BigFraction sum = summary.exactSum();
+            cout << "sum: " << sum << " (" << summary.approximateSum << ")\n";
+            cout << "mean: " << sum / BigFraction(BigInt(static_cast<long long>(summary.count))) << " (" << mean << ")\n";
+        } else {
+            cout << "sum: " << toString(summary.sumNumerator) << "/" << toString(summary.sumDenominator) << " (" << summary.approximateSum << ")\n";
+            cout << "mean: " << toString(summary.sumNumerator / common) << "/" << toString(meanDenominator) << " (" << mean << ")\n";
+        }
+        cout << "min: " << describe(summary.minNumerator, summary.minDenominator) << "\n";
+        cout << "max: " << describe(summary.maxNumerator, summary.maxDenominator) << "\n";
+        cout << "histogram:\n";
+        cout << "  < " << options.low << ": " << summary.below << "\n";
+        double width = (options.high - options.low) / static_cast<double>(options.bins);
+        for (size_t bin = 0; bin < options.bins; ++bin) {
+            double from = options.low + width * static_cast<double>(bin);
+            cout << "  [" << from << ", " << from + width << "): " << summary.histogram[bin] << "\n";
+        }
+        cout << "  >= " << options.high << ": " << summary.above << "\n";
+    }
+
+    Options parseOptions(int argc, char** argv) {
+        Options options;
+        vector<string> args(argv + 1, argv + argc);
+        for (size_t index = 0; index < args.size(); ++index) {
+            const string& arg = args[index];
+            auto value = [&]() -> const string& {
+                if (index + 1 >= args.size()) {
+                    throw invalid_argument(arg + " needs a value");
+                }
+                return args[++index];
+            };
+            if (arg == "--bins") {
+                options.bins = stoul(value());
+            } else if (arg == "--low") {
+                options.low = stod(value());
+            } else if (arg == "--high") {
+                options.high = stod(value());
+            } else if (arg == "--threads") {
+                options.threads = static_cast<unsigned>(stoul(value()));
+            } else if (arg == "--exact") {
+                options.exact = true;
+            } else if (arg.size() > 1 && arg[0] == '-' && arg != "-") {
+                throw invalid_argument("Unknown option " + arg);
+            } else {
+                options.inputs.push_back(arg);
+            }
+        }
+        if (options.bins == 0 || !(options.low < options.high)) {
+            throw invalid_argument("Need --bins > 0 and --low < --high");
+        }
+        if (options.threads == 0) {
+            options.threads = max(1U, thread::hardware_concurrency());
+        }
+        if (options.inputs.empty()) {
+            options.inputs.emplace_back("-");
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv) {
+    ios::sync_with_stdio(false);
+    try {
+        Options options = parseOptions(argc, argv);
+        Summary summary(options);
+        for (const string& input : options.inputs) {
+            consumeInput(input, options, summary);
+        }
+        report(summary, options);
+    } catch (const exception& error) {
+        cerr << "fractool: " << error.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,401 @@
+/**
+ * Randomized soak test: runs every Fraction operator on random operands
+ * across several threads and checks each result against an exact __int128
+ * oracle. Operand i of a run is a pure function of (seed, i), so any
+ * reported case can be replayed on its own with --seed S --start I --ops 1.
+ *
+ * What each operator must do, given the exact result r:
+ *   constructor, + - * / ++ --, checked_*   return exactly r when r fits in int and throw
+ *                                            (or return FracError::Overflow) when it does not
+ *   /, checked_div by zero                   throw runtime_error / return DivideByZero
+ *   < > <= >=                                agree with the exact comparison
+ *   == !=                                    equal fractions compare equal; fractions at least
+ *                                            0.002 apart compare unequal (== has a 0.001 tolerance)
+ *   << then >>                               round-trips the value
+ *   float < > <= >= Fraction                 agree with the exact comparison of Fraction(float)
+ *                                            against the right operand
+ * The operators also throw when an intermediate product leaves int even though r fits.
+ * Those conservative throws are counted and logged as "spurious overflow", and only fail
+ * the run with --strict. The float == and != overloads compare through float with a
+ * tolerance and are not checked.
+ *
+ * Usage: stress_test [--ops n] [--threads n] [--seed n] [--start n] [--log n] [--strict]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sources/Fraction.hpp"
+#include "sources/FractionDetail.hpp"
+
+using namespace std;
+using namespace ariel;
+
+namespace {
+
+    enum Operator {
+        Construct, Add, Subtract, Multiply, Divide, CheckedAdd, CheckedSubtract, CheckedMultiply, CheckedDivide,
+        Less, Greater, LessEqual, GreaterEqual, Equal, NotEqual, PreIncrement, PostIncrement, PreDecrement, PostDecrement,
+        Stream, FloatLess, FloatGreater, FloatLessEqual, FloatGreaterEqual, OPERATOR_COUNT
+    };
+
+    const char* const OPERATOR_NAMES[OPERATOR_COUNT] = {
+        "Fraction(int,int)", "operator+", "operator-", "operator*", "operator/", "checked_add", "checked_sub", "checked_mul",
+        "checked_div", "operator<", "operator>", "operator<=", "operator>=", "operator==", "operator!=", "operator++()",
+        "operator++(int)", "operator--()", "operator--(int)", "operator<< >>", "operator<(float)", "operator>(float)", "operator<=(float)", "operator>=(float)"
+    };
+
+    const long long INT_MAX_VALUE = numeric_limits<int>::max();
+
+    // splitmix64: a fast, well-mixed stream that can be entered at any index.
+    struct Random {
+        uint64_t state;
+        uint64_t next() {
+            uint64_t value = (state += 0x9E3779B97F4A7C15ULL);
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+            return value ^ (value >> 31);
+        }
+        long long below(long long bound) {
+            return static_cast<long long>(next() % static_cast<uint64_t>(bound));
+        }
+    };
+
+    // Mostly small terms, with a share of large, full-range and edge values; never INT_MIN.
+    int randomTerm(Random& random, bool allowZero) {
+        static const int EDGES[] = {1, 2, 46340, 46341, 65535, 65536, numeric_limits<int>::max(), numeric_limits<int>::max() - 1};
+        long long kind = random.below(10);
+        long long magnitude = 0;
+        if (kind < 4) {
+            magnitude = 1 + random.below(1000);
+        } else if (kind < 7) {
+            magnitude = 1 + random.below(46341);
+        } else if (kind < 9) {
+            magnitude = 1 + random.below(INT_MAX_VALUE);
+        } else {
+            magnitude = EDGES[random.below(sizeof(EDGES) / sizeof(EDGES[0]))];
+        }
+        if (allowZero && random.below(50) == 0) {
+            magnitude = 0;
+        }
+        return static_cast<int>(random.below(2) == 0 ? magnitude : -magnitude);
+    }
+
+    struct Exact {
+        __int128 numerator;
+        __int128 denominator;
+    };
+
+    Exact reduce(__int128 numerator, __int128 denominator) {
+        auto divisor = static_cast<__int128>(detail::gcdWide(numerator, denominator));
+        numerator /= divisor;
+        denominator /= divisor;
+        if (denominator < 0) {
+            numerator = -numerator;
+            denominator = -denominator;
+        }
+        return Exact{numerator, denominator};
+    }
+
+    bool fits(const Exact& value) {
+        return value.numerator >= numeric_limits<int>::min() && value.numerator <= INT_MAX_VALUE && value.denominator <= INT_MAX_VALUE;
+    }
+
+    bool same(const Fraction& fraction, const Exact& value) {
+        return fraction.getNumerator() == value.numerator && fraction.getDenominator() == value.denominator;
+    }
+
+    string show(const Exact& value) {
+        auto text = [](__int128 number) {
+            bool negative = number < 0;
+            unsigned __int128 magnitude = negative ? -static_cast<unsigned __int128>(number) : static_cast<unsigned __int128>(number);
+            string digits;
+            do {
+                digits.insert(digits.begin(), static_cast<char>('0' + static_cast<int>(magnitude % 10)));
+                magnitude /= 10;
+            } while (magnitude != 0);
+            return negative ? "-" + digits : digits;
+        };
+        return text(value.numerator) + "/" + text(value.denominator);
+    }
+
+    string show(const Fraction& fraction) {
+        return to_string(fraction.getNumerator()) + "/" + to_string(fraction.getDenominator());
+    }
+
+    enum Verdict { Pass, Mismatch, SpuriousOverflow };
+
+    struct Outcome {
+        Verdict verdict = Pass;
+        string detail;
+    };
+
+    Outcome fail(Verdict verdict, const string& detail) {
+        return Outcome{verdict, detail};
+    }
+
+    // Check an arithmetic result, given as a thunk that may throw, against the exact value.
+    template <typename Call>
+    Outcome checkArithmetic(Call call, const Exact& expected) {
+        try {
+            Fraction actual = call();
+            if (!fits(expected)) {
+                return fail(Mismatch, "returned " + show(actual) + " but the exact result " + show(expected) + " does not fit in int");
+            }
+            if (!same(actual, expected)) {
+                return fail(Mismatch, "returned " + show(actual) + ", expected " + show(expected));
+            }
+        } catch (const overflow_error&) {
+            if (fits(expected)) {
+                return fail(SpuriousOverflow, "threw overflow_error, exact result " + show(expected) + " fits");
+            }
+        } catch (const exception& error) {
+            return fail(Mismatch, string("threw ") + error.what() + ", expected " + show(expected));
+        }
+        return Outcome{};
+    }
+
+    Outcome checkChecked(const FractionResult& result, const Exact& expected) {
+        if (result) {
+            return checkArithmetic([&]() { return *result; }, expected);
+        }
+        if (result.error() != FracError::Overflow) {
+            return fail(Mismatch, "returned DivideByZero, expected " + show(expected));
+        }
+        return fits(expected) ? fail(SpuriousOverflow, "returned Overflow, exact result " + show(expected) + " fits") : Outcome{};
+    }
+
+    template <typename Call>
+    Outcome checkDivideByZero(Call call) {
+        try {
+            call();
+        } catch (const runtime_error&) {
+            return Outcome{};
+        }
+        return fail(Mismatch, "division by zero did not throw");
+    }
+
+    Outcome checkComparison(bool actual, bool expected) {
+        return actual == expected ? Outcome{} : fail(Mismatch, string("returned ") + (actual ? "true" : "false"));
+    }
+
+    /**
+     * @brief Run case `index` of the stream seeded by `seed`.
+     * @param op Receives the operator that was exercised.
+     * @param terms Receives the operand terms, for the log.
+     */
+    Outcome runCase(uint64_t seed, uint64_t index, Operator& op, int (&terms)[4]) {
+        Random random{seed ^ (index * 0xD1B54A32D192ED03ULL)};
+        op = static_cast<Operator>(random.below(OPERATOR_COUNT));
+        int leftNumerator = randomTerm(random, true);
+        int leftDenominator = randomTerm(random, false);
+        int rightNumerator = randomTerm(random, true);
+        int rightDenominator = randomTerm(random, false);
+        terms[0] = leftNumerator;
+        terms[1] = leftDenominator;
+        terms[2] = rightNumerator;
+        terms[3] = rightDenominator;
+        if (op == Construct) {
+            return checkArithmetic([&]() { return Fraction(leftNumerator, leftDenominator); }, reduce(leftNumerator, leftDenominator));
+        }
+
+        Fraction left(leftNumerator, leftDenominator);
+        Fraction right(rightNumerator, rightDenominator);
+        __int128 leftNum = left.getNumerator();
+        __int128 leftDen = left.getDenominator();
+        __int128 rightNum = right.getNumerator();
+        __int128 rightDen = right.getDenominator();
+        __int128 crossLeft = leftNum * rightDen;
+        __int128 crossRight = rightNum * leftDen;
+        Exact sum = reduce(crossLeft + crossRight, leftDen * rightDen);
+        Exact difference = reduce(crossLeft - crossRight, leftDen * rightDen);
+        Exact product = reduce(leftNum * rightNum, leftDen * rightDen);
+        Exact plusOne = reduce(leftNum + leftDen, leftDen);
+        Exact minusOne = reduce(leftNum - leftDen, leftDen);
+
+        // The float overloads convert the float to a Fraction first; keep it in the range that conversion handles.
+        auto number = static_cast<float>(leftNumerator % 1000000) / 1000;
+        Fraction converted(number);
+        __int128 floatLeft = __int128{converted.getNumerator()} * rightDen;
+        __int128 floatRight = rightNum * converted.getDenominator();
+
+        switch (op) {
+            case Add:
+                return checkArithmetic([&]() { return left + right; }, sum);
+            case Subtract:
+                return checkArithmetic([&]() { return left - right; }, difference);
+            case Multiply:
+                return checkArithmetic([&]() { return left * right; }, product);
+            case Divide:
+                if (rightNum == 0) {
+                    return checkDivideByZero([&]() { return left / right; });
+                }
+                return checkArithmetic([&]() { return left / right; }, reduce(crossLeft, leftDen * rightNum));
+            case CheckedAdd:
+                return checkChecked(checked_add(left, right), sum);
+            case CheckedSubtract:
+                return checkChecked(checked_sub(left, right), difference);
+            case CheckedMultiply:
+                return checkChecked(checked_mul(left, right), product);
+            case CheckedDivide:
+                if (rightNum == 0) {
+                    FractionResult result = checked_div(left, right);
+                    return !result && result.error() == FracError::DivideByZero ? Outcome{} : fail(Mismatch, "division by zero was not reported");
+                }
+                return checkChecked(checked_div(left, right), reduce(crossLeft, leftDen * rightNum));
+            case Less:
+                return checkComparison(left < right, crossLeft < crossRight);
+            case Greater:
+                return checkComparison(left > right, crossLeft > crossRight);
+            case LessEqual:
+                return checkComparison(left <= right, crossLeft <= crossRight);
+            case GreaterEqual:
+                return checkComparison(left >= right, crossLeft >= crossRight);
+            case Equal:
+            case NotEqual: {
+                bool equal = (op == Equal) ? (left == right) : !(left != right);
+                double gap = static_cast<double>(crossLeft - crossRight) / static_cast<double>(leftDen * rightDen);
+                if (crossLeft == crossRight && !equal) {
+                    return fail(Mismatch, "equal fractions compared unequal");
+                }
+                if ((gap >= 0.002 || gap <= -0.002) && equal) {
+                    return fail(Mismatch, "fractions " + to_string(gap) + " apart compared equal");
+                }
+                return Outcome{};
+            }
+            case PreIncrement:
+                return checkArithmetic([&]() { Fraction value = left; Fraction returned = ++value; return same(returned, {value.getNumerator(), value.getDenominator()}) ? value : Fraction(); }, plusOne);
+            case PostIncrement: {
+                Fraction value = left;
+                Outcome outcome = checkArithmetic([&]() { Fraction old = value++; return same(old, {leftNum, leftDen}) ? value : Fraction(); }, plusOne);
+                return outcome;
+            }
+            case PreDecrement:
+                return checkArithmetic([&]() { Fraction value = left; Fraction returned = --value; return same(returned, {value.getNumerator(), value.getDenominator()}) ? value : Fraction(); }, minusOne);
+            case PostDecrement: {
+                Fraction value = left;
+                return checkArithmetic([&]() { Fraction old = value--; return same(old, {leftNum, leftDen}) ? value : Fraction(); }, minusOne);
+            }
+            case FloatLess:
+                return checkComparison(number < right, floatLeft < floatRight);
+            case FloatGreater:
+                return checkComparison(number > right, floatLeft > floatRight);
+            case FloatLessEqual:
+                return checkComparison(number <= right, floatLeft <= floatRight);
+            case FloatGreaterEqual:
+                return checkComparison(number >= right, floatLeft >= floatRight);
+            default: {
+                stringstream stream;
+                stream << left;
+                Fraction parsed;
+                stream >> parsed;
+                return same(parsed, {leftNum, leftDen}) ? Outcome{} : fail(Mismatch, "wrote " + stream.str() + ", read back " + show(parsed));
+            }
+        }
+    }
+
+    struct Totals {
+        atomic<uint64_t> cases[OPERATOR_COUNT] = {};
+        atomic<uint64_t> mismatches[OPERATOR_COUNT] = {};
+        atomic<uint64_t> spurious[OPERATOR_COUNT] = {};
+        atomic<uint64_t> logged{0};
+        mutex logLock;
+    };
+}
+
+int main(int argc, char** argv) {
+    uint64_t operations = 10000000;
+    uint64_t seed = static_cast<uint64_t>(chrono::steady_clock::now().time_since_epoch().count());
+    uint64_t start = 0;
+    uint64_t logLimit = 20;
+    unsigned threadCount = max(1u, thread::hardware_concurrency());
+    bool strict = false;
+    for (int index = 1; index < argc; ++index) {
+        string argument = argv[index];
+        bool hasValue = index + 1 < argc;
+        if (argument == "--strict") {
+            strict = true;
+        } else if (argument == "--ops" && hasValue) {
+            operations = stoull(argv[++index]);
+        } else if (argument == "--threads" && hasValue) {
+            threadCount = max(1u, static_cast<unsigned>(stoul(argv[++index])));
+        } else if (argument == "--seed" && hasValue) {
+            seed = stoull(argv[++index]);
+        } else if (argument == "--start" && hasValue) {
+            start = stoull(argv[++index]);
+        } else if (argument == "--log" && hasValue) {
+            logLimit = stoull(argv[++index]);
+        } else {
+            cerr << "usage: " << argv[0] << " [--ops n] [--threads n] [--seed n] [--start n] [--log n] [--strict]\n";
+            return 2;
+        }
+    }
+    cout << "seed " << seed << ", " << operations << " operations from index " << start << " on " << threadCount << " threads\n";
+
+    Totals totals;
+    const uint64_t BATCH = 1 << 14;
+    atomic<uint64_t> nextBatch{0};
+    auto worker = [&]() {
+        uint64_t cases[OPERATOR_COUNT] = {};
+        for (;;) {
+            uint64_t first = nextBatch.fetch_add(BATCH, memory_order_relaxed);
+            if (first >= operations) {
+                break;
+            }
+            uint64_t last = min(operations, first + BATCH);
+            for (uint64_t offset = first; offset < last; ++offset) {
+                Operator op = Construct;
+                int terms[4];
+                Outcome outcome = runCase(seed, start + offset, op, terms);
+                ++cases[op];
+                if (outcome.verdict == Pass) {
+                    continue;
+                }
+                (outcome.verdict == Mismatch ? totals.mismatches : totals.spurious)[op].fetch_add(1, memory_order_relaxed);
+                if (totals.logged.fetch_add(1, memory_order_relaxed) < logLimit) {
+                    lock_guard<mutex> guard(totals.logLock);
+                    cout << (outcome.verdict == Mismatch ? "MISMATCH " : "spurious overflow ") << OPERATOR_NAMES[op] << "(" << terms[0] << "/" << terms[1] << ", "
+                         << terms[2] << "/" << terms[3] << "): "
+                         << outcome.detail << "  [replay: --seed " << seed << " --start " << start + offset << " --ops 1]\n";
+                }
+            }
+        }
+        for (size_t op = 0; op < OPERATOR_COUNT; ++op) {
+            totals.cases[op].fetch_add(cases[op], memory_order_relaxed);
+        }
+    };
+
+    auto began = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (unsigned index = 0; index < threadCount; ++index) {
+        threads.emplace_back(worker);
+    }
+    for (thread& each : threads) {
+        each.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - began).count();
+
+    uint64_t mismatches = 0;
+    uint64_t spurious = 0;
+    cout << left << setw(20) << "operator" << right << setw(14) << "cases" << setw(12) << "mismatches" << setw(12) << "spurious" << "\n";
+    for (size_t op = 0; op < OPERATOR_COUNT; ++op) {
+        cout << left << setw(20) << OPERATOR_NAMES[op] << right << setw(14) << totals.cases[op].load() << setw(12) << totals.mismatches[op].load()
+             << setw(12) << totals.spurious[op].load() << "\n";
+        mismatches += totals.mismatches[op].load();
+        spurious += totals.spurious[op].load();
+    }
+    cout << fixed << setprecision(0) << static_cast<double>(operations) / seconds << " ops/s (" << setprecision(2) << seconds << " s), "
+         << mismatches << " mismatches, " << spurious << " spurious overflow throws\n";
+    return (mismatches > 0 || (strict && spurious > 0)) ? 1 : 0;
+}
@@ -0,0 +1,1128 @@
+#include "doctest.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "sources/Fraction.hpp"
+#include "sources/FractionLoader.hpp"
+#include "sources/FractionBinary.hpp"
+#include "sources/FractionColumn.hpp"
+#include "sources/FractionPolicy.hpp"
+#include "sources/DynFraction.hpp"
+#include "sources/FractionCounters.hpp"
+#include "sources/FractionProfile.hpp"
+#include "sources/ContinuedFraction.hpp"
+#include "sources/FareySequence.hpp"
+#include "sources/Quantizer.hpp"
+#include "sources/FractionInterval.hpp"
+#include "sources/FractionPolynomial.hpp"
+#include "sources/ModularEngine.hpp"
+#include "sources/SeriesSum.hpp"
+#include "sources/FractionStats.hpp"
+#include "sources/Simplex.hpp"
+using namespace ariel;
+using namespace std;
+
+TEST_SUITE("Bulk loader tests") {
+
+    TEST_CASE("parseFraction reduces like the constructor") {
+        string text = " 6/-8 ";
+        int num = 0;
+        int den = 0;
+        ParseResult result = parseFraction(text.data(), text.data() + text.size(), num, den);
+        CHECK(result.error == nullptr);
+        CHECK(num == -3);
+        CHECK(den == 4);
+
+        text = "3 0";
+        CHECK(parseFraction(text.data(), text.data() + text.size(), num, den).error != nullptr);
+        text = "3.5/4";
+        CHECK(parseFraction(text.data(), text.data() + text.size(), num, den).error != nullptr);
+        text = "7";
+        CHECK(parseFraction(text.data(), text.data() + text.size(), num, den).error != nullptr);
+        text = "-9223372036854775808/-1";
+        CHECK(parseFraction(text.data(), text.data() + text.size(), num, den).error != nullptr);
+        text = "1/-9223372036854775808";
+        CHECK(parseFraction(text.data(), text.data() + text.size(), num, den).error != nullptr);
+        text = "-2147483648/-2147483648";
+        CHECK(parseFraction(text.data(), text.data() + text.size(), num, den).error == nullptr);
+        CHECK(num == 1);
+        CHECK(den == 1);
+    }
+
+    TEST_CASE("loadFractions keeps file order across chunks") {
+        const string path = "loader_test.txt";
+        {
+            ofstream out(path);
+            for (int index = 1; index <= 5000; ++index) {
+                out << index << "/" << (index * 2) << "\n";
+            }
+        }
+        FractionVector fractions = loadFractions(path, 4);
+        CHECK(fractions.size() == 5000);
+        CHECK(fractions[0] == Fraction(1, 2));
+        CHECK(fractions.numeratorData()[4999] == 1);
+        CHECK(fractions.denominatorData()[4999] == 2);
+        remove(path.c_str());
+    }
+
+    TEST_CASE("loadFractions reports the line of the first error") {
+        const string path = "loader_error_test.txt";
+        {
+            ofstream out(path);
+            out << "1/2\n3/4\n5/x\n7/0\n";
+        }
+        try {
+            loadFractions(path, 2);
+            FAIL("expected a parse error");
+        } catch (const FractionParseError& error) {
+            CHECK(error.line() == 3);
+        }
+        remove(path.c_str());
+        CHECK_THROWS_AS(loadFractions("no_such_file.txt"), std::runtime_error);
+    }
+}
+
+TEST_SUITE("Binary format tests") {
+
+    TEST_CASE("Fixed and varint files round-trip") {
+        for (FractionEncoding encoding : {FractionEncoding::Fixed, FractionEncoding::Varint}) {
+            const string path = "binary_test.frac";
+            {
+                ofstream out(path, ios::binary);
+                FractionWriter writer(out, encoding, 3);
+                for (int index = -5; index < 5; ++index) {
+                    writer.write(Fraction(index, 7));
+                }
+            }
+            FractionFileReader reader(path);
+            CHECK(reader.encoding() == encoding);
+            CHECK(reader.size() == 10);
+            CHECK(reader.blockCount() == 4);
+            CHECK(reader.blockSize(3) == 1);
+            FractionVector fractions = reader.readAll();
+            CHECK(fractions.numeratorData()[0] == -5);
+            CHECK(fractions.denominatorData()[9] == 7);
+            if (encoding == FractionEncoding::Fixed) {
+                CHECK(reader.recordsOf(1)[0].numerator == -2);
+            } else {
+                CHECK_THROWS_AS(reader.recordsOf(1), std::logic_error);
+            }
+            remove(path.c_str());
+        }
+    }
+
+    TEST_CASE("Corrupted blocks fail their checksum") {
+        const string path = "binary_corrupt_test.frac";
+        {
+            ofstream out(path, ios::binary);
+            FractionWriter writer(out);
+            writer.write(Fraction(1, 3));
+        }
+        {
+            fstream patch(path, ios::binary | ios::in | ios::out);
+            patch.seekp(16 + 12);
+            patch.put(9);
+        }
+        CHECK_THROWS_AS(FractionFileReader{path}, std::runtime_error);
+        CHECK_FALSE(FractionFileReader(path, false).verifyBlock(0));
+        remove(path.c_str());
+    }
+
+    // A file from another writer: 16-byte header, then one block whose first declaredBytes bytes of payload hold the records.
+    string foreignBlock(uint32_t encoding, const string& payload, uint32_t records, uint32_t blockRecords, uint32_t declaredBytes) {
+        string bytes("FRAC", 4);
+        auto put16 = [&bytes](uint16_t value) { bytes.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        auto put32 = [&bytes](uint32_t value) { bytes.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        put16(1);
+        put16(0x0102);
+        put32(encoding);
+        put32(blockRecords);
+        put32(records);
+        put32(declaredBytes);
+        put32(crc32(reinterpret_cast<const unsigned char*>(payload.data()), min<size_t>(declaredBytes, payload.size())));
+        return bytes + payload;
+    }
+
+    // A fixed-encoding file from another writer: one block of raw int32 pairs.
+    string foreignFile(const vector<int32_t>& terms, uint32_t blockRecords, uint32_t declaredBytes) {
+        string payload(reinterpret_cast<const char*>(terms.data()), terms.size() * sizeof(int32_t));
+        return foreignBlock(0, payload, static_cast<uint32_t>(terms.size() / 2), blockRecords, declaredBytes);
+    }
+
+    TEST_CASE("Foreign records are normalized and bad headers rejected") {
+        string bytes = foreignFile({2, -4, -6, -9, 5, 1}, 8, 24);
+        {
+            ofstream out("binary_foreign_test.frac", ios::binary);
+            out << bytes;
+        }
+        FractionVector fractions = FractionFileReader("binary_foreign_test.frac").readAll();
+        CHECK(fractions.numeratorData()[0] == -1);
+        CHECK(fractions.denominatorData()[0] == 2);
+        CHECK(fractions.numeratorData()[1] == 2);
+        CHECK(fractions.denominatorData()[1] == 3);
+        remove("binary_foreign_test.frac");
+
+        istringstream stream(bytes);
+        FractionStreamReader reader(stream);
+        FractionRecord record{};
+        CHECK(reader.next(record));
+        CHECK(record.numerator == -1);
+        CHECK(record.denominator == 2);
+
+        istringstream overflowing(foreignFile({numeric_limits<int32_t>::min(), -1}, 8, 8));
+        FractionStreamReader overflowReader(overflowing);
+        CHECK_THROWS_AS(overflowReader.next(record), std::runtime_error);
+
+        istringstream huge(foreignFile({1, 2}, 8, 0xFFFFFFF0U));
+        FractionStreamReader hugeReader(huge);
+        CHECK_THROWS_AS(hugeReader.next(record), std::runtime_error);
+        istringstream tooMany(foreignFile({1, 2, 3, 4}, 1, 16));
+        FractionStreamReader tooManyReader(tooMany);
+        CHECK_THROWS_AS(tooManyReader.next(record), std::runtime_error);
+    }
+
+    TEST_CASE("Varints wider than 32 bits are rejected") {
+        FractionRecord record{};
+        istringstream widest(foreignBlock(1, string("\xFE\xFF\xFF\xFF\x0F\x02\0\0", 8), 1, 8, 6));
+        FractionStreamReader widestReader(widest);
+        CHECK(widestReader.next(record));
+        CHECK(record.numerator == numeric_limits<int32_t>::max());
+        CHECK(record.denominator == 1);
+
+        istringstream overlong(foreignBlock(1, string("\xFE\xFF\xFF\xFF\x1F\x02\0\0", 8), 1, 8, 6));
+        FractionStreamReader overlongReader(overlong);
+        CHECK_THROWS_WITH_AS(overlongReader.next(record), "Malformed varint in fraction block", std::runtime_error);
+    }
+}
+
+TEST_SUITE("Column codec tests") {
+
+    TEST_CASE("Sorted columns round-trip and compress") {
+        FractionVector fractions;
+        for (int denominator : {2, 3, 8, 1000}) {
+            for (int numerator = -2000; numerator < 2000; numerator += 3) {
+                fractions.push_back(Fraction(numerator, denominator));
+            }
+        }
+        FractionColumn column = FractionColumn::encode(fractions, 256);
+        CHECK(column.size() == fractions.size());
+        CHECK(column.data().size() * 4 <= fractions.size() * 2 * sizeof(int));
+
+        FractionColumn restored(column.data());
+        FractionVector decoded = restored.decode();
+        bool same = decoded.size() == fractions.size();
+        for (size_t index = 0; same && index < fractions.size(); ++index) {
+            same = decoded.numeratorData()[index] == fractions.numeratorData()[index] &&
+                   decoded.denominatorData()[index] == fractions.denominatorData()[index];
+        }
+        CHECK(same);
+
+        size_t block = restored.blockCount() - 1;
+        vector<int> numerators(restored.blockSize(block));
+        vector<int> denominators(restored.blockSize(block));
+        restored.decodeBlock(block, numerators.data(), denominators.data());
+        CHECK(numerators.back() == fractions.numeratorData()[fractions.size() - 1]);
+        CHECK(denominators.back() == fractions.denominatorData()[fractions.size() - 1]);
+        CHECK_THROWS_AS(restored.blockSize(restored.blockCount()), std::out_of_range);
+    }
+
+    TEST_CASE("Extreme values survive encoding") {
+        FractionVector fractions;
+        fractions.push_back(Fraction(std::numeric_limits<int>::max(), 1));
+        fractions.push_back(Fraction(std::numeric_limits<int>::min(), 1));
+        fractions.push_back(Fraction(1, std::numeric_limits<int>::max()));
+        FractionVector decoded = FractionColumn::encode(fractions).decode();
+        CHECK(decoded.numeratorData()[0] == std::numeric_limits<int>::max());
+        CHECK(decoded.numeratorData()[1] == std::numeric_limits<int>::min());
+        CHECK(decoded.denominatorData()[2] == std::numeric_limits<int>::max());
+    }
+
+    TEST_CASE("Corrupt block tables are rejected on adoption") {
+        FractionVector fractions;
+        for (int numerator = 0; numerator < 100; ++numerator) {
+            fractions.push_back(Fraction(numerator, 7));
+        }
+        const vector<unsigned char> good = FractionColumn::encode(fractions, 16).data();
+        uint32_t dictionarySize = 0;
+        memcpy(&dictionarySize, good.data() + 8, sizeof(dictionarySize));
+        const size_t table = 16 + dictionarySize * sizeof(uint32_t);
+        auto patched = [&](size_t block, uint32_t offset) {
+            vector<unsigned char> bytes = good;
+            memcpy(bytes.data() + table + block * sizeof(uint32_t), &offset, sizeof(offset));
+            return bytes;
+        };
+        uint32_t second = 0;
+        memcpy(&second, good.data() + table + sizeof(uint32_t), sizeof(second));
+        CHECK_THROWS_AS(FractionColumn(patched(0, 0xFFFFFF00U)), std::runtime_error);
+        CHECK_THROWS_AS(FractionColumn(patched(2, second)), std::runtime_error);   // not increasing
+        CHECK_THROWS_AS(FractionColumn(vector<unsigned char>(good.begin(), good.end() - 12)), std::runtime_error);
+
+        vector<unsigned char> wide = good;
+        wide[second + 6] = 64;  // the residual width of block 1: far more bits than the block holds
+        FractionColumn column(wide);
+        vector<int> numerators(16);
+        vector<int> denominators(16);
+        CHECK_THROWS_AS(column.decodeBlock(1, numerators.data(), denominators.data()), std::runtime_error);
+        column.decodeBlock(0, numerators.data(), denominators.data());
+        CHECK(numerators[15] == 15);
+    }
+
+    // A one-block column over denominator 1: a first numerator, then one run of two records whose second
+    // record carries the given residual field.
+    vector<unsigned char> residualColumn(int32_t first, unsigned char residualBits, uint64_t residual) {
+        vector<unsigned char> bytes;
+        auto put32 = [&bytes](uint32_t value) { bytes.insert(bytes.end(), reinterpret_cast<unsigned char*>(&value), reinterpret_cast<unsigned char*>(&value) + sizeof(value)); };
+        auto put64 = [&bytes](uint64_t value) { bytes.insert(bytes.end(), reinterpret_cast<unsigned char*>(&value), reinterpret_cast<unsigned char*>(&value) + sizeof(value)); };
+        for (uint32_t word : {2U, 2U, 1U, 1U, 1U, 24U, 1U}) {   // header, dictionary {1}, block table, run count
+            put32(word);
+        }
+        bytes.insert(bytes.end(), {0, 1, residualBits, 0});
+        put32(static_cast<uint32_t>(first));
+        put64(1U | (residual << 1));   // run length field 1 (two records), then the residual
+        put64(residual >> 63);
+        put64(0);
+        return bytes;
+    }
+
+    TEST_CASE("Corrupt residuals that leave the int range are rejected") {
+        const int top = std::numeric_limits<int>::max();
+        CHECK(FractionColumn(residualColumn(top - 1, 2, 2)).decode().numeratorData()[1] == top);
+        CHECK_THROWS_AS(FractionColumn(residualColumn(top, 2, 2)).decode(), std::runtime_error);
+        CHECK_THROWS_AS(FractionColumn(residualColumn(top, 64, ~uint64_t{1})).decode(), std::runtime_error);
+        CHECK_THROWS_AS(FractionColumn(residualColumn(-top, 64, ~uint64_t{0})).decode(), std::runtime_error);
+
+        vector<unsigned char> wrapped = residualColumn(0, 2, 0);
+        const uint32_t huge = 0xFFFFFFFFU;
+        const uint32_t none = 0;
+        memcpy(wrapped.data(), &huge, sizeof(huge));        // 2^32 - 1 records of 2 per block need 2^31 blocks,
+        memcpy(wrapped.data() + 12, &none, sizeof(none));   // not the 0 that 32-bit arithmetic wraps to
+        CHECK_THROWS_AS(FractionColumn{wrapped}, std::runtime_error);
+    }
+}
+
+TEST_SUITE("Checked arithmetic tests") {
+
+    TEST_CASE("Checked operations return values or error codes") {
+        const int max_int = std::numeric_limits<int>::max();
+        FractionResult sum = checked_add(Fraction(1, 2), Fraction(1, 3));
+        CHECK(sum.has_value());
+        CHECK(sum->getNumerator() == 5);
+        CHECK(sum->getDenominator() == 6);
+
+        FractionResult product = checked_mul(Fraction(max_int, 1), Fraction(2, 1));
+        CHECK_FALSE(product);
+        CHECK(product.error() == FracError::Overflow);
+        CHECK_THROWS_AS(product.value(), std::logic_error);
+
+        CHECK(checked_div(Fraction(1, 2), Fraction(0, 1)).error() == FracError::DivideByZero);
+        CHECK(checked_sub(Fraction(max_int, 1), Fraction(-1, 1)).error() == FracError::Overflow);
+        CHECK(checked_sub(Fraction(3, 4), Fraction(1, 4)).value() == Fraction(1, 2));
+    }
+}
+
+TEST_SUITE("Overflow policy tests") {
+
+    TEST_CASE("Each policy handles overflow its own way") {
+        const int max_int = std::numeric_limits<int>::max();
+        Fraction big(max_int, 1);
+        Fraction two(2, 1);
+
+        CHECK_THROWS_AS(FractionArithmetic<ThrowPolicy>::mul(big, two), std::overflow_error);
+        CHECK(FractionArithmetic<ThrowPolicy>::add(Fraction(1, 2), Fraction(1, 2)) == Fraction(1, 1));
+
+        FlagPolicy::clear();
+        Fraction fine = FractionArithmetic<FlagPolicy>::mul(two, two);
+        CHECK_FALSE(FlagPolicy::raised());
+        Fraction failed = FractionArithmetic<FlagPolicy>::mul(big, two);
+        CHECK(FlagPolicy::raised());
+        CHECK(fine.getNumerator() == 4);
+        CHECK(failed.getNumerator() == 0);
+        FractionArithmetic<FlagPolicy>::add(two, two);
+        CHECK(FlagPolicy::raised());  // sticky until cleared
+        FlagPolicy::clear();
+
+        Fraction saturated = FractionArithmetic<SaturatePolicy>::mul(big, two);
+        CHECK(saturated.getNumerator() == max_int);
+        CHECK(saturated.getDenominator() == 1);
+        CHECK(FractionArithmetic<SaturatePolicy>::mul(Fraction(-3, 1), big).getNumerator() == -max_int);
+        // Results inside the int range but with wide terms become the closest fraction with int terms.
+        Fraction small = FractionArithmetic<SaturatePolicy>::mul(Fraction(1, 46341), Fraction(46340, 46343));
+        CHECK(small.getNumerator() == 30893);
+        CHECK(small.getDenominator() == 1431705194);
+        Fraction wide = FractionArithmetic<SaturatePolicy>::mul(Fraction(max_int, 2), Fraction(3, 1000000007));
+        CHECK(wide.getNumerator() == 840783016);
+        CHECK(wide.getDenominator() == 261013403);
+        Fraction tiny = FractionArithmetic<SaturatePolicy>::mul(Fraction(-1, 46341), Fraction(1, 46341));
+        CHECK(tiny.getNumerator() == -1);
+        CHECK(tiny.getDenominator() == max_int);
+        Fraction tinier = FractionArithmetic<SaturatePolicy>::div(Fraction(1, max_int), Fraction(max_int, 1));
+        CHECK(tinier.getNumerator() == 1);
+        CHECK(tinier.getDenominator() == max_int);
+
+        WideFraction promoted = FractionArithmetic<PromotePolicy>::mul(big, two);
+        CHECK(promoted.numerator == 2LL * max_int);
+        CHECK(promoted.denominator == 1);
+        CHECK_THROWS_AS(FractionArithmetic<PromotePolicy>::div(big, Fraction()), std::runtime_error);
+    }
+}
+
+TEST_SUITE("Dynamic fraction tests") {
+
+    TEST_CASE("DynFraction promotes on overflow and demotes after reduction") {
+        const int max_int = std::numeric_limits<int>::max();
+        DynFraction big(max_int, 1);
+        DynFraction product = big * DynFraction(2, 1);
+        CHECK(product.getStorage() == FractionStorage::Wide);
+        CHECK(product.toString() == "4294967294/1");
+        CHECK_THROWS_AS(product.toFraction(), std::overflow_error);
+
+        DynFraction back = product / DynFraction(2, 1);
+        CHECK(back.getStorage() == FractionStorage::Small);
+        CHECK(back.toFraction().getNumerator() == max_int);
+
+        DynFraction huge = product;
+        for (int i = 0; i < 4; i++) {
+            huge = huge * huge;
+        }
+        CHECK(huge.getStorage() == FractionStorage::Big);
+        for (int i = 0; i < 4; i++) {
+            huge = huge / product;
+        }
+        CHECK(huge.getStorage() == FractionStorage::Big);
+        BigInt expected(1);
+        for (int i = 0; i < 12; i++) {
+            expected *= BigInt(4294967294LL);
+        }
+        CHECK(huge.toBigFraction().getNumerator() == expected);
+        DynFraction small = huge - huge + DynFraction(Fraction(3, 4));
+        CHECK(small.getStorage() == FractionStorage::Small);
+        CHECK(small.toFraction() == Fraction(3, 4));
+    }
+
+    TEST_CASE("DynFraction arithmetic and comparison are exact") {
+        DynFraction a(1, 1000000007);
+        DynFraction b(1, 1000000009);
+        CHECK(a > b);
+        CHECK(a - b > DynFraction());
+        CHECK((a - b).toString() == "2/1000000016000000063");
+        CHECK(a + b - b == a);
+        CHECK(-DynFraction(std::numeric_limits<int>::min(), 1) == DynFraction(2147483648LL, 1));
+        CHECK(DynFraction(6, -8).toString() == "-3/4");
+        CHECK_THROWS_AS(DynFraction(1, 0), std::invalid_argument);
+        CHECK_THROWS_AS(a / DynFraction(), std::runtime_error);
+
+        BigFraction third(BigInt(1), BigInt(3));
+        CHECK(third.toDouble() == doctest::Approx(1.0 / 3));
+        CHECK(DynFraction(third).toFraction() == Fraction(1, 3));
+        CHECK(BigInt::fromString("-123456789012345678901234567890").toString() == "-123456789012345678901234567890");
+    }
+}
+
+TEST_SUITE("Operation counter tests") {
+
+    TEST_CASE("fraction_stats counts only when built with ARIEL_FRACTION_STATS") {
+        reset_fraction_stats();
+        Fraction reduced(6, 8);
+        Fraction converted(0.5f);
+        CHECK_THROWS_AS(Fraction(std::numeric_limits<int>::max(), 1) * Fraction(2, 1), std::overflow_error);
+        CHECK(checked_div(reduced, Fraction()).error() == FracError::DivideByZero);
+        istringstream input("1/0");
+        Fraction parsed;
+        CHECK_THROWS_AS(input >> parsed, std::runtime_error);
+        int num = 0;
+        int den = 0;
+        string text = "3/x";
+        CHECK(parseFraction(text.data(), text.data() + text.size(), num, den).error != nullptr);
+
+        FractionCounters counters = fraction_stats();
+#ifdef ARIEL_FRACTION_STATS
+        CHECK(counters.normalizations == 3);  // 6/8, max/1 and 2/1; Fraction() does not normalize
+        CHECK(counters.gcdCalls == 5);        // those three, the float conversion and the multiplication
+        CHECK(counters.gcdIterations > 0);
+        CHECK(counters.floatConversions == 1);
+        CHECK(counters.mulOverflows == 1);
+        CHECK(counters.addOverflows == 0);
+        CHECK(counters.divideByZero == 1);
+        CHECK(counters.parses == 2);
+        CHECK(counters.parseErrors == 2);
+        reset_fraction_stats();
+        CHECK(fraction_stats().gcdCalls == 0);
+        CHECK(Fraction::fromReduced(2, 3) * Fraction::fromReduced(3, 4) == Fraction(1, 2));
+        CHECK(fraction_stats().gcdIterations == 4);   // gcd(6, 12) in the 64-bit core, then 1/2 in Fraction::gcd
+        reset_fraction_stats();
+#else
+        CHECK(counters.gcdCalls == 0);
+        CHECK(counters.normalizations == 0);
+        CHECK(counters.mulOverflows == 0);
+        CHECK(counters.parses == 0);
+#endif
+    }
+}
+
+TEST_SUITE("Width profiler tests") {
+
+    TEST_CASE("fraction_profile samples operand, result and gcd widths") {
+        set_fraction_profile_rate(1);
+        reset_fraction_profile();
+        Fraction product = Fraction(3, 4) * Fraction(2, 3);  // 6/12 reduced by 6 to 1/2
+        CHECK(product == Fraction(1, 2));
+        FractionProfile profile = fraction_profile();
+        const OperatorProfile& multiply = profile[static_cast<size_t>(ProfiledOp::Mul)];
+#ifdef ARIEL_FRACTION_PROFILE
+        CHECK(multiply.samples == 1);
+        CHECK(multiply.operands.buckets[2] == 3);  // 3, 2 and 3
+        CHECK(multiply.operands.buckets[3] == 1);  // 4
+        CHECK(multiply.results.buckets[1] == 1);
+        CHECK(multiply.results.buckets[2] == 1);
+        CHECK(multiply.gcds.buckets[3] == 1);
+        CHECK(profile[static_cast<size_t>(ProfiledOp::Add)].samples == 0);
+        ostringstream dump;
+        dump_fraction_profile(dump);
+        CHECK(dump.str().find("operator*: 1 samples") != string::npos);
+#else
+        CHECK(multiply.samples == 0);
+        CHECK(multiply.operands.total() == 0);
+#endif
+        set_fraction_profile_rate(1024);
+        reset_fraction_profile();
+    }
+}
+
+TEST_SUITE("Stress regressions") {
+
+    TEST_CASE("Ordering is exact for large terms") {
+        // Found by the stress suite: the cross products used to be formed in int.
+        CHECK(Fraction(-1123211094, 41329) < Fraction(105, -4324811));
+        CHECK_FALSE(Fraction(176, -2147483646) >= Fraction(-1085723440, -151));
+        CHECK(Fraction(2147483647, 2) > Fraction(2147483646, 2));
+    }
+
+    TEST_CASE("Float-left ordering is exact for large terms") {
+        // The float overloads formed their cross products in int.
+        Fraction big(2147483647, 2147483646);
+        CHECK_FALSE(0.5f > big);
+        CHECK(0.5f < big);
+        CHECK(0.5f <= big);
+        CHECK_FALSE(0.5f >= big);
+        CHECK(2.0f > Fraction(-2147483647, 3));
+    }
+
+    TEST_CASE("Increment and decrement throw instead of wrapping") {
+        Fraction high(2147483647, 742);
+        CHECK_THROWS_AS(++high, overflow_error);
+        CHECK_THROWS_AS(high++, overflow_error);
+        CHECK(high.getNumerator() == 2147483647);
+        Fraction low(-2147483647, 2);
+        CHECK_THROWS_AS(--low, overflow_error);
+        CHECK(low.getNumerator() == -2147483647);
+        Fraction small(1, 2);
+        CHECK((++small).getNumerator() == 3);
+    }
+}
+
+TEST_SUITE("Continued fraction tests") {
+
+    TEST_CASE("ContinuedFraction yields partial quotients lazily") {
+        vector<long long> terms;
+        for (long long term : ContinuedFraction(Fraction(415, 93))) {
+            terms.push_back(term);
+        }
+        CHECK(terms == vector<long long>{4, 2, 6, 7});
+        terms.clear();
+        for (long long term : ContinuedFraction(-7, 2)) {
+            terms.push_back(term);
+        }
+        CHECK(terms == vector<long long>{-4, 2});  // -7/2 = -4 + 1/2
+        auto first = ContinuedFraction(Fraction(2147483647, 1134903170)) | views::take(3);
+        CHECK(ranges::distance(first) == 3);
+        CHECK_THROWS_AS(ContinuedFraction(1, 0), invalid_argument);
+    }
+
+    TEST_CASE("Convergents stop at the fraction or at the denominator bound") {
+        vector<Fraction> all;
+        ranges::copy(Convergents(Fraction(415, 93)), back_inserter(all));
+        REQUIRE(all.size() == 4);
+        CHECK(all[1].getNumerator() == 9);
+        CHECK(all[1].getDenominator() == 2);
+        CHECK(all[3].getNumerator() == 415);
+        CHECK(all[3].getDenominator() == 93);
+        int count = 0;
+        int lastDenominator = 0;
+        for (Fraction convergent : Convergents(Fraction(355, 113), 10)) {
+            ++count;
+            lastDenominator = convergent.getDenominator();
+        }
+        CHECK(count == 2);  // 3/1, 22/7
+        CHECK(lastDenominator == 7);
+    }
+
+    TEST_CASE("limit_denominator returns the closest bounded fraction") {
+        Fraction pi = limit_denominator(Fraction(314159265, 100000000), 1000);
+        CHECK(pi.getNumerator() == 355);
+        CHECK(pi.getDenominator() == 113);
+        Fraction semi = limit_denominator(Fraction(3, 10), 7);  // [0; 3, 3]: the semiconvergent 2/7 beats the convergent 1/3
+        CHECK(semi.getNumerator() == 2);
+        CHECK(semi.getDenominator() == 7);
+        Fraction negative = limit_denominator(Fraction(-22, 7), 1);
+        CHECK(negative.getNumerator() == -3);
+        CHECK(limit_denominator(Fraction(1, 3), 5).getDenominator() == 3);
+    }
+}
+
+TEST_SUITE("Farey sequence tests") {
+
+    TEST_CASE("FareySequence yields every reduced fraction in [0, 1] in order") {
+        vector<Fraction> terms;
+        ranges::copy(FareySequence(5), back_inserter(terms));
+        REQUIRE(terms.size() == 11);
+        CHECK(terms[1].getDenominator() == 5);
+        CHECK(terms[4].getNumerator() == 2);
+        CHECK(terms[4].getDenominator() == 5);
+        CHECK(terms[10].getNumerator() == 1);
+        CHECK(terms[10].getDenominator() == 1);
+        bool increasing = true;
+        for (size_t index = 1; index < terms.size(); ++index) {
+            increasing = increasing && terms[index - 1] < terms[index];
+        }
+        CHECK(increasing);
+        vector<Fraction> middle;
+        ranges::copy(FareySequence(5, Fraction(1, 3), Fraction(1, 2)), back_inserter(middle));
+        CHECK(middle.size() == 3);  // 1/3, 2/5, 1/2
+        CHECK_THROWS_AS(FareySequence(5, Fraction(1, 6), Fraction(1, 2)), invalid_argument);
+    }
+
+    TEST_CASE("FareySequence splits into independent pieces and farey_next steps past any term") {
+        FareySequence whole(50);
+        size_t expected = 0;
+        for (Fraction term : whole) {
+            (void)term;
+            ++expected;
+        }
+        CHECK(expected == 775);  // 1 + the sum of Euler's phi up to 50
+        vector<FareySequence> pieces = whole.split(7);
+        CHECK(pieces.size() == 7);
+        vector<Fraction> joined;
+        for (const FareySequence& piece : pieces) {
+            ranges::copy(piece, back_inserter(joined));
+        }
+        vector<Fraction> direct;
+        ranges::copy(whole, back_inserter(direct));
+        bool same = joined.size() == direct.size();
+        for (size_t index = 0; same && index < joined.size(); ++index) {
+            same = joined[index].getNumerator() == direct[index].getNumerator() && joined[index].getDenominator() == direct[index].getDenominator();
+        }
+        CHECK(same);
+        Fraction after = farey_next(Fraction(1, 1), 5);
+        CHECK(after.getNumerator() == 6);
+        CHECK(after.getDenominator() == 5);
+        CHECK(farey_next(Fraction(-1, 2), 3).getDenominator() == 3);  // -1/3
+    }
+}
+
+TEST_SUITE("Quantizer tests") {
+
+    TEST_CASE("Quantizer finds the nearest, floor and ceiling fractions") {
+        Quantizer quantizer(64);
+        CHECK(quantizer.size() == 1261);  // 1 + the sum of Euler's phi up to 64
+        Fraction pi = quantizer.nearest(3.14159265);
+        CHECK(pi.getNumerator() == 201);
+        CHECK(pi.getDenominator() == 64);
+        Fraction below = quantizer.floor(0.5001);
+        CHECK(below.getNumerator() == 1);
+        CHECK(below.getDenominator() == 2);
+        Fraction above = quantizer.ceil(0.5001);
+        CHECK(above.getNumerator() == 32);
+        CHECK(above.getDenominator() == 63);
+        Fraction negative = quantizer.nearest(-0.25);
+        CHECK(negative.getNumerator() == -1);
+        CHECK(negative.getDenominator() == 4);
+        CHECK(quantizer.ceil(2.0).getNumerator() == 2);
+        CHECK_THROWS_AS(quantizer.nearest(1e12), overflow_error);
+    }
+
+    TEST_CASE("Quantizer floor and ceiling are exact next to table fractions") {
+        Quantizer quantizer(64);
+        auto terms = [](const Fraction& fraction) { return make_pair(fraction.getNumerator(), fraction.getDenominator()); };
+        // Doubles that round to a table fraction count as that fraction.
+        CHECK(terms(quantizer.floor(1.0 / 3)) == make_pair(1, 3));
+        CHECK(terms(quantizer.ceil(1.0 / 3)) == make_pair(1, 3));
+        CHECK(terms(quantizer.floor(-1.0 / 3)) == make_pair(-1, 3));
+        CHECK(terms(quantizer.ceil(-1.0 / 3)) == make_pair(-1, 3));
+        CHECK(terms(quantizer.ceil(7.0 / 3)) == make_pair(7, 3));
+        CHECK(terms(quantizer.floor(-7.0 / 3)) == make_pair(-7, 3));
+        CHECK(terms(quantizer.floor(0.1)) == make_pair(1, 10));
+        CHECK(terms(quantizer.ceil(0.1)) == make_pair(1, 10));
+        // One double further away they fall to the neighbours of 1/3 in the Farey sequence, 21/64 and 21/62.
+        CHECK(terms(quantizer.floor(nextafter(1.0 / 3, 0.0))) == make_pair(21, 64));
+        CHECK(terms(quantizer.ceil(nextafter(1.0 / 3, 0.0))) == make_pair(1, 3));
+        CHECK(terms(quantizer.floor(nextafter(1.0 / 3, 1.0))) == make_pair(1, 3));
+        CHECK(terms(quantizer.ceil(nextafter(1.0 / 3, 1.0))) == make_pair(21, 62));
+        CHECK(terms(quantizer.ceil(nextafter(-1.0 / 3, 0.0))) == make_pair(-21, 64));
+        // Tiny negative values lie below 0, even though value - floor(value) rounds to 1.
+        CHECK(terms(quantizer.floor(-1e-300)) == make_pair(-1, 64));
+        CHECK(terms(quantizer.ceil(-1e-300)) == make_pair(0, 1));
+        CHECK(terms(quantizer.ceil(1e-300)) == make_pair(1, 64));
+        CHECK(terms(quantizer.floor(5.0)) == make_pair(5, 1));
+
+        vector<double> input = {1.0 / 3, -1.0 / 3, nextafter(1.0 / 3, 1.0), 7.0 / 3, -1e-300};
+        vector<Fraction> out(input.size());
+        quantizer.floor(input.data(), input.size(), out.data());
+        CHECK(terms(out[0]) == make_pair(1, 3));
+        CHECK(terms(out[1]) == make_pair(-1, 3));
+        CHECK(terms(out[2]) == make_pair(1, 3));
+        CHECK(terms(out[3]) == make_pair(7, 3));
+        CHECK(terms(out[4]) == make_pair(-1, 64));
+    }
+
+    TEST_CASE("Quantizer batch queries match single queries") {
+        Quantizer quantizer(16);
+        vector<double> input = {0.0, 0.33, -1.7, 2.999, 0.0625};
+        vector<Fraction> out(input.size());
+        quantizer.nearest(input.data(), input.size(), out.data());
+        bool same = true;
+        for (size_t index = 0; index < input.size(); ++index) {
+            Fraction single = quantizer.nearest(input[index]);
+            same = same && single.getNumerator() == out[index].getNumerator() && single.getDenominator() == out[index].getDenominator();
+        }
+        CHECK(same);
+        CHECK(out[2].getNumerator() == -17);
+        CHECK(out[2].getDenominator() == 10);
+        quantizer.ceil(input.data(), input.size(), out.data());
+        for (size_t index = 0; index < input.size(); ++index) {
+            Fraction single = quantizer.ceil(input[index]);
+            same = same && single.getNumerator() == out[index].getNumerator() && single.getDenominator() == out[index].getDenominator();
+        }
+        CHECK(same);
+    }
+}
+
+TEST_SUITE("Fraction interval tests") {
+
+    TEST_CASE("FractionInterval arithmetic picks exact endpoints") {
+        FractionInterval left(Fraction(1, 2), Fraction(3, 4));
+        FractionInterval right(Fraction(-2, 3), Fraction(1, 3));
+        FractionInterval product = left * right;  // candidates -1/3, 1/6, -1/2, 1/4
+        CHECK(product.getLower().getNumerator() == -1);
+        CHECK(product.getLower().getDenominator() == 2);
+        CHECK(product.getUpper().getNumerator() == 1);
+        CHECK(product.getUpper().getDenominator() == 4);
+        FractionInterval sum = left + right;
+        CHECK(sum.getLower().getNumerator() == -1);
+        CHECK(sum.getLower().getDenominator() == 6);
+        FractionInterval quotient = FractionInterval(Fraction(1, 1), Fraction(2, 1)) / FractionInterval(Fraction(2, 1), Fraction(4, 1));
+        CHECK(quotient.getLower().getDenominator() == 4);
+        CHECK(quotient.getUpper().getNumerator() == 1);
+        CHECK_THROWS_AS(left / right, runtime_error);
+        CHECK_THROWS_AS(FractionInterval(Fraction(1, 1), Fraction(0, 1)), invalid_argument);
+        ostringstream text;
+        text << (left - right);
+        CHECK(text.str() == "[1/6, 17/12]");
+    }
+
+    TEST_CASE("FractionInterval widening rounds outward to bounded denominators") {
+        FractionInterval tight(Fraction(1, 2147483647), Fraction(1, 1));
+        FractionInterval other(Fraction(1, 2147483646), Fraction(1, 1));
+        CHECK_THROWS_AS(tight + other, overflow_error);
+        FractionInterval bounded = tight.widened(1000) + other;
+        CHECK(bounded.getMaxDenominator() == 1000);
+        CHECK(bounded.getLower().getNumerator() == 0);
+        CHECK(bounded.getUpper().getNumerator() == 2);
+        FractionInterval pi = FractionInterval(Fraction(355, 113)).widened(100);
+        CHECK(pi.getLower().getNumerator() == 311);
+        CHECK(pi.getLower().getDenominator() == 99);
+        CHECK(pi.getUpper().getNumerator() == 22);
+        CHECK(pi.getUpper().getDenominator() == 7);
+        CHECK(pi.contains(Fraction(355, 113)));
+    }
+
+    TEST_CASE("FractionInterval containment and intersection") {
+        FractionInterval wide(Fraction(0, 1), Fraction(1, 1));
+        FractionInterval narrow(Fraction(1, 3), Fraction(1, 2));
+        FractionInterval apart(Fraction(2, 1), Fraction(3, 1));
+        CHECK(wide.contains(narrow));
+        CHECK_FALSE(narrow.contains(wide));
+        CHECK(wide.contains(Fraction(1, 1)));
+        CHECK(wide.intersects(narrow));
+        CHECK_FALSE(wide.intersects(apart));
+        FractionInterval shared = FractionInterval(Fraction(1, 4), Fraction(3, 2)).intersection(wide);
+        CHECK(shared.getLower().getDenominator() == 4);
+        CHECK(shared.getUpper().getNumerator() == 1);
+        CHECK_THROWS_AS(wide.intersection(apart), invalid_argument);
+    }
+}
+
+TEST_SUITE("Fraction polynomial tests") {
+
+    TEST_CASE("FractionPolynomial evaluates over a common denominator") {
+        FractionPolynomial poly({Fraction(1, 2), Fraction(2, 3), Fraction(3, 4)});
+        CHECK(poly.degree() == 2);
+        Fraction value = poly.evaluate(Fraction(2, 5));  // 1/2 + 4/15 + 3/25
+        CHECK(value.getNumerator() == 133);
+        CHECK(value.getDenominator() == 150);
+        CHECK(poly.evaluate(Fraction(0, 1)).getDenominator() == 2);
+        FractionPolynomial steep({Fraction(1, 3), Fraction(0, 1), Fraction(0, 1), Fraction(0, 1), Fraction(0, 1), Fraction(1, 7)});
+        Fraction point(46341, 46340);  // too wide for the 128-bit path, exact through BigInt
+        BigFraction exact = steep.evaluateExact(point);
+        CHECK_FALSE(exact.fitsFraction());
+        CHECK_THROWS_AS(steep.evaluate(point), overflow_error);
+        CHECK(FractionPolynomial().evaluate(Fraction(5, 1)).getNumerator() == 0);
+    }
+
+    TEST_CASE("FractionPolynomial batch evaluation matches single points") {
+        FractionPolynomial poly({Fraction(-1, 2), Fraction(1, 1), Fraction(0, 1), Fraction(5, 3)});
+        vector<Fraction> points;
+        for (int index = 0; index < 5000; ++index) {
+            points.emplace_back(index % 201 - 100, 1 + index % 37);
+        }
+        vector<Fraction> values(points.size());
+        poly.evaluate(points.data(), points.size(), values.data(), 4);
+        bool same = true;
+        for (size_t index = 0; index < points.size(); ++index) {
+            Fraction single = poly.evaluate(points[index]);
+            same = same && single.getNumerator() == values[index].getNumerator() && single.getDenominator() == values[index].getDenominator();
+        }
+        CHECK(same);
+    }
+
+    TEST_CASE("FractionPolynomial multiplication, derivative and division") {
+        FractionPolynomial below({Fraction(-1, 1), Fraction(1, 1)});      // x - 1
+        FractionPolynomial above({Fraction(1, 2), Fraction(1, 1)});       // x + 1/2
+        FractionPolynomial product = below * above;                       // x^2 - x/2 - 1/2
+        CHECK(product == FractionPolynomial({Fraction(-1, 2), Fraction(-1, 2), Fraction(1, 1)}));
+        CHECK(product / below == above);
+        CHECK(product - product == FractionPolynomial());
+        FractionPolynomial shifted({Fraction(-2, 1), Fraction(1, 1)});    // x - 2
+        CHECK(product % shifted == FractionPolynomial({Fraction(5, 2)}));  // the value at 2
+        CHECK_THROWS_AS(product / shifted, invalid_argument);
+        CHECK_THROWS_AS(product / FractionPolynomial(), runtime_error);
+        CHECK(product.derivative() == FractionPolynomial({Fraction(-1, 2), Fraction(2, 1)}));
+        CHECK((below + above).degree() == 1);
+    }
+}
+
+TEST_SUITE("Power tests") {
+
+    TEST_CASE("pow raises terms separately and detects overflow") {
+        Fraction cube = pow(Fraction(-2, 3), 3);
+        CHECK(cube.getNumerator() == -8);
+        CHECK(cube.getDenominator() == 27);
+        Fraction inverse = pow(Fraction(-2, 3), -2);
+        CHECK(inverse.getNumerator() == 9);
+        CHECK(inverse.getDenominator() == 4);
+        CHECK(pow(Fraction(5, 7), 0).getNumerator() == 1);
+        CHECK(pow(Fraction(0, 1), 4).getNumerator() == 0);
+        CHECK(pow(Fraction(1, 1), numeric_limits<int>::min()).getDenominator() == 1);
+        CHECK(pow(Fraction(2, 1), 30).getNumerator() == 1073741824);
+        CHECK_THROWS_AS(pow(Fraction(2, 1), 31), overflow_error);
+        CHECK(pow(Fraction(46340, 1), 2).getNumerator() == 2147395600);
+        CHECK_THROWS_AS(pow(Fraction(46341, 1), 2), overflow_error);
+        CHECK_THROWS_AS(pow(Fraction(0, 1), -1), runtime_error);
+    }
+
+    TEST_CASE("pow on DynFraction promotes instead of overflowing") {
+        DynFraction small = pow(DynFraction(Fraction(3, 4)), 2);
+        CHECK(small.getStorage() == FractionStorage::Small);
+        CHECK(small.toString() == "9/16");
+        DynFraction wide = pow(DynFraction(Fraction(2, 3)), 39);
+        CHECK(wide.getStorage() == FractionStorage::Wide);
+        CHECK(wide.toString() == "549755813888/4052555153018976267");
+        DynFraction big = pow(DynFraction(Fraction(-3, 2)), -101);
+        CHECK(big.getStorage() == FractionStorage::Big);
+        CHECK(big.toBigFraction().getNumerator().sign() < 0);
+        CHECK(pow(big, 0).toString() == "1/1");
+        CHECK(pow(DynFraction(0), 200).toString() == "0/1");
+    }
+}
+
+TEST_SUITE("Multi-modular tests") {
+
+    TEST_CASE("PrimeField arithmetic") {
+        PrimeField field(1000000007ULL);
+        CHECK(field.fromInt(-1) == 1000000006ULL);
+        CHECK(field.multiply(field.fromFraction(Fraction(2, 3)), field.fromInt(3)) == 2);
+        CHECK(field.multiply(field.inverse(12345), 12345) == 1);
+        CHECK(field.subtract(3, 5) == 1000000005ULL);
+        CHECK_THROWS_AS(field.inverse(0), domain_error);
+        CHECK_THROWS_AS(PrimeField(1), invalid_argument);
+    }
+
+    TEST_CASE("modular_sum matches the BigFraction fold") {
+        vector<Fraction> terms;
+        BigFraction expected(BigInt(0));
+        for (int index = 1; index <= 200; ++index) {
+            terms.emplace_back((index % 3 == 0) ? -1 : 1, index);
+            expected = expected + BigFraction(terms.back());
+        }
+        BigFraction sum = modular_sum(terms, 2);
+        CHECK(sum.getNumerator() == expected.getNumerator());
+        CHECK(sum.getDenominator() == expected.getDenominator());
+        CHECK(modular_sum({}).getNumerator().isZero());
+    }
+
+    TEST_CASE("modular_determinant is exact") {
+        vector<vector<Fraction>> hilbert(6, vector<Fraction>(6));
+        for (int row = 0; row < 6; ++row) {
+            for (int column = 0; column < 6; ++column) {
+                hilbert[size_t(row)][size_t(column)] = Fraction(1, row + column + 1);
+            }
+        }
+        BigFraction determinant = modular_determinant(hilbert);
+        CHECK(determinant.getNumerator() == BigInt(1));
+        CHECK(determinant.getDenominator() == BigInt::fromString("186313420339200000"));
+        vector<vector<Fraction>> swapped = {{Fraction(0, 1), Fraction(1, 2)}, {Fraction(-3, 1), Fraction(5, 7)}};
+        CHECK(modular_determinant(swapped).toString() == "3/2");
+        vector<vector<Fraction>> singular = {{Fraction(1, 2), Fraction(1, 3)}, {Fraction(3, 2), Fraction(1, 1)}};
+        CHECK(modular_determinant(singular).getNumerator().isZero());
+        CHECK_THROWS_AS(modular_determinant({{Fraction(1, 1), Fraction(2, 1)}}), invalid_argument);
+    }
+
+    TEST_CASE("modular_reconstruct skips unlucky primes") {
+        atomic<int> calls{0};
+        BigFraction value = modular_reconstruct(
+            [&calls](const PrimeField& field) {
+                if (calls++ == 0) {
+                    throw domain_error("unlucky");
+                }
+                return field.fromFraction(Fraction(-22, 7));
+            },
+            1);
+        CHECK(value.toString() == "-22/7");
+        CHECK_THROWS_AS(modular_reconstruct([](const PrimeField&) -> uint64_t { throw domain_error("unlucky"); }, 1, 3), runtime_error);
+    }
+}
+
+TEST_SUITE("Series summation tests") {
+
+    TEST_CASE("sum_series matches a BigFraction fold") {
+        // e ~ sum 1/k! : each term multiplies the previous by 1/k
+        BigFraction expected(BigInt(0));
+        BigFraction factorial(BigInt(1));
+        for (int index = 0; index < 25; ++index) {
+            if (index > 0) {
+                factorial = factorial * BigFraction(BigInt(index));
+            }
+            expected = expected + BigFraction(BigInt(1)) / factorial;
+        }
+        BigFraction sum = sum_series([](long long index) { return SeriesTerm{1, index == 0 ? 1 : index, 1, 1}; }, 0, 25, 1);
+        CHECK(sum == expected);
+        CHECK(sum.toDouble() == doctest::Approx(2.718281828459045));
+    }
+
+    TEST_CASE("sum_fractions is exact and thread-independent") {
+        auto term = [](long long index) { return Fraction(index % 2 == 0 ? 1 : -1, int(2 * index + 1)); };
+        BigFraction expected(BigInt(0));
+        for (long long index = 0; index < 500; ++index) {
+            expected = expected + BigFraction(term(index));
+        }
+        BigFraction serial = sum_fractions(term, 0, 500, 1);
+        CHECK(serial == expected);
+        CHECK(sum_fractions(term, 0, 500, 4) == expected);
+        CHECK((serial * BigFraction(BigInt(4))).toDouble() == doctest::Approx(3.14159).epsilon(0.01));
+        CHECK(sum_fractions(term, 3, 3).getNumerator().isZero());
+        DynFraction narrow(sum_fractions([](long long index) { return Fraction(1, int(index * (index + 1))); }, 1, 100));
+        CHECK(narrow.toString() == "99/100");
+    }
+
+    TEST_CASE("sum_series rejects zero denominators") {
+        CHECK_THROWS_AS(sum_series([](long long index) { return SeriesTerm{1, index - 5, 1, 1}; }, 0, 10, 4), invalid_argument);
+    }
+}
+
+TEST_SUITE("Streaming statistics tests") {
+
+    // The k-th central moment computed directly with BigFraction.
+    BigFraction directMoment(const vector<Fraction>& values, int power) {
+        BigFraction mean;
+        for (const Fraction& value : values) {
+            mean = mean + BigFraction(value);
+        }
+        mean = mean / BigFraction(BigInt(static_cast<long long>(values.size())));
+        BigFraction sum;
+        for (const Fraction& value : values) {
+            BigFraction term(BigInt(1));
+            for (int step = 0; step < power; ++step) {
+                term = term * (BigFraction(value) - mean);
+            }
+            sum = sum + term;
+        }
+        return sum / BigFraction(BigInt(static_cast<long long>(values.size())));
+    }
+
+    TEST_CASE("FractionStats gives exact mean, variance and moments") {
+        vector<Fraction> values = {Fraction(1, 2), Fraction(-2, 3), Fraction(5, 4), Fraction(7, 6), Fraction(0, 1), Fraction(3, 1)};
+        FractionStats stats;
+        for (const Fraction& value : values) {
+            stats.add(value);
+        }
+        CHECK(stats.getCount() == 6);
+        CHECK(stats.mean().getNumerator() == 7);
+        CHECK(stats.mean().getDenominator() == 8);
+        CHECK(stats.exactMoment(1).getNumerator().isZero());
+        for (int power = 2; power <= 4; ++power) {
+            CHECK(stats.exactMoment(power) == directMoment(values, power));
+        }
+        CHECK(BigFraction(stats.sampleVariance()) == directMoment(values, 2) * BigFraction(BigInt(6), BigInt(5)));
+        CHECK(stats.approximateMean() == doctest::Approx(0.875));
+        CHECK(stats.approximateMoment(3) == doctest::Approx(directMoment(values, 3).toDouble()));
+        CHECK_THROWS_AS(stats.moment(5), invalid_argument);
+        CHECK_THROWS_AS(FractionStats().mean(), runtime_error);
+    }
+
+    TEST_CASE("FractionStats handles wide denominators and merges") {
+        // five denominators near 2^31 with no common factor: the common denominator leaves long long after the third
+        vector<Fraction> values;
+        for (int index = 0; index < 5; ++index) {
+            values.emplace_back(index * 7919 - 100000, 2147483647 - 2 * index);
+        }
+        FractionStats whole(4);
+        FractionStats left(4), right(4);
+        for (size_t index = 0; index < values.size(); ++index) {
+            whole.add(values[index]);
+            (index % 3 == 0 ? left : right).add(values[index]);
+        }
+        left.merge(right);
+        CHECK(left.getCount() == 5);
+        for (int power = 1; power <= 4; ++power) {
+            CHECK(whole.exactMoment(power) == directMoment(values, power));
+            CHECK(left.exactMoment(power) == whole.exactMoment(power));
+            CHECK(left.approximateMoment(power) == doctest::Approx(whole.approximateMoment(power)));
+        }
+        CHECK_THROWS_AS(whole.mean(), overflow_error);
+
+        // a common denominator near 2^62 and values near 1: each square is near 2^124, so the 128-bit partial
+        // sum of squares spills within ten values, and cubes do not fit at all
+        vector<Fraction> near;
+        for (int index = 0; index < 10; ++index) {
+            near.emplace_back(2147483647 - index * 1000, index % 2 == 0 ? 2147483629 : 2147483647);
+        }
+        FractionStats nearStats(3);
+        for (const Fraction& value : near) {
+            nearStats.add(value);
+        }
+        CHECK(nearStats.exactMoment(2) == directMoment(near, 2));
+        CHECK(nearStats.exactMoment(3) == directMoment(near, 3));
+        CHECK_THROWS_AS(left.merge(FractionStats(3)), invalid_argument);
+    }
+
+    TEST_CASE("FractionStats approximate mode") {
+        FractionStats stats(2, StatsMode::Approximate);
+        FractionStats other(2, StatsMode::Approximate);
+        stats.add(Fraction(1000001, 1));
+        stats.add(Fraction(1000003, 1));
+        other.add(Fraction(1000005, 1));
+        stats.merge(other);
+        CHECK(stats.approximateMean() == doctest::Approx(1000003));
+        CHECK(stats.approximateVariance() == doctest::Approx(8.0 / 3));
+        CHECK_THROWS_AS(stats.variance(), logic_error);
+    }
+}
+
+TEST_SUITE("Simplex tests") {
+
+    TEST_CASE("SimplexSolver finds exact optima") {
+        SimplexSolver solver({Fraction(3, 1), Fraction(5, 1)});
+        solver.addConstraint({Fraction(1, 1), Fraction(0, 1)}, ConstraintKind::LessEqual, Fraction(4, 1));
+        solver.addConstraint({Fraction(0, 1), Fraction(2, 1)}, ConstraintKind::LessEqual, Fraction(12, 1));
+        solver.addConstraint({Fraction(3, 1), Fraction(2, 1)}, ConstraintKind::LessEqual, Fraction(18, 1));
+        SimplexResult result = solver.solve();
+        CHECK(result.status == SimplexStatus::Optimal);
+        CHECK(result.objective.toString() == "36/1");
+        CHECK(result.values[0].toString() == "2/1");
+        CHECK(result.values[1].toString() == "6/1");
+
+        SimplexSolver thirds({Fraction(1, 1), Fraction(1, 1)});
+        thirds.addConstraint({Fraction(2, 1), Fraction(1, 1)}, ConstraintKind::LessEqual, Fraction(1, 1));
+        thirds.addConstraint({Fraction(1, 1), Fraction(3, 1)}, ConstraintKind::LessEqual, Fraction(1, 1));
+        SimplexResult exact = thirds.solve();
+        CHECK(exact.objective.toString() == "3/5");
+        CHECK(exact.values[0].toString() == "2/5");
+        CHECK(exact.values[1].toString() == "1/5");
+    }
+
+    TEST_CASE("SimplexSolver handles equalities, lower bounds and failures") {
+        // minimize 2x + 3y with x + y >= 4 and x - y = 1
+        SimplexSolver solver({Fraction(-2, 1), Fraction(-3, 1)});
+        solver.addConstraint({Fraction(1, 1), Fraction(1, 1)}, ConstraintKind::GreaterEqual, Fraction(4, 1));
+        solver.addConstraint({Fraction(1, 1), Fraction(-1, 1)}, ConstraintKind::Equal, Fraction(1, 1));
+        SimplexResult result = solver.solve();
+        CHECK(result.status == SimplexStatus::Optimal);
+        CHECK(result.objective.toString() == "-19/2");
+        CHECK(result.values[0].toString() == "5/2");
+
+        SimplexSolver infeasible({Fraction(1, 1)});
+        infeasible.addConstraint({Fraction(1, 1)}, ConstraintKind::LessEqual, Fraction(1, 1));
+        infeasible.addConstraint({Fraction(1, 1)}, ConstraintKind::GreaterEqual, Fraction(2, 1));
+        CHECK(infeasible.solve().status == SimplexStatus::Infeasible);
+
+        SimplexSolver unbounded({Fraction(1, 1), Fraction(0, 1)});
+        unbounded.addConstraint({Fraction(1, 1), Fraction(-1, 1)}, ConstraintKind::LessEqual, Fraction(1, 1));
+        CHECK(unbounded.solve().status == SimplexStatus::Unbounded);
+        CHECK_THROWS_AS(unbounded.addConstraint({Fraction(1, 1)}, ConstraintKind::Equal, Fraction(0, 1)), invalid_argument);
+    }
+
+    TEST_CASE("SimplexSolver does not cycle on Beale's example") {
+        SimplexSolver solver({Fraction(3, 4), Fraction(-20, 1), Fraction(1, 2), Fraction(-6, 1)});
+        solver.addConstraint({Fraction(1, 4), Fraction(-8, 1), Fraction(-1, 1), Fraction(9, 1)}, ConstraintKind::LessEqual, Fraction(0, 1));
+        solver.addConstraint({Fraction(1, 2), Fraction(-12, 1), Fraction(-1, 2), Fraction(3, 1)}, ConstraintKind::LessEqual, Fraction(0, 1));
+        solver.addConstraint({Fraction(0, 1), Fraction(0, 1), Fraction(1, 1), Fraction(0, 1)}, ConstraintKind::LessEqual, Fraction(1, 1));
+        SimplexResult result = solver.solve();
+        CHECK(result.status == SimplexStatus::Optimal);
+        CHECK(result.objective.toString() == "5/4");
+    }
+
+    TEST_CASE("SimplexSolver warm starts from an earlier basis") {
+        SimplexSolver solver({Fraction(3, 1), Fraction(5, 1)});
+        solver.addConstraint({Fraction(1, 1), Fraction(0, 1)}, ConstraintKind::LessEqual, Fraction(4, 1));
+        solver.addConstraint({Fraction(0, 1), Fraction(2, 1)}, ConstraintKind::LessEqual, Fraction(12, 1));
+        size_t shared = solver.addConstraint({Fraction(3, 1), Fraction(2, 1)}, ConstraintKind::LessEqual, Fraction(18, 1));
+        SimplexResult first = solver.solve();
+
+        solver.setObjective({Fraction(3, 1), Fraction(4, 1)});
+        SimplexResult warm = solver.solve(first.basis);
+        SimplexResult cold = solver.solve();
+        CHECK(warm.warmStarted);
+        CHECK(warm.objective == cold.objective);
+        CHECK(warm.objective.toString() == "30/1");
+
+        solver.setBound(shared, Fraction(-1, 1));  // now infeasible: the old basis cannot be used
+        SimplexResult fallback = solver.solve(first.basis);
+        CHECK_FALSE(fallback.warmStarted);
+        CHECK(fallback.status == SimplexStatus::Infeasible);
+        CHECK_FALSE(solver.solve({0}).warmStarted);
+    }
+
+    TEST_CASE("SimplexSolver warm starts past dropped redundant rows") {
+        SimplexSolver solver({Fraction(1, 1), Fraction(1, 1)});
+        solver.addConstraint({Fraction(1, 1), Fraction(1, 1)}, ConstraintKind::Equal, Fraction(2, 1));
+        size_t twice = solver.addConstraint({Fraction(2, 1), Fraction(2, 1)}, ConstraintKind::Equal, Fraction(4, 1));  // redundant
+        solver.addConstraint({Fraction(1, 1), Fraction(0, 1)}, ConstraintKind::LessEqual, Fraction(3, 2));
+        SimplexResult first = solver.solve();
+        CHECK(first.status == SimplexStatus::Optimal);
+        REQUIRE(first.basis.size() == solver.getConstraintCount());
+        CHECK(count(first.basis.begin(), first.basis.end(), SimplexResult::DROPPED_ROW) == 1);
+
+        solver.setObjective({Fraction(1, 1), Fraction(2, 1)});
+        SimplexResult warm = solver.solve(first.basis);
+        SimplexResult cold = solver.solve();
+        CHECK(warm.warmStarted);
+        CHECK(warm.objective == cold.objective);
+        CHECK(warm.objective.toString() == "4/1");
+        CHECK(warm.basis.size() == solver.getConstraintCount());
+
+        solver.setBound(twice, Fraction(5, 1));  // no longer redundant but inconsistent
+        SimplexResult fallback = solver.solve(first.basis);
+        CHECK_FALSE(fallback.warmStarted);
+        CHECK(fallback.status == SimplexStatus::Infeasible);
+    }
+}
@@ -1,26 +1,309 @@
 #define DOCTEST_CONFIG_IMPLEMENT
 #include "doctest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 using namespace doctest;
 
 const int MIN_TESTS = 20;
 
+// Timing options, taken off the command line before doctest sees it:
+//   --timing-slowest=N      print the N slowest test cases and subcases
+//   --timing-json=FILE      write every duration as JSON (also the budget file format)
+//   --timing-junit=FILE     write a JUnit report with durations
+//   --timing-budget=FILE    fail any test slower than its budget * threshold + slack
+//   --timing-threshold=X    budget multiplier (default 1.5)
+//   --timing-slack=SECONDS  absolute allowance, so tiny tests don't fail on noise (default 0.01)
+struct TimingOptions {
+    size_t slowest = 0;
+    std::string jsonPath;
+    std::string junitPath;
+    std::string budgetPath;
+    double threshold = 1.5;
+    double slack = 0.01;
+};
+
+TimingOptions timingOptions;
+bool overBudget = false;
+bool budgetUnreadable = false;
+
+struct TestTiming {
+    std::string suite;
+    std::string name;   // "case" or "case > subcase > ..."
+    bool subcase = false;
+    bool passed = true;  // for a subcase: no failed assertion or exception while it was open
+    double seconds = 0;
+};
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char each : text) {
+        if (each == '"' || each == '\\') {
+            escaped += '\\';
+        }
+        escaped += each;
+    }
+    return escaped;
+}
+
+std::string xmlEscape(const std::string& text) {
+    std::string escaped;
+    for (char each : text) {
+        switch (each) {
+            case '&': escaped += "&amp;"; break;
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            case '"': escaped += "&quot;"; break;
+            default: escaped += each;
+        }
+    }
+    return escaped;
+}
+
+// Read one string field of a line written by writeTimingJson(), undoing jsonEscape().
+std::string stringField(const std::string& line, const std::string& key) {
+    std::string marker = "\"" + key + "\": \"";
+    size_t position = line.find(marker);
+    std::string value;
+    if (position == std::string::npos) {
+        return value;
+    }
+    for (position += marker.size(); position < line.size() && line[position] != '"'; ++position) {
+        if (line[position] == '\\' && position + 1 < line.size()) {
+            ++position;
+        }
+        value += line[position];
+    }
+    return value;
+}
+
+// Budgets keyed by "suite/name", read from a file written by --timing-json.
+std::map<std::string, double> readBudgets(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    std::map<std::string, double> budgets;
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t seconds = line.find("\"seconds\": ");
+        if (seconds == std::string::npos) {
+            continue;
+        }
+        budgets[stringField(line, "suite") + "/" + stringField(line, "name")] = std::atof(line.c_str() + seconds + 11);
+    }
+    return budgets;
+}
+
+void writeTimingJson(std::ostream& outs, const std::vector<TestTiming>& timings) {
+    outs << "{\n  \"tests\": [\n" << std::fixed << std::setprecision(6);
+    for (size_t index = 0; index < timings.size(); ++index) {
+        const TestTiming& timing = timings[index];
+        outs << "    {\"suite\": \"" << jsonEscape(timing.suite) << "\", \"name\": \"" << jsonEscape(timing.name) << "\", \"kind\": \""
+             << (timing.subcase ? "subcase" : "case") << "\", \"passed\": " << (timing.passed ? "true" : "false") << ", \"seconds\": "
+             << timing.seconds << "}" << (index + 1 < timings.size() ? "," : "") << "\n";
+    }
+    outs << "  ]\n}\n";
+}
+
+// JUnit has no notion of subcases, so only whole test cases become <testcase> elements.
+void writeJunit(std::ostream& outs, const std::vector<TestTiming>& timings, const std::map<std::string, std::string>& budgetFailures) {
+    std::map<std::string, std::vector<const TestTiming*>> suites;
+    for (const TestTiming& timing : timings) {
+        if (!timing.subcase) {
+            suites[timing.suite].push_back(&timing);
+        }
+    }
+    outs << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n" << std::fixed << std::setprecision(6);
+    for (const auto& [suite, cases] : suites) {
+        double total = 0;
+        size_t failures = 0;
+        for (const TestTiming* timing : cases) {
+            total += timing->seconds;
+            if (!timing->passed || budgetFailures.count(suite + "/" + timing->name) != 0) {
+                ++failures;
+            }
+        }
+        outs << "  <testsuite name=\"" << xmlEscape(suite) << "\" tests=\"" << cases.size() << "\" failures=\"" << failures << "\" time=\"" << total
+             << "\">\n";
+        for (const TestTiming* timing : cases) {
+            outs << "    <testcase classname=\"" << xmlEscape(suite) << "\" name=\"" << xmlEscape(timing->name) << "\" time=\"" << timing->seconds
+                 << "\"";
+            auto budget = budgetFailures.find(suite + "/" + timing->name);
+            if (timing->passed && budget == budgetFailures.end()) {
+                outs << "/>\n";
+                continue;
+            }
+            outs << ">\n";
+            if (!timing->passed) {
+                outs << "      <failure message=\"assertion failed\"/>\n";
+            }
+            if (budget != budgetFailures.end()) {
+                outs << "      <failure message=\"" << xmlEscape(budget->second) << "\"/>\n";
+            }
+            outs << "    </testcase>\n";
+        }
+        outs << "  </testsuite>\n";
+    }
+    outs << "</testsuites>\n";
+}
 
 struct ReporterGrader: public ConsoleReporter {
     ReporterGrader(const ContextOptions& input_options)
             : ConsoleReporter(input_options) {}
 
+    void test_case_start(const TestCaseData& in) override {
+        ConsoleReporter::test_case_start(in);
+        current = &in;
+        subcaseTimes.clear();
+        failedSubcases.clear();
+    }
+
+    void test_case_reenter(const TestCaseData& in) override {
+        ConsoleReporter::test_case_reenter(in);
+        openSubcases.clear();
+    }
+
+    void subcase_start(const SubcaseSignature& in) override {
+        ConsoleReporter::subcase_start(in);
+        std::string path = openSubcases.empty() ? current->m_name : openSubcases.back().first;
+        openSubcases.emplace_back(path + " > " + in.m_name.c_str(), std::chrono::steady_clock::now());
+    }
+
+    void log_assert(const AssertData& in) override {
+        ConsoleReporter::log_assert(in);
+        if (in.m_failed) {
+            failOpenSubcases();
+        }
+    }
+
+    void test_case_exception(const TestCaseException& in) override {
+        ConsoleReporter::test_case_exception(in);
+        failOpenSubcases();
+    }
+
+    void subcase_end() override {
+        ConsoleReporter::subcase_end();
+        if (openSubcases.empty()) {
+            return;
+        }
+        // A parent subcase is entered once per child, so its time accumulates over re-entries.
+        auto& [path, started] = openSubcases.back();
+        subcaseTimes[path] += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        openSubcases.pop_back();
+    }
+
+    void test_case_end(const CurrentTestCaseStats& st) override {
+        ConsoleReporter::test_case_end(st);
+        timings.push_back({current->m_test_suite, current->m_name, false, st.testCaseSuccess, st.seconds});
+        for (const auto& [path, seconds] : subcaseTimes) {
+            timings.push_back({current->m_test_suite, path, true, failedSubcases.count(path) == 0, seconds});
+        }
+    }
+
     void test_run_end(const TestRunStats& run_stats) override {
         ConsoleReporter::test_run_end(run_stats);
         int numAsserts = run_stats.numAsserts >=  MIN_TESTS? run_stats.numAsserts:  MIN_TESTS;
         float grade = (run_stats.numAsserts - run_stats.numAssertsFailed) * 100 / numAsserts;
         // std::cout << "Grade: " << grade << std::endl;
+        reportTimings();
     }
+
+    private:
+        const TestCaseData* current = nullptr;
+        std::vector<std::pair<std::string, std::chrono::steady_clock::time_point>> openSubcases;
+        std::map<std::string, double> subcaseTimes;
+        std::set<std::string> failedSubcases;
+        std::vector<TestTiming> timings;
+
+        // A failure inside a nested subcase fails every subcase around it.
+        void failOpenSubcases() {
+            for (const auto& [path, started] : openSubcases) {
+                failedSubcases.insert(path);
+            }
+        }
+
+        void reportTimings() {
+            std::map<std::string, std::string> budgetFailures;
+            if (!timingOptions.budgetPath.empty()) {
+                std::map<std::string, double> budgets;
+                try {
+                    budgets = readBudgets(timingOptions.budgetPath);
+                } catch (const std::runtime_error& error) {
+                    // Throwing out of the reporter would terminate the run; report it and fail the exit code instead.
+                    std::cout << "[timing] cannot check budgets: " << error.what() << "\n";
+                    budgetUnreadable = true;
+                }
+                for (const TestTiming& timing : timings) {
+                    auto budget = budgets.find(timing.suite + "/" + timing.name);
+                    if (budget == budgets.end() || timing.seconds <= budget->second * timingOptions.threshold + timingOptions.slack) {
+                        continue;
+                    }
+                    std::ostringstream message;
+                    message << std::fixed << std::setprecision(6) << "took " << timing.seconds << " s, budget " << budget->second << " s";
+                    budgetFailures[budget->first] = message.str();
+                    std::cout << "[timing] OVER BUDGET " << timing.suite << " / " << timing.name << ": " << message.str() << "\n";
+                }
+                overBudget = !budgetFailures.empty();
+            }
+            if (timingOptions.slowest > 0) {
+                std::vector<TestTiming> sorted = timings;
+                std::sort(sorted.begin(), sorted.end(), [](const TestTiming& left, const TestTiming& right) { return left.seconds > right.seconds; });
+                sorted.resize(std::min(sorted.size(), timingOptions.slowest));
+                std::cout << "[timing] slowest " << sorted.size() << ":\n" << std::fixed << std::setprecision(6);
+                for (const TestTiming& timing : sorted) {
+                    std::cout << "[timing] " << std::setw(10) << timing.seconds << " s  " << timing.suite << " / " << timing.name << "\n";
+                }
+            }
+            if (!timingOptions.jsonPath.empty()) {
+                std::ofstream file(timingOptions.jsonPath);
+                writeTimingJson(file, timings);
+            }
+            if (!timingOptions.junitPath.empty()) {
+                std::ofstream file(timingOptions.junitPath);
+                writeJunit(file, timings, budgetFailures);
+            }
+        }
 };
 
 REGISTER_REPORTER("grader", /*priority=*/1, ReporterGrader);
 
+// Returns the value of "--name=value" when argument has that form, else nullptr.
+const char* optionValue(const char* argument, const char* name) {
+    size_t length = std::strlen(name);
+    return (std::strncmp(argument, name, length) == 0 && argument[length] == '=') ? argument + length + 1 : nullptr;
+}
+
 int main(int argc, char** argv) {
+    for (int index = 1; index < argc; ++index) {
+        const char* value = nullptr;
+        if ((value = optionValue(argv[index], "--timing-slowest"))) {
+            timingOptions.slowest = std::strtoul(value, nullptr, 10);
+        } else if ((value = optionValue(argv[index], "--timing-json"))) {
+            timingOptions.jsonPath = value;
+        } else if ((value = optionValue(argv[index], "--timing-junit"))) {
+            timingOptions.junitPath = value;
+        } else if ((value = optionValue(argv[index], "--timing-budget"))) {
+            timingOptions.budgetPath = value;
+        } else if ((value = optionValue(argv[index], "--timing-threshold"))) {
+            timingOptions.threshold = std::atof(value);
+        } else if ((value = optionValue(argv[index], "--timing-slack"))) {
+            timingOptions.slack = std::atof(value);
+        }
+    }
     Context context;
     context.addFilter("reporters", "grader");
-    return context.run();
+    int result = context.run();
+    return (result == 0 && (overBudget || budgetUnreadable)) ? 1 : result;
 }
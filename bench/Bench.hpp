@@ -0,0 +1,364 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+/**
+ * A small, dependency-free timing harness for the bench/ programs.
+ *
+ * measure() calibrates a batch size until one batch runs for at least the
+ * minimum time, then keeps the fastest of several batches. Results can be
+ * written to and read back from JSON, and compare() flags every case that
+ * slowed down by more than a threshold against a saved baseline.
+ *
+ * measureLatency() times every call on its own instead and records it in an
+ * HdrHistogram, for the percentiles an average hides.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace bench {
+
+    // One timed case: an operation run on one input set.
+    struct Result {
+        std::string name;
+        std::string input;
+        double nsPerOp = 0;
+        double opsPerSecond = 0;
+        double cyclesPerOp = 0;    // time-stamp counter ticks; 0 where there is no counter
+        double failureRate = 0;    // share of calls that threw
+        std::uint64_t iterations = 0;
+    };
+
+    struct Options {
+        double minMilliseconds = 20;  // per batch
+        int samples = 5;              // batches per case; the fastest one is kept
+    };
+
+    // Stop the optimizer from discarding a value, or from keeping it only in a register.
+    template <typename T>
+    inline void keep(const T& value) {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    inline std::uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    // A serialized timestamp for timing a single call: TSC ticks on x86, nanoseconds elsewhere.
+    inline std::uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_lfence();
+        std::uint64_t now = __rdtsc();
+        _mm_lfence();
+        return now;
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // How many ticks() units pass per nanosecond, measured once against steady_clock.
+    inline double ticksPerNanosecond() {
+#if defined(__x86_64__) || defined(__i386__)
+        static const double rate = []() {
+            auto start = std::chrono::steady_clock::now();
+            std::uint64_t startTicks = ticks();
+            while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(50)) {
+            }
+            std::uint64_t elapsedTicks = ticks() - startTicks;
+            double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            return static_cast<double>(elapsedTicks) / elapsed;
+        }();
+        return rate;
+#else
+        return 1;
+#endif
+    }
+
+    /**
+     * A high-dynamic-range histogram: values below 128 are counted exactly, larger ones in
+     * 64 linear sub-buckets per power of two, so every recorded value is kept to within
+     * 1/64 (1.6%) relative error at a fixed 3776 counters, from 0 to 2^64 - 1.
+     */
+    class HdrHistogram {
+        private:
+            static const unsigned SUB_BITS = 7;
+            static const std::uint64_t SUB_COUNT = std::uint64_t(1) << SUB_BITS;  // 128
+            static const std::uint64_t HALF_COUNT = SUB_COUNT / 2;                 // 64
+            std::vector<std::uint64_t> counts;
+            std::uint64_t total = 0;
+            std::uint64_t largest = 0;
+            long double sum = 0;
+
+            static std::size_t indexOf(std::uint64_t value) {
+                if (value < SUB_COUNT) {
+                    return static_cast<std::size_t>(value);
+                }
+                unsigned shift = static_cast<unsigned>(64 - __builtin_clzll(value)) - SUB_BITS;
+                return static_cast<std::size_t>(SUB_COUNT + (shift - 1) * HALF_COUNT + ((value >> shift) - HALF_COUNT));
+            }
+
+            // The largest value that lands in bucket index.
+            static std::uint64_t highestIn(std::size_t index) {
+                if (index < SUB_COUNT) {
+                    return index;
+                }
+                std::uint64_t shift = (index - SUB_COUNT) / HALF_COUNT + 1;
+                std::uint64_t top = (index - SUB_COUNT) % HALF_COUNT + HALF_COUNT;
+                return ((top + 1) << shift) - 1;
+            }
+
+        public:
+            HdrHistogram() : counts(SUB_COUNT + 57 * HALF_COUNT, 0) {}
+
+            void record(std::uint64_t value) {
+                ++counts[indexOf(value)];
+                ++total;
+                largest = std::max(largest, value);
+                sum += value;
+            }
+
+            void merge(const HdrHistogram& other) {
+                for (std::size_t index = 0; index < counts.size(); ++index) {
+                    counts[index] += other.counts[index];
+                }
+                total += other.total;
+                largest = std::max(largest, other.largest);
+                sum += other.sum;
+            }
+
+            std::uint64_t count() const { return total; }
+            std::uint64_t max() const { return largest; }
+            double mean() const { return total == 0 ? 0 : static_cast<double>(sum / total); }
+
+            // The smallest bucket bound that at least percentile% of the values do not exceed.
+            std::uint64_t valueAtPercentile(double percentile) const {
+                if (total == 0) {
+                    return 0;
+                }
+                double wanted = percentile / 100 * static_cast<double>(total);
+                std::uint64_t seen = 0;
+                for (std::size_t index = 0; index < counts.size(); ++index) {
+                    seen += counts[index];
+                    if (counts[index] != 0 && static_cast<double>(seen) >= wanted) {
+                        return std::min(highestIn(index), largest);
+                    }
+                }
+                return largest;
+            }
+    };
+
+    // Per-call latency of one operation on one input distribution, in nanoseconds.
+    struct LatencyResult {
+        std::string name;
+        std::string input;
+        double p50 = 0;
+        double p99 = 0;
+        double p999 = 0;
+        double max = 0;
+        double mean = 0;
+        std::uint64_t calls = 0;
+    };
+
+    /**
+     * @brief Time call(index) once per index in [0, calls), recording each call in an HdrHistogram.
+     * The cost of reading the clock, measured on empty calls, is subtracted from every sample.
+     */
+    template <typename Call>
+    LatencyResult measureLatency(const std::string& name, const std::string& input, std::uint64_t calls, Call call) {
+        std::uint64_t overhead = ~std::uint64_t(0);
+        for (int probe = 0; probe < 1000; ++probe) {
+            std::uint64_t start = ticks();
+            overhead = std::min(overhead, ticks() - start);
+        }
+        HdrHistogram histogram;
+        for (std::uint64_t index = 0; index < calls; ++index) {
+            std::uint64_t start = ticks();
+            call(index);
+            std::uint64_t elapsed = ticks() - start;
+            histogram.record(elapsed > overhead ? elapsed - overhead : 0);
+        }
+        double scale = 1 / ticksPerNanosecond();
+        LatencyResult result{name, input};
+        result.p50 = static_cast<double>(histogram.valueAtPercentile(50)) * scale;
+        result.p99 = static_cast<double>(histogram.valueAtPercentile(99)) * scale;
+        result.p999 = static_cast<double>(histogram.valueAtPercentile(99.9)) * scale;
+        result.max = static_cast<double>(histogram.max()) * scale;
+        result.mean = histogram.mean() * scale;
+        result.calls = histogram.count();
+        return result;
+    }
+
+    inline void printLatencyHeader(std::ostream& outs) {
+        outs << std::left << std::setw(20) << "operation" << std::setw(16) << "input" << std::right << std::setw(10) << "p50 ns"
+             << std::setw(10) << "p99 ns" << std::setw(11) << "p99.9 ns" << std::setw(12) << "max ns" << std::setw(10) << "mean ns" << "\n";
+    }
+
+    inline void printLatency(std::ostream& outs, const LatencyResult& result) {
+        outs << std::left << std::setw(20) << result.name << std::setw(16) << result.input << std::right << std::fixed << std::setprecision(1)
+             << std::setw(10) << result.p50 << std::setw(10) << result.p99 << std::setw(11) << result.p999 << std::setw(12) << result.max
+             << std::setw(10) << result.mean << "\n";
+    }
+
+    inline void writeLatencyJson(std::ostream& outs, const std::vector<LatencyResult>& results) {
+        outs << "{\n  \"latency\": [\n" << std::setprecision(3) << std::fixed;
+        for (std::size_t index = 0; index < results.size(); ++index) {
+            const LatencyResult& result = results[index];
+            outs << "    {\"name\": \"" << result.name << "\", \"input\": \"" << result.input << "\", \"p50_ns\": " << result.p50
+                 << ", \"p99_ns\": " << result.p99 << ", \"p999_ns\": " << result.p999 << ", \"max_ns\": " << result.max
+                 << ", \"mean_ns\": " << result.mean << ", \"calls\": " << result.calls << "}" << (index + 1 < results.size() ? "," : "") << "\n";
+        }
+        outs << "  ]\n}\n";
+    }
+
+    /**
+     * @brief Time body(iterations), which must run the operation that many times.
+     * @param body Returns how many of the calls failed (threw).
+     */
+    template <typename Body>
+    Result measure(const std::string& name, const std::string& input, Body body, const Options& options = Options()) {
+        using Clock = std::chrono::steady_clock;
+        std::uint64_t iterations = 16;
+        for (;;) {
+            auto start = Clock::now();
+            body(iterations);
+            double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            if (elapsed >= options.minMilliseconds || iterations >= (std::uint64_t(1) << 40)) {
+                break;
+            }
+            // Aim just past the minimum time, growing at most 10x per step.
+            double factor = elapsed > 0 ? options.minMilliseconds * 1.2 / elapsed : 10;
+            iterations = static_cast<std::uint64_t>(static_cast<double>(iterations) * (factor > 10 ? 10 : (factor < 2 ? 2 : factor)));
+        }
+
+        Result result{name, input};
+        result.iterations = iterations;
+        for (int sample = 0; sample < options.samples; ++sample) {
+            auto start = Clock::now();
+            std::uint64_t startCycles = cycles();
+            std::uint64_t failures = body(iterations);
+            std::uint64_t elapsedCycles = cycles() - startCycles;
+            double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            double nsPerOp = elapsed / static_cast<double>(iterations);
+            if (sample == 0 || nsPerOp < result.nsPerOp) {
+                result.nsPerOp = nsPerOp;
+                result.cyclesPerOp = static_cast<double>(elapsedCycles) / static_cast<double>(iterations);
+                result.failureRate = static_cast<double>(failures) / static_cast<double>(iterations);
+            }
+        }
+        result.opsPerSecond = result.nsPerOp > 0 ? 1e9 / result.nsPerOp : 0;
+        return result;
+    }
+
+    inline void printHeader(std::ostream& outs) {
+        outs << std::left << std::setw(22) << "operation" << std::setw(15) << "input" << std::right
+             << std::setw(11) << "ns/op" << std::setw(12) << "Mops/s" << std::setw(11) << "cycles/op" << std::setw(9) << "throws" << "\n";
+    }
+
+    inline void printResult(std::ostream& outs, const Result& result) {
+        outs << std::left << std::setw(22) << result.name << std::setw(15) << result.input << std::right << std::fixed
+             << std::setprecision(2) << std::setw(11) << result.nsPerOp << std::setw(12) << result.opsPerSecond / 1e6
+             << std::setw(11) << result.cyclesPerOp << std::setw(8) << result.failureRate * 100 << "%\n";
+    }
+
+    /**
+     * @brief Write results as JSON, one result object per line so readJson() can stay simple.
+     */
+    inline void writeJson(std::ostream& outs, const std::vector<Result>& results) {
+        outs << "{\n  \"results\": [\n" << std::setprecision(6) << std::fixed;
+        for (std::size_t index = 0; index < results.size(); ++index) {
+            const Result& result = results[index];
+            outs << "    {\"name\": \"" << result.name << "\", \"input\": \"" << result.input << "\", \"ns_per_op\": " << result.nsPerOp
+                 << ", \"ops_per_sec\": " << result.opsPerSecond << ", \"cycles_per_op\": " << result.cyclesPerOp
+                 << ", \"failure_rate\": " << result.failureRate << ", \"iterations\": " << result.iterations << "}"
+                 << (index + 1 < results.size() ? "," : "") << "\n";
+        }
+        outs << "  ]\n}\n";
+    }
+
+    namespace detail {
+        inline std::string stringField(const std::string& line, const std::string& key) {
+            std::string marker = "\"" + key + "\": \"";
+            std::size_t start = line.find(marker);
+            if (start == std::string::npos) {
+                return "";
+            }
+            start += marker.size();
+            return line.substr(start, line.find('"', start) - start);
+        }
+
+        inline double numberField(const std::string& line, const std::string& key) {
+            std::string marker = "\"" + key + "\": ";
+            std::size_t start = line.find(marker);
+            return start == std::string::npos ? 0 : std::stod(line.substr(start + marker.size()));
+        }
+    }
+
+    /**
+     * @brief Read results written by writeJson().
+     * @throws runtime_error If the file cannot be opened.
+     */
+    inline std::vector<Result> readJson(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        std::vector<Result> results;
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.find("\"name\"") == std::string::npos) {
+                continue;
+            }
+            Result result;
+            result.name = detail::stringField(line, "name");
+            result.input = detail::stringField(line, "input");
+            result.nsPerOp = detail::numberField(line, "ns_per_op");
+            result.opsPerSecond = detail::numberField(line, "ops_per_sec");
+            result.cyclesPerOp = detail::numberField(line, "cycles_per_op");
+            result.failureRate = detail::numberField(line, "failure_rate");
+            result.iterations = static_cast<std::uint64_t>(detail::numberField(line, "iterations"));
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    /**
+     * @brief Report every case that got slower than the baseline by more than thresholdPercent.
+     * @return The number of regressions.
+     */
+    inline int compare(const std::vector<Result>& current, const std::vector<Result>& baseline, double thresholdPercent, std::ostream& outs) {
+        int regressions = 0;
+        for (const Result& result : current) {
+            for (const Result& before : baseline) {
+                if (before.name != result.name || before.input != result.input || before.nsPerOp <= 0) {
+                    continue;
+                }
+                double change = (result.nsPerOp - before.nsPerOp) / before.nsPerOp * 100;
+                if (change > thresholdPercent) {
+                    ++regressions;
+                    outs << "REGRESSION " << std::left << std::setw(22) << result.name << std::setw(15) << result.input << std::right
+                         << std::fixed << std::setprecision(2) << before.nsPerOp << " -> " << result.nsPerOp << " ns/op (+" << change << "%)\n";
+                }
+            }
+        }
+        outs << regressions << " regression(s) above " << thresholdPercent << "%\n";
+        return regressions;
+    }
+}
+
+#endif /* BENCH_HPP */
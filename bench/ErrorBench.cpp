@@ -0,0 +1,106 @@
+/**
+ * Compares the cost of reporting Fraction overflow by exception (operator*)
+ * with returning it as a value (checked_mul) and with a sticky flag
+ * (FractionArithmetic<FlagPolicy>), at several overflow rates.
+ *
+ * Usage: bench_errors [operations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../sources/Fraction.hpp"
+#include "../sources/FractionPolicy.hpp"
+
+using namespace std;
+using namespace ariel;
+
+namespace {
+
+    struct Operands {
+        vector<Fraction> left;
+        vector<Fraction> right;
+    };
+
+    // Small operands multiply safely; an overflowRate share of pairs are large enough to overflow.
+    Operands makeOperands(size_t count, double overflowRate) {
+        mt19937 generator(12345);
+        uniform_int_distribution<int> small(1, 1000);
+        uniform_int_distribution<int> large(100000, 1000000);
+        bernoulli_distribution overflows(overflowRate);
+        Operands operands;
+        for (size_t index = 0; index < count; ++index) {
+            bool big = overflows(generator);
+            operands.left.push_back(Fraction(big ? large(generator) : small(generator), small(generator)));
+            operands.right.push_back(Fraction(big ? large(generator) : small(generator), small(generator)));
+        }
+        return operands;
+    }
+
+    // The fallback both variants take on overflow: finish the multiplication in double.
+    double widen(const Fraction& left, const Fraction& right) {
+        return (static_cast<double>(left.getNumerator()) * right.getNumerator()) /
+               (static_cast<double>(left.getDenominator()) * right.getDenominator());
+    }
+
+    template <typename Body>
+    double nanosecondsPerOperation(size_t count, Body body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+        return elapsed.count() / static_cast<double>(count);
+    }
+}
+
+int main(int argc, char** argv) {
+    volatile double observed = 0;  // keeps the timed loops from being optimized away
+    size_t count = (argc > 1) ? stoul(argv[1]) : 2000000;
+    cout << setw(10) << "overflow" << setw(16) << "throw ns/op" << setw(16) << "checked ns/op" << setw(16) << "flag ns/op" << "\n";
+    for (double rate : {0.0, 0.01, 0.1}) {
+        Operands operands = makeOperands(count, rate);
+        double sink = 0;
+
+        double throwing = nanosecondsPerOperation(count, [&]() {
+            for (size_t index = 0; index < count; ++index) {
+                try {
+                    sink += (operands.left[index] * operands.right[index]).getNumerator();
+                } catch (const overflow_error&) {
+                    sink += widen(operands.left[index], operands.right[index]);
+                }
+            }
+        });
+
+        double checked = nanosecondsPerOperation(count, [&]() {
+            for (size_t index = 0; index < count; ++index) {
+                FractionResult product = checked_mul(operands.left[index], operands.right[index]);
+                sink += product ? product->getNumerator() : widen(operands.left[index], operands.right[index]);
+            }
+        });
+
+        // The flag is only inspected once per batch; failed slots are redone in double afterwards.
+        double flagged = nanosecondsPerOperation(count, [&]() {
+            FlagPolicy::clear();
+            for (size_t index = 0; index < count; ++index) {
+                sink += FractionArithmetic<FlagPolicy>::mul(operands.left[index], operands.right[index]).getNumerator();
+            }
+            if (FlagPolicy::raised()) {
+                for (size_t index = 0; index < count; ++index) {
+                    if (!checked_mul(operands.left[index], operands.right[index])) {
+                        sink += widen(operands.left[index], operands.right[index]);
+                    }
+                }
+            }
+        });
+
+        cout << setw(9) << rate * 100 << "%" << setw(16) << fixed << setprecision(2) << throwing << setw(16) << checked << setw(16) << flagged << "\n";
+        observed = sink;
+    }
+    (void)observed;
+    return 0;
+}
@@ -0,0 +1,218 @@
+/**
+ * Times every constructor, operator and stream function declared in
+ * Fraction.hpp on three input sets:
+ *   small          terms up to 100; nothing overflows
+ *   large          terms up to 46340, so every single product still fits in int
+ *   near-overflow  terms just under 46341, where sums and some products throw
+ *
+ * Usage: bench_fraction [--filter text] [--min-time ms] [--json out.json]
+ *                       [--compare baseline.json] [--threshold percent]
+ *
+ * With --compare the exit status is 1 when any case is slower than the
+ * baseline by more than the threshold (default 10%).
+ */
+
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Bench.hpp"
+#include "../sources/Fraction.hpp"
+
+using namespace std;
+using namespace ariel;
+
+namespace {
+
+    const size_t POOL_SIZE = 4096;  // a power of two, so index & POOL_MASK wraps around the pool
+    const size_t POOL_MASK = POOL_SIZE - 1;
+
+    struct Operands {
+        string name;
+        vector<int> numerators;
+        vector<int> denominators;
+        vector<Fraction> left;
+        vector<Fraction> right;
+        vector<float> floats;
+        string text;  // every left operand as "n/d ", for operator>>
+    };
+
+    Operands makeOperands(const string& name, int low, int high, unsigned seed) {
+        mt19937 generator(seed);
+        uniform_int_distribution<int> magnitude(low, high);
+        bernoulli_distribution negative(0.5);
+        Operands operands;
+        operands.name = name;
+        for (size_t index = 0; index < POOL_SIZE; ++index) {
+            int numerator = negative(generator) ? -magnitude(generator) : magnitude(generator);
+            int denominator = magnitude(generator);
+            operands.numerators.push_back(numerator);
+            operands.denominators.push_back(denominator);
+            operands.left.push_back(Fraction(numerator, denominator));
+            operands.right.push_back(Fraction(magnitude(generator), magnitude(generator)));
+            operands.floats.push_back(static_cast<float>(numerator) / static_cast<float>(denominator));
+            operands.text += to_string(numerator) + "/" + to_string(denominator) + " ";
+        }
+        return operands;
+    }
+
+    struct Suite {
+        bench::Options options;
+        string filter;
+        vector<bench::Result> results;
+    };
+
+    /**
+     * @brief Time operation(operands, index) over every input set; calls that throw are counted, not fatal.
+     */
+    template <typename Operation>
+    void run(Suite& suite, const vector<Operands>& inputs, const string& name, Operation operation) {
+        if (!suite.filter.empty() && name.find(suite.filter) == string::npos) {
+            return;
+        }
+        for (const Operands& operands : inputs) {
+            bench::Result result = bench::measure(name, operands.name, [&](uint64_t iterations) {
+                uint64_t failures = 0;
+                for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                    try {
+                        bench::keep(operation(operands, static_cast<size_t>(iteration) & POOL_MASK));
+                    } catch (const exception&) {
+                        ++failures;
+                    }
+                }
+                return failures;
+            }, suite.options);
+            bench::printResult(cout, result);
+            suite.results.push_back(result);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Suite suite;
+    string jsonPath;
+    string baselinePath;
+    double threshold = 10;
+    for (int index = 1; index < argc; ++index) {
+        string argument = argv[index];
+        string value = (index + 1 < argc) ? argv[index + 1] : "";
+        if (argument == "--filter") {
+            suite.filter = value;
+        } else if (argument == "--min-time") {
+            suite.options.minMilliseconds = stod(value);
+        } else if (argument == "--json") {
+            jsonPath = value;
+        } else if (argument == "--compare") {
+            baselinePath = value;
+        } else if (argument == "--threshold") {
+            threshold = stod(value);
+        } else {
+            cerr << "usage: " << argv[0] << " [--filter text] [--min-time ms] [--json out.json] [--compare baseline.json] [--threshold percent]\n";
+            return 2;
+        }
+        ++index;
+    }
+
+    vector<bench::Result> baseline;
+    if (!baselinePath.empty()) {
+        try {
+            baseline = bench::readJson(baselinePath);
+        } catch (const exception& error) {
+            cerr << error.what() << "\n";
+            return 2;
+        }
+    }
+
+    const vector<Operands> inputs = {
+        makeOperands("small", 1, 100, 1),
+        makeOperands("large", 1000, 46340, 2),
+        makeOperands("near-overflow", 46000, 46340, 3),
+    };
+    using Ops = Operands;
+    bench::printHeader(cout);
+
+    // constructors
+    run(suite, inputs, "Fraction()", [](const Ops&, size_t) { return Fraction(); });
+    run(suite, inputs, "Fraction(int,int)", [](const Ops& ops, size_t i) { return Fraction(ops.numerators[i], ops.denominators[i]); });
+    run(suite, inputs, "Fraction(float)", [](const Ops& ops, size_t i) { return Fraction(ops.floats[i]); });
+    run(suite, inputs, "fromReduced", [](const Ops& ops, size_t i) { return Fraction::fromReduced(ops.numerators[i], ops.denominators[i]); });
+
+    // getters and setters
+    run(suite, inputs, "getNumerator", [](const Ops& ops, size_t i) { return ops.left[i].getNumerator(); });
+    run(suite, inputs, "getDenominator", [](const Ops& ops, size_t i) { return ops.left[i].getDenominator(); });
+    run(suite, inputs, "setNumerator", [](const Ops& ops, size_t i) { Fraction value = ops.left[i]; value.setNumerator(ops.numerators[i]); return value; });
+    run(suite, inputs, "setDenominator", [](const Ops& ops, size_t i) { Fraction value = ops.left[i]; value.setDenominator(ops.denominators[i]); return value; });
+
+    // arithmetic
+    run(suite, inputs, "operator+", [](const Ops& ops, size_t i) { return ops.left[i] + ops.right[i]; });
+    run(suite, inputs, "operator-", [](const Ops& ops, size_t i) { return ops.left[i] - ops.right[i]; });
+    run(suite, inputs, "operator*", [](const Ops& ops, size_t i) { return ops.left[i] * ops.right[i]; });
+    run(suite, inputs, "operator/", [](const Ops& ops, size_t i) { return ops.left[i] / ops.right[i]; });
+    run(suite, inputs, "checked_add", [](const Ops& ops, size_t i) { return checked_add(ops.left[i], ops.right[i]).has_value(); });
+    run(suite, inputs, "checked_sub", [](const Ops& ops, size_t i) { return checked_sub(ops.left[i], ops.right[i]).has_value(); });
+    run(suite, inputs, "checked_mul", [](const Ops& ops, size_t i) { return checked_mul(ops.left[i], ops.right[i]).has_value(); });
+    run(suite, inputs, "checked_div", [](const Ops& ops, size_t i) { return checked_div(ops.left[i], ops.right[i]).has_value(); });
+
+    // comparison
+    run(suite, inputs, "operator==", [](const Ops& ops, size_t i) { return ops.left[i] == ops.right[i]; });
+    run(suite, inputs, "operator!=", [](const Ops& ops, size_t i) { return ops.left[i] != ops.right[i]; });
+    run(suite, inputs, "operator>", [](const Ops& ops, size_t i) { return ops.left[i] > ops.right[i]; });
+    run(suite, inputs, "operator<", [](const Ops& ops, size_t i) { return ops.left[i] < ops.right[i]; });
+    run(suite, inputs, "operator>=", [](const Ops& ops, size_t i) { return ops.left[i] >= ops.right[i]; });
+    run(suite, inputs, "operator<=", [](const Ops& ops, size_t i) { return ops.left[i] <= ops.right[i]; });
+
+    // increment and decrement
+    run(suite, inputs, "operator++()", [](const Ops& ops, size_t i) { Fraction value = ops.left[i]; return ++value; });
+    run(suite, inputs, "operator++(int)", [](const Ops& ops, size_t i) { Fraction value = ops.left[i]; return value++; });
+    run(suite, inputs, "operator--()", [](const Ops& ops, size_t i) { Fraction value = ops.left[i]; return --value; });
+    run(suite, inputs, "operator--(int)", [](const Ops& ops, size_t i) { Fraction value = ops.left[i]; return value--; });
+
+    // float on the left
+    run(suite, inputs, "float+Fraction", [](const Ops& ops, size_t i) { return ops.floats[i] + ops.right[i]; });
+    run(suite, inputs, "float-Fraction", [](const Ops& ops, size_t i) { return ops.floats[i] - ops.right[i]; });
+    run(suite, inputs, "float*Fraction", [](const Ops& ops, size_t i) { return ops.floats[i] * ops.right[i]; });
+    run(suite, inputs, "float/Fraction", [](const Ops& ops, size_t i) { return ops.floats[i] / ops.right[i]; });
+    run(suite, inputs, "float==Fraction", [](const Ops& ops, size_t i) { return ops.floats[i] == ops.right[i]; });
+    run(suite, inputs, "float!=Fraction", [](const Ops& ops, size_t i) { return ops.floats[i] != ops.right[i]; });
+    run(suite, inputs, "float>Fraction", [](const Ops& ops, size_t i) { return ops.floats[i] > ops.right[i]; });
+    run(suite, inputs, "float<Fraction", [](const Ops& ops, size_t i) { return ops.floats[i] < ops.right[i]; });
+    run(suite, inputs, "float>=Fraction", [](const Ops& ops, size_t i) { return ops.floats[i] >= ops.right[i]; });
+    run(suite, inputs, "float<=Fraction", [](const Ops& ops, size_t i) { return ops.floats[i] <= ops.right[i]; });
+
+    // streams: one stream per run, rewound whenever the pool wraps
+    ostringstream output;
+    run(suite, inputs, "operator<<", [&output](const Ops& ops, size_t i) {
+        if (i == 0) {
+            output.str("");
+        }
+        output << ops.left[i] << ' ';
+        return output.tellp();
+    });
+    istringstream input;
+    const Ops* loaded = nullptr;
+    run(suite, inputs, "operator>>", [&input, &loaded](const Ops& ops, size_t i) {
+        if (i == 0 || loaded != &ops) {
+            input.clear();
+            input.str(ops.text);
+            loaded = &ops;
+        }
+        Fraction value;
+        input >> value;
+        return value;
+    });
+
+    if (!jsonPath.empty()) {
+        ofstream file(jsonPath);
+        bench::writeJson(file, suite.results);
+        cout << "wrote " << suite.results.size() << " results to " << jsonPath << "\n";
+    }
+    if (!baselinePath.empty()) {
+        return bench::compare(suite.results, baseline, threshold, cout) > 0 ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * Records the latency of every single Fraction call in an HDR histogram and
+ * reports p50/p99/p99.9/max per operation and input distribution:
+ *   uniform        terms uniform in [1, 46340], either sign
+ *   small-denom    denominators 1..16, numerators up to 1000
+ *   fibonacci      consecutive Fibonacci numbers, the worst case for Euclid's gcd
+ *   near-overflow  terms just under 46341, where sums and some products throw
+ *
+ * Usage: bench_latency [--calls n] [--filter text] [--json out.json]
+ */
+
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Bench.hpp"
+#include "../sources/Fraction.hpp"
+
+using namespace std;
+using namespace ariel;
+
+namespace {
+
+    const size_t POOL_SIZE = 4096;  // a power of two, so index & POOL_MASK wraps around the pool
+    const size_t POOL_MASK = POOL_SIZE - 1;
+
+    struct Distribution {
+        string name;
+        vector<int> numerators;
+        vector<int> denominators;
+        vector<Fraction> left;
+        vector<Fraction> right;
+    };
+
+    // Fill a distribution from a generator of raw (numerator, denominator) pairs.
+    template <typename Pair>
+    Distribution makeDistribution(const string& name, Pair pair) {
+        Distribution distribution;
+        distribution.name = name;
+        for (size_t index = 0; index < POOL_SIZE; ++index) {
+            auto [numerator, denominator] = pair();
+            distribution.numerators.push_back(numerator);
+            distribution.denominators.push_back(denominator);
+            distribution.left.push_back(Fraction(numerator, denominator));
+            auto [otherNumerator, otherDenominator] = pair();
+            distribution.right.push_back(Fraction(otherNumerator, otherDenominator));
+        }
+        return distribution;
+    }
+
+    vector<Distribution> makeDistributions() {
+        mt19937 generator(7);
+        uniform_int_distribution<int> wide(1, 46340);
+        uniform_int_distribution<int> small(1, 16);
+        uniform_int_distribution<int> numerators(-1000, 1000);
+        uniform_int_distribution<int> near(46000, 46340);
+        bernoulli_distribution negative(0.5);
+
+        vector<int> fibonacci = {1, 2};
+        while (fibonacci.back() < 46340 / 2) {
+            fibonacci.push_back(fibonacci[fibonacci.size() - 1] + fibonacci[fibonacci.size() - 2]);
+        }
+        uniform_int_distribution<size_t> term(fibonacci.size() / 2, fibonacci.size() - 2);
+
+        return {
+            makeDistribution("uniform", [&]() { return pair<int, int>(negative(generator) ? -wide(generator) : wide(generator), wide(generator)); }),
+            makeDistribution("small-denom", [&]() { return pair<int, int>(numerators(generator), small(generator)); }),
+            makeDistribution("fibonacci", [&]() { size_t at = term(generator); return pair<int, int>(fibonacci[at + 1], fibonacci[at]); }),
+            makeDistribution("near-overflow", [&]() { return pair<int, int>(negative(generator) ? -near(generator) : near(generator), near(generator)); }),
+        };
+    }
+}
+
+int main(int argc, char** argv) {
+    uint64_t calls = 200000;
+    string filter;
+    string jsonPath;
+    for (int index = 1; index + 1 < argc; index += 2) {
+        string argument = argv[index];
+        if (argument == "--calls") {
+            calls = stoull(argv[index + 1]);
+        } else if (argument == "--filter") {
+            filter = argv[index + 1];
+        } else if (argument == "--json") {
+            jsonPath = argv[index + 1];
+        } else {
+            cerr << "usage: " << argv[0] << " [--calls n] [--filter text] [--json out.json]\n";
+            return 2;
+        }
+    }
+    if (argc % 2 == 0) {
+        cerr << "usage: " << argv[0] << " [--calls n] [--filter text] [--json out.json]\n";
+        return 2;
+    }
+
+    const vector<Distribution> distributions = makeDistributions();
+    vector<bench::LatencyResult> results;
+    bench::printLatencyHeader(cout);
+
+    // Calls that throw are timed too: on near-overflow input the exception path is the tail.
+    auto run = [&](const string& name, auto operation) {
+        if (!filter.empty() && name.find(filter) == string::npos) {
+            return;
+        }
+        for (const Distribution& distribution : distributions) {
+            bench::LatencyResult result = bench::measureLatency(name, distribution.name, calls, [&](uint64_t call) {
+                size_t index = static_cast<size_t>(call) & POOL_MASK;
+                try {
+                    bench::keep(operation(distribution, index));
+                } catch (const exception&) {
+                }
+            });
+            bench::printLatency(cout, result);
+            results.push_back(result);
+        }
+    };
+
+    using Dist = Distribution;
+    run("Fraction(int,int)", [](const Dist& dist, size_t i) { return Fraction(dist.numerators[i], dist.denominators[i]); });
+    run("operator+", [](const Dist& dist, size_t i) { return dist.left[i] + dist.right[i]; });
+    run("operator-", [](const Dist& dist, size_t i) { return dist.left[i] - dist.right[i]; });
+    run("operator*", [](const Dist& dist, size_t i) { return dist.left[i] * dist.right[i]; });
+    run("operator/", [](const Dist& dist, size_t i) { return dist.left[i] / dist.right[i]; });
+    run("operator<", [](const Dist& dist, size_t i) { return dist.left[i] < dist.right[i]; });
+    run("operator==", [](const Dist& dist, size_t i) { return dist.left[i] == dist.right[i]; });
+
+    if (!jsonPath.empty()) {
+        ofstream file(jsonPath);
+        bench::writeLatencyJson(file, results);
+        cout << "wrote " << results.size() << " results to " << jsonPath << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * Times SimplexSolver on random scheduling-style LPs of the standard sizes
+ * (constraints x variables): 10x10, 20x20, 40x40 and 30x60. Each problem
+ * has resource rows (<=) with fractional coefficients, and a demand row (>=)
+ * so phase one always runs. Two cases per size:
+ *   cold solve     solve() from scratch
+ *   warm resolve   solve(basis) after a small change to the objective
+ *
+ * Usage: bench_simplex [--min-time ms] [--json out.json]
+ *                      [--compare baseline.json] [--threshold percent]
+ */
+
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Bench.hpp"
+#include "../sources/Simplex.hpp"
+
+using namespace std;
+using namespace ariel;
+
+namespace {
+
+    struct Problem {
+        string name;
+        SimplexSolver solver;
+        vector<Fraction> perturbed;  // the objective for the warm resolve
+    };
+
+    Problem makeProblem(size_t constraints, size_t variables, unsigned seed) {
+        mt19937 generator(seed);
+        uniform_int_distribution<int> profit(1, 20);
+        uniform_int_distribution<int> usage(0, 9);
+        uniform_int_distribution<int> divisor(1, 4);
+        uniform_int_distribution<int> capacity(50, 200);
+        vector<Fraction> objective;
+        vector<Fraction> perturbed;
+        for (size_t column = 0; column < variables; ++column) {
+            objective.push_back(Fraction(profit(generator), 1));
+            perturbed.push_back(objective.back() + Fraction(profit(generator), 10));
+        }
+        Problem problem{to_string(constraints) + "x" + to_string(variables), SimplexSolver(objective), perturbed};
+        for (size_t row = 0; row + 1 < constraints; ++row) {
+            vector<Fraction> coefficients;
+            for (size_t column = 0; column < variables; ++column) {
+                // every column uses some of the first resource, which keeps the problem bounded
+                int used = (row == 0) ? usage(generator) + 1 : usage(generator);
+                coefficients.push_back(Fraction(used, divisor(generator)));
+            }
+            problem.solver.addConstraint(coefficients, ConstraintKind::LessEqual, Fraction(capacity(generator), 1));
+        }
+        problem.solver.addConstraint(vector<Fraction>(variables, Fraction(1, 1)), ConstraintKind::GreaterEqual, Fraction(1, 1));
+        return problem;
+    }
+
+    // A solve takes milliseconds, too long for the ns/op and cycles/op columns of bench::printResult.
+    void printSolveHeader(ostream& outs) {
+        outs << left << setw(22) << "operation" << setw(15) << "input" << right << setw(12) << "ms/solve" << setw(12) << "solves/s"
+             << setw(16) << "Mcycles/solve" << "\n";
+    }
+
+    void printSolveResult(ostream& outs, const bench::Result& result) {
+        outs << left << setw(22) << result.name << setw(15) << result.input << right << fixed << setprecision(3)
+             << setw(12) << result.nsPerOp / 1e6 << setw(12) << result.opsPerSecond << setw(16) << result.cyclesPerOp / 1e6 << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    string jsonPath;
+    string baselinePath;
+    double threshold = 10;
+    for (int index = 1; index < argc; ++index) {
+        string argument = argv[index];
+        string value = (index + 1 < argc) ? argv[index + 1] : "";
+        if (argument == "--min-time") {
+            options.minMilliseconds = stod(value);
+        } else if (argument == "--json") {
+            jsonPath = value;
+        } else if (argument == "--compare") {
+            baselinePath = value;
+        } else if (argument == "--threshold") {
+            threshold = stod(value);
+        } else {
+            cerr << "usage: " << argv[0] << " [--min-time ms] [--json out.json] [--compare baseline.json] [--threshold percent]\n";
+            return 2;
+        }
+        ++index;
+    }
+
+    vector<bench::Result> baseline;
+    if (!baselinePath.empty()) {
+        try {
+            baseline = bench::readJson(baselinePath);
+        } catch (const exception& error) {
+            cerr << error.what() << "\n";
+            return 2;
+        }
+    }
+
+    vector<Problem> problems;
+    problems.push_back(makeProblem(10, 10, 1));
+    problems.push_back(makeProblem(20, 20, 2));
+    problems.push_back(makeProblem(40, 40, 3));
+    problems.push_back(makeProblem(30, 60, 4));
+
+    vector<bench::Result> results;
+    vector<string> pivotCounts;
+    printSolveHeader(cout);
+    for (Problem& problem : problems) {
+        SimplexResult cold = problem.solver.solve();
+        results.push_back(bench::measure("cold solve", problem.name, [&](uint64_t iterations) {
+            for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                bench::keep(problem.solver.solve().pivots);
+            }
+            return uint64_t(0);
+        }, options));
+        printSolveResult(cout, results.back());
+
+        SimplexSolver changed = problem.solver;
+        changed.setObjective(problem.perturbed);
+        SimplexResult warm = changed.solve(cold.basis);
+        SimplexResult recold = changed.solve();
+        results.push_back(bench::measure("warm resolve", problem.name, [&](uint64_t iterations) {
+            for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+                bench::keep(changed.solve(cold.basis).pivots);
+            }
+            return uint64_t(0);
+        }, options));
+        printSolveResult(cout, results.back());
+        if (warm.status != recold.status || warm.objective != recold.objective) {
+            cerr << problem.name << ": warm and cold optima differ\n";
+            return 1;
+        }
+        pivotCounts.push_back(problem.name + ": cold " + to_string(cold.pivots) + " pivots, warm resolve " + to_string(warm.pivots) +
+                              (warm.warmStarted ? "" : " (fell back)") + " vs " + to_string(recold.pivots) + " cold");
+    }
+    for (const string& line : pivotCounts) {
+        cout << line << "\n";
+    }
+
+    if (!jsonPath.empty()) {
+        ofstream file(jsonPath);
+        bench::writeJson(file, results);
+        cout << "wrote " << results.size() << " results to " << jsonPath << "\n";
+    }
+    if (!baselinePath.empty()) {
+        return bench::compare(results, baseline, threshold, cout) > 0 ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * Times comparison-heavy work on Fractions: std::sort by operator<, and a
+ * min/max scan. Build it twice, as bench_sort (members out of line in
+ * Fraction.cpp) and bench_sort_inline (ARIEL_FRACTION_HEADER_ONLY), and
+ * compare the two to see what inlining operator< and the getters is worth.
+ *
+ * Usage: bench_sort [count] [rounds]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../sources/Fraction.hpp"
+
+using namespace std;
+using namespace ariel;
+
+namespace {
+
+    // Numerators and denominators small enough that operator< never overflows.
+    vector<Fraction> makeFractions(size_t count) {
+        mt19937 generator(2024);
+        uniform_int_distribution<int> numerators(-30000, 30000);
+        uniform_int_distribution<int> denominators(1, 30000);
+        vector<Fraction> fractions;
+        fractions.reserve(count);
+        for (size_t index = 0; index < count; ++index) {
+            fractions.push_back(Fraction(numerators(generator), denominators(generator)));
+        }
+        return fractions;
+    }
+
+    template <typename Body>
+    double milliseconds(Body body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+}
+
+int main(int argc, char** argv) {
+    volatile long long observed = 0;  // keeps the timed loops from being optimized away
+    size_t count = (argc > 1) ? stoul(argv[1]) : 1000000;
+    int rounds = (argc > 2) ? stoi(argv[2]) : 5;
+#ifdef ARIEL_FRACTION_HEADER_ONLY
+    cout << "mode: header-only (inline)\n";
+#else
+    cout << "mode: out of line\n";
+#endif
+    const vector<Fraction> input = makeFractions(count);
+    double bestSort = 0;
+    double bestScan = 0;
+    for (int round = 0; round < rounds; ++round) {
+        vector<Fraction> fractions = input;
+        double sorting = milliseconds([&]() { sort(fractions.begin(), fractions.end()); });
+        observed = observed + fractions.front().getNumerator();
+
+        double scanning = milliseconds([&]() {
+            Fraction lowest = input.front();
+            Fraction highest = input.front();
+            for (const Fraction& fraction : input) {
+                if (fraction < lowest) {
+                    lowest = fraction;
+                }
+                if (fraction > highest) {
+                    highest = fraction;
+                }
+            }
+            observed = observed + lowest.getNumerator() + highest.getDenominator();
+        });
+        bestSort = (round == 0) ? sorting : min(bestSort, sorting);
+        bestScan = (round == 0) ? scanning : min(bestScan, scanning);
+    }
+    cout << fixed << setprecision(2);
+    cout << "sort    " << setw(10) << bestSort << " ms  (" << count << " fractions, best of " << rounds << ")\n";
+    cout << "min/max " << setw(10) << bestScan << " ms  (" << bestScan * 1e6 / static_cast<double>(2 * count) << " ns/compare)\n";
+    (void)observed;
+    return 0;
+}
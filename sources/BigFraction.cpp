@@ -0,0 +1,247 @@
+#include "BigFraction.hpp"   // Include header file
+#include <cmath>             // Include std::ldexp
+#include <limits>            // Include numeric limits
+#include <stdexcept>         // Include exception classes
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+/**
+ * @brief Create a BigFraction equal to 0/1.
+ */
+BigFraction::BigFraction() : numerator(0), denominator(1) {}
+
+/**
+ * @brief Create a BigFraction and reduce it.
+ * @param numerator The numerator of the fraction.
+ * @param denominator The denominator of the fraction.
+ * @throws invalid_argument If denominator is 0.
+ */
+BigFraction::BigFraction(const BigInt& numerator, const BigInt& denominator) : numerator(numerator), denominator(denominator) {
+    if (denominator.isZero()) {
+        throw std::invalid_argument("Denominator cannot be zero");
+    }
+    normalize();
+}
+
+/**
+ * @brief Create a BigFraction with the value of a Fraction.
+ * @param fraction The fraction to widen.
+ */
+BigFraction::BigFraction(const Fraction& fraction) : numerator(fraction.getNumerator()), denominator(fraction.getDenominator()) {
+    normalize();
+}
+
+/**
+ * @brief Create a BigFraction from terms that are already in lowest terms, skipping the gcd.
+ * @param numerator The numerator, coprime to the denominator.
+ * @param denominator The positive denominator.
+ * @return The fraction numerator/denominator as given.
+ */
+BigFraction BigFraction::fromReduced(const BigInt& numerator, const BigInt& denominator) {
+    BigFraction result;
+    result.numerator = numerator;
+    result.denominator = denominator;
+    return result;
+}
+
+/**
+ * @brief Reduce to lowest terms and move the sign to the numerator.
+ */
+void BigFraction::normalize() {
+    BigInt gcdValue = BigInt::gcd(numerator, denominator);
+    if (gcdValue != BigInt(1)) {
+        numerator = numerator / gcdValue;
+        denominator = denominator / gcdValue;
+    }
+    if (denominator.sign() < 0) {
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+}
+
+/**
+ * @brief Get the numerator of the fraction.
+ * @return The numerator of the fraction.
+ */
+const BigInt& BigFraction::getNumerator() const {
+    return numerator;
+}
+
+/**
+ * @brief Get the denominator of the fraction.
+ * @return The positive denominator of the fraction.
+ */
+const BigInt& BigFraction::getDenominator() const {
+    return denominator;
+}
+
+/**
+ * @brief Check whether the value can be stored in a Fraction.
+ * @return true if both terms fit in int, false otherwise.
+ */
+bool BigFraction::fitsFraction() const {
+    return numerator.fitsLongLong() && denominator.fitsLongLong() &&
+           numerator.toLongLong() >= numeric_limits<int>::min() && numerator.toLongLong() <= numeric_limits<int>::max() &&
+           denominator.toLongLong() <= numeric_limits<int>::max();
+}
+
+/**
+ * @brief Narrow to a Fraction.
+ * @return The same value as a Fraction.
+ * @throws overflow_error If a term does not fit in int.
+ */
+Fraction BigFraction::toFraction() const {
+    if (!fitsFraction()) {
+        throw std::overflow_error("BigFraction does not fit in a Fraction");
+    }
+    return Fraction::fromReduced(static_cast<int>(numerator.toLongLong()), static_cast<int>(denominator.toLongLong()));
+}
+
+/**
+ * @brief Convert to the nearest double, keeping precision when both terms are huge.
+ * @return The value as a double.
+ */
+double BigFraction::toDouble() const {
+    const size_t keep = 64;
+    size_t numeratorBits = numerator.bitLength();
+    size_t denominatorBits = denominator.bitLength();
+    if (numeratorBits <= 1000 && denominatorBits <= 1000) {
+        return numerator.toDouble() / denominator.toDouble();
+    }
+    // Scale so the quotient keeps 64 significant bits, then undo the scaling in the exponent.
+    long long scale = static_cast<long long>(denominatorBits) - static_cast<long long>(numeratorBits) + static_cast<long long>(keep);
+    BigInt scaled = (scale > 0) ? numerator.shiftedLeft(static_cast<size_t>(scale)) / denominator
+                                : numerator / denominator.shiftedLeft(static_cast<size_t>(-scale));
+    return ldexp(scaled.toDouble(), static_cast<int>(-scale));
+}
+
+/**
+ * @brief Format the fraction as "numerator/denominator".
+ * @return The formatted fraction.
+ */
+string BigFraction::toString() const {
+    return numerator.toString() + "/" + denominator.toString();
+}
+
+/**
+ * @brief Add two BigFractions.
+ * @param other The fraction to add.
+ * @return The reduced sum.
+ */
+BigFraction BigFraction::operator+(const BigFraction& other) const {
+    return BigFraction(numerator * other.denominator + other.numerator * denominator, denominator * other.denominator);
+}
+
+/**
+ * @brief Subtract two BigFractions.
+ * @param other The fraction to subtract.
+ * @return The reduced difference.
+ */
+BigFraction BigFraction::operator-(const BigFraction& other) const {
+    return BigFraction(numerator * other.denominator - other.numerator * denominator, denominator * other.denominator);
+}
+
+/**
+ * @brief Multiply two BigFractions, cancelling across before multiplying.
+ * @param other The fraction to multiply by.
+ * @return The reduced product.
+ */
+BigFraction BigFraction::operator*(const BigFraction& other) const {
+    BigInt first = BigInt::gcd(numerator, other.denominator);
+    BigInt second = BigInt::gcd(other.numerator, denominator);
+    if (first.isZero() || second.isZero()) {
+        return BigFraction();
+    }
+    BigFraction result;
+    result.numerator = (numerator / first) * (other.numerator / second);
+    result.denominator = (denominator / second) * (other.denominator / first);
+    return result;
+}
+
+/**
+ * @brief Divide two BigFractions.
+ * @param other The divisor.
+ * @return The reduced quotient.
+ * @throws runtime_error If other is zero.
+ */
+BigFraction BigFraction::operator/(const BigFraction& other) const {
+    if (other.numerator.isZero()) {
+        throw std::runtime_error("Cannot divide by zero");
+    }
+    return BigFraction(numerator * other.denominator, denominator * other.numerator);
+}
+
+/**
+ * @brief Negate the fraction.
+ * @return The fraction with its sign flipped.
+ */
+BigFraction BigFraction::operator-() const {
+    BigFraction result(*this);
+    result.numerator = -numerator;
+    return result;
+}
+
+/**
+ * @brief Check whether two BigFractions are equal; both are in lowest terms, so terms compare directly.
+ * @param other The fraction to compare with.
+ * @return true if the fractions are equal, false otherwise.
+ */
+bool BigFraction::operator==(const BigFraction& other) const {
+    return numerator == other.numerator && denominator == other.denominator;
+}
+
+/**
+ * @brief Check whether two BigFractions differ.
+ * @param other The fraction to compare with.
+ * @return true if the fractions differ, false otherwise.
+ */
+bool BigFraction::operator!=(const BigFraction& other) const {
+    return !(*this == other);
+}
+
+/**
+ * @brief Check whether this BigFraction is less than another.
+ * @param other The fraction to compare with.
+ * @return true if this fraction is smaller, false otherwise.
+ */
+bool BigFraction::operator<(const BigFraction& other) const {
+    return numerator * other.denominator < other.numerator * denominator;
+}
+
+/**
+ * @brief Check whether this BigFraction is greater than another.
+ * @param other The fraction to compare with.
+ * @return true if this fraction is larger, false otherwise.
+ */
+bool BigFraction::operator>(const BigFraction& other) const {
+    return other < *this;
+}
+
+/**
+ * @brief Check whether this BigFraction is less than or equal to another.
+ * @param other The fraction to compare with.
+ * @return true if this fraction is not larger, false otherwise.
+ */
+bool BigFraction::operator<=(const BigFraction& other) const {
+    return !(other < *this);
+}
+
+/**
+ * @brief Check whether this BigFraction is greater than or equal to another.
+ * @param other The fraction to compare with.
+ * @return true if this fraction is not smaller, false otherwise.
+ */
+bool BigFraction::operator>=(const BigFraction& other) const {
+    return !(*this < other);
+}
+
+/**
+ * @brief Print a BigFraction as "numerator/denominator".
+ * @param outs The output stream to write to.
+ * @param fraction The fraction to print.
+ * @return The output stream.
+ */
+std::ostream& ariel::operator<<(std::ostream& outs, const BigFraction& fraction) {
+    return outs << fraction.toString();
+}
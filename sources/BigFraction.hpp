@@ -0,0 +1,56 @@
+#ifndef BIGFRACTION_HPP
+#define BIGFRACTION_HPP
+
+#include "BigInt.hpp"
+#include "Fraction.hpp"
+#include <iostream>
+#include <string>
+
+namespace ariel {
+
+    // An exact fraction of two BigInts, always in lowest terms with a positive denominator.
+    class BigFraction {
+        private:
+            BigInt numerator;
+            BigInt denominator;
+            void normalize();
+
+        public:
+            // constructors
+            BigFraction();
+            BigFraction(const BigInt& numerator, const BigInt& denominator = BigInt(1));
+            BigFraction(const Fraction& fraction);
+            static BigFraction fromReduced(const BigInt& numerator, const BigInt& denominator);  // no gcd, no checks: caller supplies lowest terms, positive denominator
+
+            // getter functions
+            const BigInt& getNumerator() const;
+            const BigInt& getDenominator() const;
+
+            // conversion
+            bool fitsFraction() const;
+            Fraction toFraction() const;  // throws std::overflow_error unless fitsFraction()
+            double toDouble() const;
+            std::string toString() const;
+
+            // arithmetic operator overloading for BigFraction objects
+            BigFraction operator+(const BigFraction& other) const;
+            BigFraction operator-(const BigFraction& other) const;
+            BigFraction operator*(const BigFraction& other) const;
+            BigFraction operator/(const BigFraction& other) const;
+            BigFraction operator-() const;
+
+            // comparison operator overloading for BigFraction objects
+            bool operator==(const BigFraction& other) const;
+            bool operator!=(const BigFraction& other) const;
+            bool operator<(const BigFraction& other) const;
+            bool operator>(const BigFraction& other) const;
+            bool operator<=(const BigFraction& other) const;
+            bool operator>=(const BigFraction& other) const;
+
+            friend std::ostream& operator<<(std::ostream& outs, const BigFraction& fraction);
+    };
+
+    std::ostream& operator<<(std::ostream& outs, const BigFraction& fraction);
+}
+
+#endif /* BIGFRACTION_HPP */
@@ -0,0 +1,645 @@
+#include "BigInt.hpp"   // Include header file
+#include <algorithm>    // Include std::reverse
+#include <bit>          // Include std::countl_zero and std::bit_width
+#include <stdexcept>    // Include exception classes
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+
+    const uint64_t LIMB_BASE = uint64_t{1} << 32;
+    const uint32_t DECIMAL_CHUNK = 1000000000;  // nine digits per short division when printing
+    const int DECIMAL_CHUNK_DIGITS = 9;
+
+    vector<uint32_t> magnitudeOf(unsigned __int128 value) {
+        vector<uint32_t> limbs;
+        while (value != 0) {
+            limbs.push_back(static_cast<uint32_t>(value));
+            value >>= 32;
+        }
+        return limbs;
+    }
+
+    // Divide a magnitude in place by a single limb and return the remainder.
+    uint32_t divideBySmall(vector<uint32_t>& limbs, uint32_t divisor) {
+        uint64_t remainder = 0;
+        for (size_t index = limbs.size(); index-- > 0;) {
+            uint64_t current = (remainder << 32) | limbs[index];
+            limbs[index] = static_cast<uint32_t>(current / divisor);
+            remainder = current % divisor;
+        }
+        while (!limbs.empty() && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+        return static_cast<uint32_t>(remainder);
+    }
+}
+
+/**
+ * @brief Create a BigInt equal to zero.
+ */
+BigInt::BigInt() : negative(false) {}
+
+/**
+ * @brief Create a BigInt from a built-in integer.
+ * @param value The value.
+ */
+BigInt::BigInt(long long value) : negative(value < 0), limbs(magnitudeOf(value < 0 ? -static_cast<unsigned __int128>(value) : static_cast<unsigned __int128>(value))) {}
+
+/**
+ * @brief Create a BigInt from a 128-bit integer.
+ * @param value The value.
+ * @return The BigInt equal to value.
+ */
+BigInt BigInt::fromInt128(__int128 value) {
+    BigInt result;
+    result.negative = value < 0;
+    result.limbs = magnitudeOf(value < 0 ? -static_cast<unsigned __int128>(value) : static_cast<unsigned __int128>(value));
+    return result;
+}
+
+/**
+ * @brief Parse a decimal integer with an optional leading minus sign.
+ * @param digits The text to parse.
+ * @return The parsed value.
+ * @throws invalid_argument If digits is not a decimal integer.
+ */
+BigInt BigInt::fromString(const string& digits) {
+    size_t index = (!digits.empty() && digits[0] == '-') ? 1 : 0;
+    if (index == digits.size()) {
+        throw std::invalid_argument("Invalid integer: " + digits);
+    }
+    BigInt result;
+    for (; index < digits.size(); ++index) {
+        if (digits[index] < '0' || digits[index] > '9') {
+            throw std::invalid_argument("Invalid integer: " + digits);
+        }
+        result = result * BigInt(10) + BigInt(digits[index] - '0');
+    }
+    if (digits[0] == '-') {
+        result = -result;
+    }
+    return result;
+}
+
+/**
+ * @brief Drop leading zero limbs and clear the sign of zero.
+ */
+void BigInt::trim() {
+    while (!limbs.empty() && limbs.back() == 0) {
+        limbs.pop_back();
+    }
+    if (limbs.empty()) {
+        negative = false;
+    }
+}
+
+/**
+ * @brief Compare two magnitudes.
+ * @param left The first magnitude.
+ * @param right The second magnitude.
+ * @return -1, 0 or 1 as left is smaller than, equal to or larger than right.
+ */
+int BigInt::compareMagnitude(const vector<uint32_t>& left, const vector<uint32_t>& right) {
+    if (left.size() != right.size()) {
+        return left.size() < right.size() ? -1 : 1;
+    }
+    for (size_t index = left.size(); index-- > 0;) {
+        if (left[index] != right[index]) {
+            return left[index] < right[index] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Add two magnitudes.
+ * @param left The first magnitude.
+ * @param right The second magnitude.
+ * @return The sum.
+ */
+vector<uint32_t> BigInt::addMagnitude(const vector<uint32_t>& left, const vector<uint32_t>& right) {
+    const vector<uint32_t>& longer = left.size() >= right.size() ? left : right;
+    const vector<uint32_t>& shorter = left.size() >= right.size() ? right : left;
+    vector<uint32_t> sum(longer.size() + 1, 0);
+    uint64_t carry = 0;
+    for (size_t index = 0; index < longer.size(); ++index) {
+        uint64_t total = uint64_t{longer[index]} + (index < shorter.size() ? shorter[index] : 0) + carry;
+        sum[index] = static_cast<uint32_t>(total);
+        carry = total >> 32;
+    }
+    sum[longer.size()] = static_cast<uint32_t>(carry);
+    while (!sum.empty() && sum.back() == 0) {
+        sum.pop_back();
+    }
+    return sum;
+}
+
+/**
+ * @brief Subtract a magnitude from one at least as large.
+ * @param larger The minuend.
+ * @param smaller The subtrahend, no larger than larger.
+ * @return The difference.
+ */
+vector<uint32_t> BigInt::subtractMagnitude(const vector<uint32_t>& larger, const vector<uint32_t>& smaller) {
+    vector<uint32_t> difference(larger.size(), 0);
+    int64_t borrow = 0;
+    for (size_t index = 0; index < larger.size(); ++index) {
+        int64_t current = int64_t{larger[index]} - (index < smaller.size() ? smaller[index] : 0) - borrow;
+        borrow = current < 0 ? 1 : 0;
+        difference[index] = static_cast<uint32_t>(current + (borrow != 0 ? static_cast<int64_t>(LIMB_BASE) : 0));
+    }
+    while (!difference.empty() && difference.back() == 0) {
+        difference.pop_back();
+    }
+    return difference;
+}
+
+/**
+ * @brief Multiply two magnitudes with the schoolbook method.
+ * @param left The first magnitude.
+ * @param right The second magnitude.
+ * @return The product.
+ */
+vector<uint32_t> BigInt::multiplyMagnitude(const vector<uint32_t>& left, const vector<uint32_t>& right) {
+    if (left.empty() || right.empty()) {
+        return {};
+    }
+    vector<uint32_t> product(left.size() + right.size(), 0);
+    for (size_t outer = 0; outer < left.size(); ++outer) {
+        uint64_t carry = 0;
+        for (size_t inner = 0; inner < right.size(); ++inner) {
+            uint64_t current = uint64_t{left[outer]} * right[inner] + product[outer + inner] + carry;
+            product[outer + inner] = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        product[outer + right.size()] = static_cast<uint32_t>(carry);
+    }
+    while (!product.empty() && product.back() == 0) {
+        product.pop_back();
+    }
+    return product;
+}
+
+/**
+ * @brief Divide two magnitudes (Knuth's algorithm D).
+ * @param dividend The magnitude to divide.
+ * @param divisor The non-zero magnitude to divide by.
+ * @param quotient Receives the quotient.
+ * @param remainder Receives the remainder.
+ */
+void BigInt::divideMagnitude(const vector<uint32_t>& dividend, const vector<uint32_t>& divisor, vector<uint32_t>& quotient, vector<uint32_t>& remainder) {
+    if (compareMagnitude(dividend, divisor) < 0) {
+        quotient.clear();
+        remainder = dividend;
+        return;
+    }
+    if (divisor.size() == 1) {
+        quotient = dividend;
+        uint32_t rest = divideBySmall(quotient, divisor[0]);
+        remainder.assign(rest == 0 ? 0 : 1, rest);
+        return;
+    }
+
+    // Normalize so the top limb of the divisor has its high bit set.
+    const size_t divisorSize = divisor.size();
+    const size_t steps = dividend.size() - divisorSize;
+    const int shift = countl_zero(divisor.back());
+    vector<uint32_t> normalizedDivisor(divisorSize);
+    vector<uint32_t> normalizedDividend(dividend.size() + 1);
+    for (size_t index = divisorSize - 1; index > 0; --index) {
+        normalizedDivisor[index] = (divisor[index] << shift) | (shift == 0 ? 0 : static_cast<uint32_t>(uint64_t{divisor[index - 1]} >> (32 - shift)));
+    }
+    normalizedDivisor[0] = divisor[0] << shift;
+    normalizedDividend[dividend.size()] = (shift == 0) ? 0 : static_cast<uint32_t>(uint64_t{dividend.back()} >> (32 - shift));
+    for (size_t index = dividend.size() - 1; index > 0; --index) {
+        normalizedDividend[index] = (dividend[index] << shift) | (shift == 0 ? 0 : static_cast<uint32_t>(uint64_t{dividend[index - 1]} >> (32 - shift)));
+    }
+    normalizedDividend[0] = dividend[0] << shift;
+
+    quotient.assign(steps + 1, 0);
+    const uint64_t top = normalizedDivisor[divisorSize - 1];
+    const uint64_t second = normalizedDivisor[divisorSize - 2];
+    for (size_t step = steps + 1; step-- > 0;) {
+        // Estimate the quotient limb from the top two limbs, then correct it at most twice.
+        uint64_t numerator = (uint64_t{normalizedDividend[step + divisorSize]} << 32) | normalizedDividend[step + divisorSize - 1];
+        uint64_t estimate = numerator / top;
+        uint64_t rest = numerator % top;
+        while (estimate >= LIMB_BASE || estimate * second > ((rest << 32) | normalizedDividend[step + divisorSize - 2])) {
+            --estimate;
+            rest += top;
+            if (rest >= LIMB_BASE) {
+                break;
+            }
+        }
+
+        // Multiply and subtract.
+        int64_t borrow = 0;
+        uint64_t carry = 0;
+        for (size_t index = 0; index < divisorSize; ++index) {
+            uint64_t product = estimate * normalizedDivisor[index] + carry;
+            carry = product >> 32;
+            int64_t current = int64_t{normalizedDividend[index + step]} - static_cast<int64_t>(product & 0xFFFFFFFFU) - borrow;
+            borrow = current < 0 ? 1 : 0;
+            normalizedDividend[index + step] = static_cast<uint32_t>(current + (borrow != 0 ? static_cast<int64_t>(LIMB_BASE) : 0));
+        }
+        int64_t current = int64_t{normalizedDividend[step + divisorSize]} - static_cast<int64_t>(carry) - borrow;
+        normalizedDividend[step + divisorSize] = static_cast<uint32_t>(current);
+
+        // The estimate was one too large: add the divisor back.
+        if (current < 0) {
+            --estimate;
+            uint64_t addCarry = 0;
+            for (size_t index = 0; index < divisorSize; ++index) {
+                uint64_t total = uint64_t{normalizedDividend[index + step]} + normalizedDivisor[index] + addCarry;
+                normalizedDividend[index + step] = static_cast<uint32_t>(total);
+                addCarry = total >> 32;
+            }
+            normalizedDividend[step + divisorSize] += static_cast<uint32_t>(addCarry);
+        }
+        quotient[step] = static_cast<uint32_t>(estimate);
+    }
+    while (!quotient.empty() && quotient.back() == 0) {
+        quotient.pop_back();
+    }
+
+    // Undo the normalization on the remainder.
+    remainder.assign(divisorSize, 0);
+    for (size_t index = 0; index < divisorSize; ++index) {
+        remainder[index] = (normalizedDividend[index] >> shift) |
+                           (shift == 0 ? 0 : static_cast<uint32_t>(uint64_t{normalizedDividend[index + 1]} << (32 - shift)));
+    }
+    while (!remainder.empty() && remainder.back() == 0) {
+        remainder.pop_back();
+    }
+}
+
+/**
+ * @brief Check whether the value is zero.
+ * @return true if the value is zero, false otherwise.
+ */
+bool BigInt::isZero() const {
+    return limbs.empty();
+}
+
+/**
+ * @brief Get the sign of the value.
+ * @return -1 for negative values, 0 for zero, 1 for positive values.
+ */
+int BigInt::sign() const {
+    return limbs.empty() ? 0 : (negative ? -1 : 1);
+}
+
+/**
+ * @brief Check whether the value is even.
+ * @return true if the value is divisible by two, false otherwise.
+ */
+bool BigInt::isEven() const {
+    return limbs.empty() || (limbs[0] & 1U) == 0;
+}
+
+/**
+ * @brief Get the number of bits needed for the magnitude.
+ * @return The position of the highest set bit plus one, or 0 for zero.
+ */
+size_t BigInt::bitLength() const {
+    return limbs.empty() ? 0 : (limbs.size() - 1) * 32 + static_cast<size_t>(bit_width(limbs.back()));
+}
+
+/**
+ * @brief Check whether the value fits in a long long.
+ * @return true if toLongLong() is exact, false otherwise.
+ */
+bool BigInt::fitsLongLong() const {
+    __int128 value = 0;
+    return toInt128(value) && value >= INT64_MIN && value <= INT64_MAX;
+}
+
+/**
+ * @brief Convert the value to a long long.
+ * @return The value; meaningless unless fitsLongLong() is true.
+ */
+long long BigInt::toLongLong() const {
+    __int128 value = 0;
+    toInt128(value);
+    return static_cast<long long>(value);
+}
+
+/**
+ * @brief Convert the value to a 128-bit integer if it fits.
+ * @param value Receives the value.
+ * @return true if the value fits in __int128, false otherwise.
+ */
+bool BigInt::toInt128(__int128& value) const {
+    if (limbs.size() > 4) {
+        return false;
+    }
+    unsigned __int128 magnitude = 0;
+    for (size_t index = limbs.size(); index-- > 0;) {
+        magnitude = (magnitude << 32) | limbs[index];
+    }
+    const unsigned __int128 limit = static_cast<unsigned __int128>(1) << 127;
+    if (magnitude > limit || (magnitude == limit && !negative)) {
+        return false;
+    }
+    value = static_cast<__int128>(negative ? ~magnitude + 1 : magnitude);
+    return true;
+}
+
+/**
+ * @brief Convert the value to the nearest double.
+ * @return The value as a double, or infinity if it is too large.
+ */
+double BigInt::toDouble() const {
+    double result = 0;
+    for (size_t index = limbs.size(); index-- > 0;) {
+        result = result * static_cast<double>(LIMB_BASE) + limbs[index];
+    }
+    return negative ? -result : result;
+}
+
+/**
+ * @brief Format the value in decimal.
+ * @return The decimal digits, with a leading minus sign for negative values.
+ */
+string BigInt::toString() const {
+    if (limbs.empty()) {
+        return "0";
+    }
+    vector<uint32_t> rest = limbs;
+    string digits;
+    while (!rest.empty()) {
+        uint32_t chunk = divideBySmall(rest, DECIMAL_CHUNK);
+        for (int digit = 0; digit < DECIMAL_CHUNK_DIGITS && (chunk != 0 || !rest.empty()); ++digit) {
+            digits.push_back(static_cast<char>('0' + chunk % 10));
+            chunk /= 10;
+        }
+    }
+    if (negative) {
+        digits.push_back('-');
+    }
+    reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+/**
+ * @brief Negate the value.
+ * @return The value with its sign flipped.
+ */
+BigInt BigInt::operator-() const {
+    BigInt result(*this);
+    result.negative = !negative;
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Add two BigInts.
+ * @param other The value to add.
+ * @return The sum.
+ */
+BigInt BigInt::operator+(const BigInt& other) const {
+    BigInt result;
+    if (negative == other.negative) {
+        result.limbs = addMagnitude(limbs, other.limbs);
+        result.negative = negative;
+    } else if (compareMagnitude(limbs, other.limbs) >= 0) {
+        result.limbs = subtractMagnitude(limbs, other.limbs);
+        result.negative = negative;
+    } else {
+        result.limbs = subtractMagnitude(other.limbs, limbs);
+        result.negative = other.negative;
+    }
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Subtract two BigInts.
+ * @param other The value to subtract.
+ * @return The difference.
+ */
+BigInt BigInt::operator-(const BigInt& other) const {
+    return *this + (-other);
+}
+
+/**
+ * @brief Multiply two BigInts.
+ * @param other The value to multiply by.
+ * @return The product.
+ */
+BigInt BigInt::operator*(const BigInt& other) const {
+    BigInt result;
+    result.limbs = multiplyMagnitude(limbs, other.limbs);
+    result.negative = negative != other.negative;
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Divide two BigInts, truncating toward zero.
+ * @param other The divisor.
+ * @return The quotient.
+ * @throws runtime_error If other is zero.
+ */
+BigInt BigInt::operator/(const BigInt& other) const {
+    BigInt quotient;
+    BigInt remainder;
+    divmod(*this, other, quotient, remainder);
+    return quotient;
+}
+
+/**
+ * @brief Get the remainder of truncating division.
+ * @param other The divisor.
+ * @return The remainder, with the sign of this value.
+ * @throws runtime_error If other is zero.
+ */
+BigInt BigInt::operator%(const BigInt& other) const {
+    BigInt quotient;
+    BigInt remainder;
+    divmod(*this, other, quotient, remainder);
+    return remainder;
+}
+
+/**
+ * @brief Add a BigInt to this one.
+ * @param other The value to add.
+ * @return This value.
+ */
+BigInt& BigInt::operator+=(const BigInt& other) {
+    *this = *this + other;
+    return *this;
+}
+
+/**
+ * @brief Subtract a BigInt from this one.
+ * @param other The value to subtract.
+ * @return This value.
+ */
+BigInt& BigInt::operator-=(const BigInt& other) {
+    *this = *this - other;
+    return *this;
+}
+
+/**
+ * @brief Multiply this BigInt by another.
+ * @param other The value to multiply by.
+ * @return This value.
+ */
+BigInt& BigInt::operator*=(const BigInt& other) {
+    *this = *this * other;
+    return *this;
+}
+
+/**
+ * @brief Multiply by a power of two.
+ * @param bits The power of two.
+ * @return The value times 2^bits.
+ */
+BigInt BigInt::shiftedLeft(size_t bits) const {
+    if (limbs.empty()) {
+        return *this;
+    }
+    BigInt result;
+    result.negative = negative;
+    result.limbs.assign(bits / 32, 0);
+    const unsigned shift = static_cast<unsigned>(bits % 32);
+    uint32_t carry = 0;
+    for (uint32_t limb : limbs) {
+        result.limbs.push_back((limb << shift) | carry);
+        carry = (shift == 0) ? 0 : static_cast<uint32_t>(uint64_t{limb} >> (32 - shift));
+    }
+    result.limbs.push_back(carry);
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Divide with truncation toward zero, producing quotient and remainder together.
+ * @param dividend The value to divide.
+ * @param divisor The value to divide by.
+ * @param quotient Receives the quotient.
+ * @param remainder Receives the remainder, with the sign of dividend.
+ * @throws runtime_error If divisor is zero.
+ */
+void BigInt::divmod(const BigInt& dividend, const BigInt& divisor, BigInt& quotient, BigInt& remainder) {
+    if (divisor.isZero()) {
+        throw std::runtime_error("Cannot divide by zero");
+    }
+    vector<uint32_t> quotientLimbs;
+    vector<uint32_t> remainderLimbs;
+    divideMagnitude(dividend.limbs, divisor.limbs, quotientLimbs, remainderLimbs);
+    quotient.limbs = std::move(quotientLimbs);
+    quotient.negative = dividend.negative != divisor.negative;
+    quotient.trim();
+    remainder.limbs = std::move(remainderLimbs);
+    remainder.negative = dividend.negative;
+    remainder.trim();
+}
+
+/**
+ * @brief Calculates the greatest common divisor with Euclid's algorithm.
+ * @param first The first value.
+ * @param second The second value.
+ * @return The non-negative greatest common divisor; gcd(0, 0) is 0.
+ */
+BigInt BigInt::gcd(BigInt first, BigInt second) {
+    first.negative = false;
+    second.negative = false;
+    while (!second.isZero()) {
+        __int128 small1 = 0;
+        __int128 small2 = 0;
+        if (first.toInt128(small1) && second.toInt128(small2)) {
+            while (small2 != 0) {
+                __int128 rest = small1 % small2;
+                small1 = small2;
+                small2 = rest;
+            }
+            return fromInt128(small1);
+        }
+        BigInt rest = first % second;
+        first = std::move(second);
+        second = std::move(rest);
+    }
+    return first;
+}
+
+/**
+ * @brief Get the absolute value.
+ * @return The value without its sign.
+ */
+BigInt BigInt::abs() const {
+    BigInt result(*this);
+    result.negative = false;
+    return result;
+}
+
+/**
+ * @brief Check whether two BigInts are equal.
+ * @param other The value to compare with.
+ * @return true if the values are equal, false otherwise.
+ */
+bool BigInt::operator==(const BigInt& other) const {
+    return negative == other.negative && limbs == other.limbs;
+}
+
+/**
+ * @brief Check whether two BigInts differ.
+ * @param other The value to compare with.
+ * @return true if the values differ, false otherwise.
+ */
+bool BigInt::operator!=(const BigInt& other) const {
+    return !(*this == other);
+}
+
+/**
+ * @brief Check whether this BigInt is less than another.
+ * @param other The value to compare with.
+ * @return true if this value is smaller, false otherwise.
+ */
+bool BigInt::operator<(const BigInt& other) const {
+    if (negative != other.negative) {
+        return negative;
+    }
+    int order = compareMagnitude(limbs, other.limbs);
+    return negative ? order > 0 : order < 0;
+}
+
+/**
+ * @brief Check whether this BigInt is greater than another.
+ * @param other The value to compare with.
+ * @return true if this value is larger, false otherwise.
+ */
+bool BigInt::operator>(const BigInt& other) const {
+    return other < *this;
+}
+
+/**
+ * @brief Check whether this BigInt is less than or equal to another.
+ * @param other The value to compare with.
+ * @return true if this value is not larger, false otherwise.
+ */
+bool BigInt::operator<=(const BigInt& other) const {
+    return !(other < *this);
+}
+
+/**
+ * @brief Check whether this BigInt is greater than or equal to another.
+ * @param other The value to compare with.
+ * @return true if this value is not smaller, false otherwise.
+ */
+bool BigInt::operator>=(const BigInt& other) const {
+    return !(*this < other);
+}
+
+/**
+ * @brief Print a BigInt in decimal.
+ * @param outs The output stream to write to.
+ * @param value The value to print.
+ * @return The output stream.
+ */
+std::ostream& ariel::operator<<(std::ostream& outs, const BigInt& value) {
+    return outs << value.toString();
+}
@@ -0,0 +1,71 @@
+#ifndef BIGINT_HPP
+#define BIGINT_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ariel {
+
+    // An arbitrary-precision signed integer: a sign and a little-endian vector of 32-bit limbs.
+    class BigInt {
+        private:
+            bool negative;
+            std::vector<std::uint32_t> limbs;  // magnitude without leading zero limbs; empty for zero
+            void trim();
+            static int compareMagnitude(const std::vector<std::uint32_t>& left, const std::vector<std::uint32_t>& right);
+            static std::vector<std::uint32_t> addMagnitude(const std::vector<std::uint32_t>& left, const std::vector<std::uint32_t>& right);
+            static std::vector<std::uint32_t> subtractMagnitude(const std::vector<std::uint32_t>& larger, const std::vector<std::uint32_t>& smaller);
+            static std::vector<std::uint32_t> multiplyMagnitude(const std::vector<std::uint32_t>& left, const std::vector<std::uint32_t>& right);
+            static void divideMagnitude(const std::vector<std::uint32_t>& dividend, const std::vector<std::uint32_t>& divisor,
+                                        std::vector<std::uint32_t>& quotient, std::vector<std::uint32_t>& remainder);
+
+        public:
+            // constructors
+            BigInt();
+            BigInt(long long value);
+            static BigInt fromInt128(__int128 value);
+            static BigInt fromString(const std::string& digits);
+
+            // inspection
+            bool isZero() const;
+            int sign() const;  // -1, 0 or 1
+            bool isEven() const;
+            std::size_t bitLength() const;  // of the magnitude
+            bool fitsLongLong() const;
+            long long toLongLong() const;  // only meaningful when fitsLongLong()
+            bool toInt128(__int128& value) const;  // false if it does not fit
+            double toDouble() const;
+            std::string toString() const;
+
+            // arithmetic; division truncates toward zero like the built-in operators
+            BigInt operator-() const;
+            BigInt operator+(const BigInt& other) const;
+            BigInt operator-(const BigInt& other) const;
+            BigInt operator*(const BigInt& other) const;
+            BigInt operator/(const BigInt& other) const;
+            BigInt operator%(const BigInt& other) const;
+            BigInt& operator+=(const BigInt& other);
+            BigInt& operator-=(const BigInt& other);
+            BigInt& operator*=(const BigInt& other);
+            BigInt shiftedLeft(std::size_t bits) const;
+            static void divmod(const BigInt& dividend, const BigInt& divisor, BigInt& quotient, BigInt& remainder);
+            static BigInt gcd(BigInt first, BigInt second);  // always non-negative
+            BigInt abs() const;
+
+            // comparison
+            bool operator==(const BigInt& other) const;
+            bool operator!=(const BigInt& other) const;
+            bool operator<(const BigInt& other) const;
+            bool operator>(const BigInt& other) const;
+            bool operator<=(const BigInt& other) const;
+            bool operator>=(const BigInt& other) const;
+
+            friend std::ostream& operator<<(std::ostream& outs, const BigInt& value);
+    };
+
+    std::ostream& operator<<(std::ostream& outs, const BigInt& value);
+}
+
+#endif /* BIGINT_HPP */
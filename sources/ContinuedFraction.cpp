@@ -0,0 +1,290 @@
+#include "ContinuedFraction.hpp"   // Include header file
+#include <algorithm>               // Include std::min
+#include <numeric>                 // Include std::gcd
+#include <stdexcept>               // Include exception classes
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+static_assert(ranges::input_range<ContinuedFraction> && ranges::view<ContinuedFraction>);
+static_assert(ranges::input_range<Convergents> && ranges::view<Convergents>);
+
+/**
+ * @brief Create the end iterator.
+ */
+ContinuedFraction::iterator::iterator() : numerator(0), denominator(0), term(0) {}
+
+/**
+ * @brief Start expanding numerator/denominator; the first term is the floor of the value.
+ * @param numerator The numerator.
+ * @param denominator The denominator, already positive.
+ */
+ContinuedFraction::iterator::iterator(long long numerator, long long denominator) : numerator(numerator), denominator(denominator), term(0) {
+    term = numerator / denominator;
+    if (numerator % denominator < 0) {
+        --term;
+    }
+}
+
+/**
+ * @brief Get the current partial quotient.
+ * @return The current term.
+ */
+long long ContinuedFraction::iterator::operator*() const {
+    return term;
+}
+
+/**
+ * @brief Move to the next partial quotient with one divmod step.
+ * @return This iterator.
+ */
+ContinuedFraction::iterator& ContinuedFraction::iterator::operator++() {
+    long long rest = numerator - term * denominator;  // in [0, denominator) after the floor
+    numerator = denominator;
+    denominator = rest;
+    if (denominator != 0) {
+        term = numerator / denominator;
+    }
+    return *this;
+}
+
+/**
+ * @brief Move to the next partial quotient.
+ */
+void ContinuedFraction::iterator::operator++(int) {
+    ++*this;
+}
+
+/**
+ * @brief Check whether every term has been produced.
+ * @return true at the end of the expansion, false otherwise.
+ */
+bool ContinuedFraction::iterator::operator==(default_sentinel_t) const {
+    return denominator == 0;
+}
+
+/**
+ * @brief Expand a Fraction.
+ * @param fraction The fraction to expand.
+ */
+ContinuedFraction::ContinuedFraction(const Fraction& fraction) : numerator(fraction.getNumerator()), denominator(fraction.getDenominator()) {}
+
+/**
+ * @brief Expand numerator/denominator, which need not be in lowest terms.
+ * @param numerator The numerator.
+ * @param denominator The denominator.
+ * @throws invalid_argument If the denominator is zero.
+ * @throws overflow_error If a negative denominator cannot be moved to the numerator.
+ */
+ContinuedFraction::ContinuedFraction(long long numerator, long long denominator) : numerator(numerator), denominator(denominator) {
+    if (denominator == 0) {
+        throw invalid_argument("Denominator cannot be zero");
+    }
+    if (denominator < 0) {
+        if (numerator == numeric_limits<long long>::min() || denominator == numeric_limits<long long>::min()) {
+            throw overflow_error("Normalizing the sign would result in integer overflow!");
+        }
+        this->numerator = -numerator;
+        this->denominator = -denominator;
+    }
+}
+
+/**
+ * @brief Get an iterator at the first partial quotient.
+ * @return The begin iterator.
+ */
+ContinuedFraction::iterator ContinuedFraction::begin() const {
+    return iterator(numerator, denominator);
+}
+
+/**
+ * @brief Get the end sentinel.
+ * @return The end sentinel.
+ */
+default_sentinel_t ContinuedFraction::end() const {
+    return default_sentinel;
+}
+
+/**
+ * @brief Create the end iterator.
+ */
+Convergents::iterator::iterator()
+    : numerator(0), previousNumerator(1), denominator(1), previousDenominator(0), maxDenominator(0), done(true) {}
+
+/**
+ * @brief Start at the first convergent a0/1.
+ * @param fraction The fraction to approximate.
+ * @param maxDenominator The largest denominator to produce.
+ */
+Convergents::iterator::iterator(const Fraction& fraction, int maxDenominator)
+    : terms(fraction.getNumerator(), fraction.getDenominator()), numerator(*terms), previousNumerator(1), denominator(1), previousDenominator(0),
+      maxDenominator(maxDenominator), done(false) {}
+
+/**
+ * @brief Get the current convergent. Convergents are always in lowest terms, so no gcd is needed.
+ * @return The current convergent.
+ */
+Fraction Convergents::iterator::operator*() const {
+    return Fraction::fromReduced(static_cast<int>(numerator), static_cast<int>(denominator));
+}
+
+/**
+ * @brief Get the partial quotient that produced the current convergent.
+ * @return The current term.
+ */
+long long Convergents::iterator::term() const {
+    return *terms;
+}
+
+/**
+ * @brief Move to the next convergent: h(n+1) = a(n+1) h(n) + h(n-1), and the same for k.
+ * @return This iterator.
+ */
+Convergents::iterator& Convergents::iterator::operator++() {
+    ++terms;
+    if (terms == default_sentinel) {
+        done = true;
+        return *this;
+    }
+    long long nextDenominator = *terms * denominator + previousDenominator;
+    if (nextDenominator > maxDenominator) {
+        done = true;
+        return *this;
+    }
+    long long nextNumerator = *terms * numerator + previousNumerator;
+    previousNumerator = numerator;
+    numerator = nextNumerator;
+    previousDenominator = denominator;
+    denominator = nextDenominator;
+    return *this;
+}
+
+/**
+ * @brief Move to the next convergent.
+ */
+void Convergents::iterator::operator++(int) {
+    ++*this;
+}
+
+/**
+ * @brief Check whether the expansion ended or hit the denominator bound.
+ * @return true at the end, false otherwise.
+ */
+bool Convergents::iterator::operator==(default_sentinel_t) const {
+    return done;
+}
+
+/**
+ * @brief List the convergents of a fraction.
+ * @param fraction The fraction to approximate.
+ * @param maxDenominator Stop before the first convergent whose denominator exceeds this.
+ * @throws invalid_argument If maxDenominator is less than 1.
+ */
+Convergents::Convergents(const Fraction& fraction, int maxDenominator)
+    : numerator(fraction.getNumerator()), denominator(fraction.getDenominator()), maxDenominator(maxDenominator) {
+    if (maxDenominator < 1) {
+        throw invalid_argument("Maximum denominator must be at least 1");
+    }
+}
+
+/**
+ * @brief Get an iterator at the first convergent.
+ * @return The begin iterator.
+ */
+Convergents::iterator Convergents::begin() const {
+    return iterator(Fraction::fromReduced(numerator, denominator), maxDenominator);
+}
+
+/**
+ * @brief Get the end sentinel.
+ * @return The end sentinel.
+ */
+default_sentinel_t Convergents::end() const {
+    return default_sentinel;
+}
+
+/**
+ * @brief Find the closest fraction with a bounded denominator. The answer is either the last
+ * convergent within the bound or the largest semiconvergent that follows it.
+ * @param fraction The fraction to approximate.
+ * @param maxDenominator The largest allowed denominator.
+ * @return The best approximation.
+ * @throws invalid_argument If maxDenominator is less than 1.
+ */
+Fraction ariel::limit_denominator(const Fraction& fraction, int maxDenominator) {
+    if (maxDenominator < 1) {
+        throw invalid_argument("Maximum denominator must be at least 1");
+    }
+    // A fraction's convergents never have a larger numerator than the fraction itself, so the numerator bound never binds.
+    return limit_terms(fraction.getNumerator(), fraction.getDenominator(), numeric_limits<int>::max(), maxDenominator);
+}
+
+/**
+ * @brief Find the closest fraction whose numerator and denominator are both bounded. Numerators and
+ * denominators of the convergents grow together, so as in limit_denominator the answer is either the
+ * last convergent within both bounds or the largest semiconvergent that follows it.
+ * @param numerator The numerator of the value to approximate.
+ * @param denominator The denominator of the value, which need not be in lowest terms.
+ * @param maxNumerator The largest allowed numerator magnitude.
+ * @param maxDenominator The largest allowed denominator.
+ * @return The best approximation; +-maxNumerator/1 if the value is at least that large in magnitude.
+ * @throws invalid_argument If a bound is less than 1 or the denominator is not positive.
+ */
+Fraction ariel::limit_terms(long long numerator, long long denominator, int maxNumerator, int maxDenominator) {
+    if (maxNumerator < 1 || maxDenominator < 1) {
+        throw invalid_argument("Maximum numerator and denominator must be at least 1");
+    }
+    if (denominator <= 0) {
+        throw invalid_argument("Denominator must be positive");
+    }
+    bool negative = numerator < 0;
+    unsigned long long p = negative ? 0 - static_cast<unsigned long long>(numerator) : static_cast<unsigned long long>(numerator);
+    auto q = static_cast<unsigned long long>(denominator);
+    unsigned long long divisor = gcd(p, q);
+    p /= divisor;
+    q /= divisor;
+    auto sign = [negative](long long value) { return static_cast<int>(negative ? -value : value); };
+    if (p / q >= static_cast<unsigned long long>(maxNumerator)) {
+        return Fraction::fromReduced(sign(maxNumerator), 1);
+    }
+    if (p <= static_cast<unsigned long long>(maxNumerator) && q <= static_cast<unsigned long long>(maxDenominator)) {
+        return Fraction::fromReduced(sign(static_cast<long long>(p)), static_cast<int>(q));
+    }
+
+    // Expand p/q by Euclid's divmod; it does not end before a bound is passed, since p/q itself is out of bounds.
+    unsigned long long rest = p % q;
+    unsigned long long remainder = q;
+    long long convergentNumerator = static_cast<long long>(p / q), previousNumerator = 1;
+    long long convergentDenominator = 1, previousDenominator = 0;
+    while (true) {
+        unsigned long long term = remainder / rest;
+        unsigned __int128 nextNumerator = static_cast<unsigned __int128>(term) * static_cast<unsigned long long>(convergentNumerator) + static_cast<unsigned long long>(previousNumerator);
+        unsigned __int128 nextDenominator = static_cast<unsigned __int128>(term) * static_cast<unsigned long long>(convergentDenominator) + static_cast<unsigned long long>(previousDenominator);
+        if (nextNumerator > static_cast<unsigned>(maxNumerator) || nextDenominator > static_cast<unsigned>(maxDenominator)) {
+            break;
+        }
+        previousNumerator = convergentNumerator;
+        convergentNumerator = static_cast<long long>(nextNumerator);
+        previousDenominator = convergentDenominator;
+        convergentDenominator = static_cast<long long>(nextDenominator);
+        unsigned long long next = remainder % rest;
+        remainder = rest;
+        rest = next;
+    }
+    long long steps = (maxDenominator - previousDenominator) / convergentDenominator;
+    if (convergentNumerator != 0) {
+        steps = min(steps, (maxNumerator - previousNumerator) / convergentNumerator);
+    }
+    long long semiNumerator = previousNumerator + steps * convergentNumerator;
+    long long semiDenominator = previousDenominator + steps * convergentDenominator;
+
+    // Compare |x - h/k| with |x - s/t| as |p k - h q| t against |p t - s q| k.
+    __int128 convergentGap = static_cast<__int128>(p) * convergentDenominator - static_cast<__int128>(convergentNumerator) * q;
+    __int128 semiGap = static_cast<__int128>(p) * semiDenominator - static_cast<__int128>(semiNumerator) * q;
+    convergentGap = convergentGap < 0 ? -convergentGap : convergentGap;
+    semiGap = semiGap < 0 ? -semiGap : semiGap;
+    if (semiGap * convergentDenominator < convergentGap * semiDenominator) {
+        return Fraction::fromReduced(sign(semiNumerator), static_cast<int>(semiDenominator));
+    }
+    return Fraction::fromReduced(sign(convergentNumerator), static_cast<int>(convergentDenominator));
+}
@@ -0,0 +1,95 @@
+#ifndef CONTINUEDFRACTION_HPP
+#define CONTINUEDFRACTION_HPP
+
+#include "Fraction.hpp"
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <ranges>
+
+namespace ariel {
+
+    // The partial quotients [a0; a1, a2, ...] of numerator/denominator, produced lazily by
+    // Euclid's divmod. a0 is the floor of the value, so it is negative for negative fractions.
+    class ContinuedFraction : public std::ranges::view_interface<ContinuedFraction> {
+        private:
+            long long numerator;
+            long long denominator;
+
+        public:
+            class iterator {
+                private:
+                    long long numerator;    // the remainder pair still to expand
+                    long long denominator;  // 0 once every term has been produced
+                    long long term;
+
+                public:
+                    using iterator_concept = std::input_iterator_tag;
+                    using value_type = long long;
+                    using difference_type = std::ptrdiff_t;
+
+                    iterator();
+                    iterator(long long numerator, long long denominator);
+                    long long operator*() const;
+                    iterator& operator++();
+                    void operator++(int);
+                    bool operator==(std::default_sentinel_t) const;
+            };
+
+            // constructors
+            explicit ContinuedFraction(const Fraction& fraction);
+            ContinuedFraction(long long numerator, long long denominator);
+
+            // range access
+            iterator begin() const;
+            std::default_sentinel_t end() const;
+    };
+
+    // The convergents h0/k0, h1/k1, ... of a fraction, each already in lowest terms. The last one
+    // is the fraction itself, unless the next denominator would exceed maxDenominator.
+    class Convergents : public std::ranges::view_interface<Convergents> {
+        private:
+            int numerator;
+            int denominator;
+            int maxDenominator;
+
+        public:
+            class iterator {
+                private:
+                    ContinuedFraction::iterator terms;
+                    long long numerator, previousNumerator;      // h(n), h(n-1)
+                    long long denominator, previousDenominator;  // k(n), k(n-1)
+                    long long maxDenominator;
+                    bool done;
+
+                public:
+                    using iterator_concept = std::input_iterator_tag;
+                    using value_type = Fraction;
+                    using difference_type = std::ptrdiff_t;
+
+                    iterator();
+                    iterator(const Fraction& fraction, int maxDenominator);
+                    Fraction operator*() const;
+                    long long term() const;  // the partial quotient that produced this convergent
+                    iterator& operator++();
+                    void operator++(int);
+                    bool operator==(std::default_sentinel_t) const;
+            };
+
+            // constructors
+            explicit Convergents(const Fraction& fraction, int maxDenominator = std::numeric_limits<int>::max());
+
+            // range access
+            iterator begin() const;
+            std::default_sentinel_t end() const;
+    };
+
+    // The fraction closest to the given one whose denominator is at most maxDenominator.
+    Fraction limit_denominator(const Fraction& fraction, int maxDenominator);
+
+    // The fraction closest to numerator/denominator (denominator > 0) whose numerator is at most maxNumerator
+    // and whose denominator is at most maxDenominator in magnitude.
+    Fraction limit_terms(long long numerator, long long denominator, int maxNumerator, int maxDenominator);
+}
+
+#endif /* CONTINUEDFRACTION_HPP */
@@ -0,0 +1,409 @@
+#include "DynFraction.hpp"      // Include header file
+#include "FractionDetail.hpp"   // Include detail::gcdWide
+#include <algorithm>            // Include std::max
+#include <bit>                  // Include std::bit_width
+#include <cstdlib>              // Include std::llabs
+#include <limits>               // Include numeric limits
+#include <numeric>              // Include std::gcd
+#include <stdexcept>            // Include exception classes
+#include <utility>              // Include std::swap
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+    bool fitsInt(long long value) {
+        return value >= numeric_limits<int32_t>::min() && value <= numeric_limits<int32_t>::max();
+    }
+
+    bool fitsInt64(__int128 value) {
+        return value >= numeric_limits<int64_t>::min() && value <= numeric_limits<int64_t>::max();
+    }
+
+    // base^exponent by squaring.
+    BigInt power(BigInt base, unsigned long long exponent) {
+        BigInt result(1);
+        for (; exponent != 0; exponent >>= 1) {
+            if ((exponent & 1) != 0) {
+                result *= base;
+            }
+            if (exponent > 1) {
+                base *= base;
+            }
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Create a DynFraction equal to 0/1.
+ */
+DynFraction::DynFraction() : storage(FractionStorage::Small), small{0, 1} {}
+
+/**
+ * @brief Create a DynFraction from two integers, reducing it.
+ * @param numerator The numerator of the fraction.
+ * @param denominator The denominator of the fraction.
+ * @throws invalid_argument If denominator is 0.
+ */
+DynFraction::DynFraction(long long numerator, long long denominator) : DynFraction() {
+    if (denominator == 0) {
+        throw std::invalid_argument("Denominator cannot be zero");
+    }
+    *this = fromWide(numerator, denominator);
+}
+
+/**
+ * @brief Create a DynFraction with the value of a Fraction.
+ * @param fraction The fraction to copy; it is already reduced.
+ */
+DynFraction::DynFraction(const Fraction& fraction) : storage(FractionStorage::Small), small{fraction.getNumerator(), fraction.getDenominator()} {
+    if (small.denominator < 0) {
+        *this = fromWide(small.numerator, small.denominator);
+    }
+}
+
+/**
+ * @brief Create a DynFraction with the value of a BigFraction, demoting it if it fits.
+ * @param fraction The fraction to copy.
+ */
+DynFraction::DynFraction(const BigFraction& fraction) : DynFraction() {
+    *this = fromBig(fraction);
+}
+
+/**
+ * @brief Reduce a 128-bit pair and store it in the narrowest storage that holds it.
+ * @param numerator The numerator.
+ * @param denominator The non-zero denominator.
+ * @return The reduced fraction.
+ */
+DynFraction DynFraction::fromWide(__int128 numerator, __int128 denominator) {
+    unsigned __int128 gcdValue = detail::gcdWide(numerator, denominator);
+    if (gcdValue > 1) {
+        numerator /= static_cast<__int128>(gcdValue);
+        denominator /= static_cast<__int128>(gcdValue);
+    }
+    if (denominator < 0) {
+        // A reduced pair with denominator -2^127 cannot be negated in place; let BigInt do it.
+        if (denominator == numeric_limits<__int128>::min() || numerator == numeric_limits<__int128>::min()) {
+            return fromBig(BigFraction(BigInt::fromInt128(numerator), BigInt::fromInt128(denominator)));
+        }
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+    DynFraction result;
+    if (fitsInt64(numerator) && fitsInt64(denominator)) {
+        long long narrowNumerator = static_cast<long long>(numerator);
+        long long narrowDenominator = static_cast<long long>(denominator);
+        if (fitsInt(narrowNumerator) && fitsInt(narrowDenominator)) {
+            result.small = {static_cast<int32_t>(narrowNumerator), static_cast<int32_t>(narrowDenominator)};
+        } else {
+            result.storage = FractionStorage::Wide;
+            result.wide = {narrowNumerator, narrowDenominator};
+        }
+        return result;
+    }
+    result.storage = FractionStorage::Big;
+    result.big = make_shared<const BigFraction>(BigInt::fromInt128(numerator), BigInt::fromInt128(denominator));
+    return result;
+}
+
+/**
+ * @brief Store a BigFraction, demoting it when both terms fit in 64 bits.
+ * @param value The reduced value.
+ * @return The fraction in its narrowest storage.
+ */
+DynFraction DynFraction::fromBig(const BigFraction& value) {
+    if (value.getNumerator().fitsLongLong() && value.getDenominator().fitsLongLong()) {
+        return fromWide(value.getNumerator().toLongLong(), value.getDenominator().toLongLong());
+    }
+    DynFraction result;
+    result.storage = FractionStorage::Big;
+    result.big = make_shared<const BigFraction>(value);
+    return result;
+}
+
+/**
+ * @brief Get the storage currently holding the value.
+ * @return Small, Wide or Big.
+ */
+FractionStorage DynFraction::getStorage() const {
+    return storage;
+}
+
+/**
+ * @brief Check whether the value can be stored in a Fraction.
+ * @return true if the fraction uses Small storage, false otherwise.
+ */
+bool DynFraction::fitsFraction() const {
+    return storage == FractionStorage::Small;
+}
+
+/**
+ * @brief Narrow to a Fraction.
+ * @return The same value as a Fraction.
+ * @throws overflow_error If a term does not fit in int.
+ */
+Fraction DynFraction::toFraction() const {
+    if (storage != FractionStorage::Small) {
+        throw std::overflow_error("DynFraction does not fit in a Fraction");
+    }
+    return Fraction::fromReduced(small.numerator, small.denominator);
+}
+
+/**
+ * @brief Widen to a BigFraction.
+ * @return The same value as a BigFraction.
+ */
+BigFraction DynFraction::toBigFraction() const {
+    switch (storage) {
+        case FractionStorage::Small:
+            return BigFraction(BigInt(small.numerator), BigInt(small.denominator));
+        case FractionStorage::Wide:
+            return BigFraction(BigInt(wide.numerator), BigInt(wide.denominator));
+        default:
+            return *big;
+    }
+}
+
+/**
+ * @brief Convert to the nearest double.
+ * @return The value as a double.
+ */
+double DynFraction::toDouble() const {
+    switch (storage) {
+        case FractionStorage::Small:
+            return static_cast<double>(small.numerator) / small.denominator;
+        case FractionStorage::Wide:
+            return static_cast<double>(wide.numerator) / static_cast<double>(wide.denominator);
+        default:
+            return big->toDouble();
+    }
+}
+
+/**
+ * @brief Format the fraction as "numerator/denominator".
+ * @return The formatted fraction.
+ */
+string DynFraction::toString() const {
+    switch (storage) {
+        case FractionStorage::Small:
+            return to_string(small.numerator) + "/" + to_string(small.denominator);
+        case FractionStorage::Wide:
+            return to_string(wide.numerator) + "/" + to_string(wide.denominator);
+        default:
+            return big->toString();
+    }
+}
+
+/**
+ * @brief Add two DynFractions; int operands are added in 64 bits, 64-bit operands in 128 bits.
+ * @param other The fraction to add.
+ * @return The exact, reduced sum.
+ */
+DynFraction DynFraction::operator+(const DynFraction& other) const {
+    if (storage == FractionStorage::Small && other.storage == FractionStorage::Small) {
+        return fromWide(static_cast<int64_t>(small.numerator) * other.small.denominator + static_cast<int64_t>(other.small.numerator) * small.denominator,
+                        static_cast<int64_t>(small.denominator) * other.small.denominator);
+    }
+    if (storage != FractionStorage::Big && other.storage != FractionStorage::Big) {
+        __int128 leftNumerator = storage == FractionStorage::Small ? small.numerator : wide.numerator;
+        __int128 leftDenominator = storage == FractionStorage::Small ? small.denominator : wide.denominator;
+        __int128 rightNumerator = other.storage == FractionStorage::Small ? other.small.numerator : other.wide.numerator;
+        __int128 rightDenominator = other.storage == FractionStorage::Small ? other.small.denominator : other.wide.denominator;
+        return fromWide(leftNumerator * rightDenominator + rightNumerator * leftDenominator, leftDenominator * rightDenominator);
+    }
+    return fromBig(toBigFraction() + other.toBigFraction());
+}
+
+/**
+ * @brief Subtract two DynFractions.
+ * @param other The fraction to subtract.
+ * @return The exact, reduced difference.
+ */
+DynFraction DynFraction::operator-(const DynFraction& other) const {
+    return *this + (-other);
+}
+
+/**
+ * @brief Multiply two DynFractions.
+ * @param other The fraction to multiply by.
+ * @return The exact, reduced product.
+ */
+DynFraction DynFraction::operator*(const DynFraction& other) const {
+    if (storage == FractionStorage::Small && other.storage == FractionStorage::Small) {
+        return fromWide(static_cast<int64_t>(small.numerator) * other.small.numerator,
+                        static_cast<int64_t>(small.denominator) * other.small.denominator);
+    }
+    if (storage != FractionStorage::Big && other.storage != FractionStorage::Big) {
+        __int128 leftNumerator = storage == FractionStorage::Small ? small.numerator : wide.numerator;
+        __int128 leftDenominator = storage == FractionStorage::Small ? small.denominator : wide.denominator;
+        __int128 rightNumerator = other.storage == FractionStorage::Small ? other.small.numerator : other.wide.numerator;
+        __int128 rightDenominator = other.storage == FractionStorage::Small ? other.small.denominator : other.wide.denominator;
+        return fromWide(leftNumerator * rightNumerator, leftDenominator * rightDenominator);
+    }
+    return fromBig(toBigFraction() * other.toBigFraction());
+}
+
+/**
+ * @brief Divide two DynFractions.
+ * @param other The divisor.
+ * @return The exact, reduced quotient.
+ * @throws runtime_error If other is zero.
+ */
+DynFraction DynFraction::operator/(const DynFraction& other) const {
+    if (other.storage == FractionStorage::Small && other.small.numerator == 0) {
+        throw std::runtime_error("Cannot divide by zero");
+    }
+    if (storage == FractionStorage::Small && other.storage == FractionStorage::Small) {
+        return fromWide(static_cast<int64_t>(small.numerator) * other.small.denominator,
+                        static_cast<int64_t>(small.denominator) * other.small.numerator);
+    }
+    if (storage != FractionStorage::Big && other.storage != FractionStorage::Big) {
+        __int128 leftNumerator = storage == FractionStorage::Small ? small.numerator : wide.numerator;
+        __int128 leftDenominator = storage == FractionStorage::Small ? small.denominator : wide.denominator;
+        __int128 rightNumerator = other.storage == FractionStorage::Small ? other.small.numerator : other.wide.numerator;
+        __int128 rightDenominator = other.storage == FractionStorage::Small ? other.small.denominator : other.wide.denominator;
+        return fromWide(leftNumerator * rightDenominator, leftDenominator * rightNumerator);
+    }
+    return fromBig(toBigFraction() / other.toBigFraction());
+}
+
+/**
+ * @brief Negate the fraction; -INT_MIN moves to Wide storage.
+ * @return The fraction with its sign flipped.
+ */
+DynFraction DynFraction::operator-() const {
+    switch (storage) {
+        case FractionStorage::Small:
+            return fromWide(-static_cast<int64_t>(small.numerator), small.denominator);
+        case FractionStorage::Wide:
+            return fromWide(-static_cast<__int128>(wide.numerator), wide.denominator);
+        default:
+            return fromBig(-*big);
+    }
+}
+
+/**
+ * @brief Compare two DynFractions exactly.
+ * @param other The fraction to compare with.
+ * @return Negative, zero or positive as this is less than, equal to or greater than other.
+ */
+int DynFraction::compare(const DynFraction& other) const {
+    if (storage == FractionStorage::Small && other.storage == FractionStorage::Small) {
+        int64_t left = static_cast<int64_t>(small.numerator) * other.small.denominator;
+        int64_t right = static_cast<int64_t>(other.small.numerator) * small.denominator;
+        return (left > right) - (left < right);
+    }
+    if (storage != FractionStorage::Big && other.storage != FractionStorage::Big) {
+        __int128 left = static_cast<__int128>(storage == FractionStorage::Small ? small.numerator : wide.numerator) *
+                        (other.storage == FractionStorage::Small ? other.small.denominator : other.wide.denominator);
+        __int128 right = static_cast<__int128>(other.storage == FractionStorage::Small ? other.small.numerator : other.wide.numerator) *
+                         (storage == FractionStorage::Small ? small.denominator : wide.denominator);
+        return (left > right) - (left < right);
+    }
+    BigFraction left = toBigFraction();
+    BigFraction right = other.toBigFraction();
+    return (left > right) - (left < right);
+}
+
+/**
+ * @brief Check whether two DynFractions are equal.
+ * @param other The fraction to compare with.
+ * @return true if the values are exactly equal, false otherwise.
+ */
+bool DynFraction::operator==(const DynFraction& other) const {
+    return compare(other) == 0;
+}
+
+/**
+ * @brief Check whether two DynFractions differ.
+ * @param other The fraction to compare with.
+ * @return true if the values differ, false otherwise.
+ */
+bool DynFraction::operator!=(const DynFraction& other) const {
+    return compare(other) != 0;
+}
+
+/**
+ * @brief Check whether this DynFraction is less than another.
+ * @param other The fraction to compare with.
+ * @return true if this fraction is smaller, false otherwise.
+ */
+bool DynFraction::operator<(const DynFraction& other) const {
+    return compare(other) < 0;
+}
+
+/**
+ * @brief Check whether this DynFraction is greater than another.
+ * @param other The fraction to compare with.
+ * @return true if this fraction is larger, false otherwise.
+ */
+bool DynFraction::operator>(const DynFraction& other) const {
+    return compare(other) > 0;
+}
+
+/**
+ * @brief Check whether this DynFraction is less than or equal to another.
+ * @param other The fraction to compare with.
+ * @return true if this fraction is not larger, false otherwise.
+ */
+bool DynFraction::operator<=(const DynFraction& other) const {
+    return compare(other) <= 0;
+}
+
+/**
+ * @brief Check whether this DynFraction is greater than or equal to another.
+ * @param other The fraction to compare with.
+ * @return true if this fraction is not smaller, false otherwise.
+ */
+bool DynFraction::operator>=(const DynFraction& other) const {
+    return compare(other) >= 0;
+}
+
+/**
+ * @brief Print a DynFraction as "numerator/denominator".
+ * @param outs The output stream to write to.
+ * @param fraction The fraction to print.
+ * @return The output stream.
+ */
+std::ostream& ariel::operator<<(std::ostream& outs, const DynFraction& fraction) {
+    return outs << fraction.toString();
+}
+
+/**
+ * @brief Raise a DynFraction to an integer power. Small results come from pow(Fraction, int); the rest
+ * power the terms separately as BigInts, which stay coprime, so no gcd is needed at any size.
+ * @param base The fraction to raise.
+ * @param exponent The power; negative powers raise the reciprocal, and any fraction to the 0 is 1.
+ * @return The exact power, in its narrowest storage.
+ * @throws runtime_error If base is zero and exponent is negative.
+ */
+DynFraction ariel::pow(const DynFraction& base, int exponent) {
+    unsigned long long magnitude = exponent < 0 ? 0 - static_cast<unsigned long long>(static_cast<long long>(exponent)) : static_cast<unsigned long long>(exponent);
+    if (base.fitsFraction()) {
+        Fraction small = base.toFraction();
+        // bits(|n|) * exponent <= 31 guarantees |n|^exponent < 2^31, for both terms.
+        unsigned long long numeratorBits = static_cast<unsigned long long>(bit_width(static_cast<unsigned long long>(llabs(small.getNumerator()))));
+        unsigned long long denominatorBits = static_cast<unsigned long long>(bit_width(static_cast<unsigned long long>(small.getDenominator())));
+        if (max(numeratorBits, denominatorBits) * magnitude <= 31) {
+            return DynFraction(pow(small, exponent));
+        }
+    }
+    BigFraction value = base.toBigFraction();
+    BigInt numerator = value.getNumerator().abs();
+    BigInt denominator = value.getDenominator();
+    if (exponent < 0) {
+        if (numerator.isZero()) {
+            throw runtime_error("Cannot divide by zero");
+        }
+        swap(numerator, denominator);
+    } else if (numerator.isZero()) {
+        return DynFraction(magnitude == 0 ? 1 : 0);
+    }
+    BigInt numeratorPower = power(numerator, magnitude);
+    if (value.getNumerator().sign() < 0 && (magnitude & 1) != 0) {
+        numeratorPower = -numeratorPower;
+    }
+    return DynFraction(BigFraction::fromReduced(numeratorPower, power(denominator, magnitude)));
+}
@@ -0,0 +1,73 @@
+#ifndef DYNFRACTION_HPP
+#define DYNFRACTION_HPP
+
+#include "BigFraction.hpp"
+#include "Fraction.hpp"
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace ariel {
+
+    // Where a DynFraction currently keeps its value.
+    enum class FractionStorage { Small, Wide, Big };
+
+    // An exact fraction that never overflows. Values that fit in int stay in 32-bit fields,
+    // larger ones move to 64-bit fields and then to a shared BigFraction, and every result
+    // is demoted again as soon as reduction brings it back into range.
+    class DynFraction {
+        private:
+            FractionStorage storage;
+            union {
+                struct { std::int32_t numerator, denominator; } small;
+                struct { std::int64_t numerator, denominator; } wide;
+            };
+            std::shared_ptr<const BigFraction> big;
+
+            static DynFraction fromWide(__int128 numerator, __int128 denominator);
+            static DynFraction fromBig(const BigFraction& value);
+            int compare(const DynFraction& other) const;
+
+        public:
+            // constructors
+            DynFraction();
+            DynFraction(long long numerator, long long denominator = 1);
+            DynFraction(const Fraction& fraction);
+            DynFraction(const BigFraction& fraction);
+
+            // getter functions
+            FractionStorage getStorage() const;
+            bool fitsFraction() const;
+
+            // conversion
+            Fraction toFraction() const;  // throws std::overflow_error unless fitsFraction()
+            BigFraction toBigFraction() const;
+            double toDouble() const;
+            std::string toString() const;
+
+            // arithmetic operator overloading for DynFraction objects
+            DynFraction operator+(const DynFraction& other) const;
+            DynFraction operator-(const DynFraction& other) const;
+            DynFraction operator*(const DynFraction& other) const;
+            DynFraction operator/(const DynFraction& other) const;
+            DynFraction operator-() const;
+
+            // comparison operator overloading for DynFraction objects
+            bool operator==(const DynFraction& other) const;
+            bool operator!=(const DynFraction& other) const;
+            bool operator<(const DynFraction& other) const;
+            bool operator>(const DynFraction& other) const;
+            bool operator<=(const DynFraction& other) const;
+            bool operator>=(const DynFraction& other) const;
+
+            friend std::ostream& operator<<(std::ostream& outs, const DynFraction& fraction);
+    };
+
+    std::ostream& operator<<(std::ostream& outs, const DynFraction& fraction);
+
+    // integer power that never overflows: the result is promoted as far as it needs to go
+    DynFraction pow(const DynFraction& base, int exponent);
+}
+
+#endif /* DYNFRACTION_HPP */
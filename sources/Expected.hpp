@@ -0,0 +1,51 @@
+#ifndef EXPECTED_HPP
+#define EXPECTED_HPP
+
+#include <stdexcept>
+#include <utility>
+
+namespace ariel {
+
+    // Wraps an error so it can initialize an Expected, like std::unexpected.
+    template <typename E>
+    struct Unexpected {
+        E value;
+    };
+
+    template <typename E>
+    Unexpected<E> unexpected(E error) {
+        return Unexpected<E>{error};
+    }
+
+    // A value of type T or an error of type E, a minimal stand-in for C++23 std::expected.
+    template <typename T, typename E>
+    class Expected {
+        private:
+            T result;
+            E failure;
+            bool ok;
+
+        public:
+            // constructors
+            Expected(const T& value) : result(value), failure(), ok(true) {}
+            Expected(Unexpected<E> error) : result(), failure(error.value), ok(false) {}
+
+            // state inspection
+            bool has_value() const { return ok; }
+            explicit operator bool() const { return ok; }
+
+            // value access; value() throws std::logic_error when holding an error
+            const T& value() const {
+                if (!ok) {
+                    throw std::logic_error("Expected holds an error, not a value");
+                }
+                return result;
+            }
+            const T& operator*() const { return result; }
+            const T* operator->() const { return &result; }
+            T value_or(T fallback) const { return ok ? result : std::move(fallback); }
+            E error() const { return failure; }
+    };
+}
+
+#endif /* EXPECTED_HPP */
@@ -0,0 +1,227 @@
+#include "FareySequence.hpp"   // Include header file
+#include <limits>              // Include numeric limits
+#include <stdexcept>           // Include exception classes
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+static_assert(ranges::input_range<FareySequence> && ranges::view<FareySequence>);
+
+namespace {
+    /**
+     * @brief The smallest fraction above numerator/denominator with denominator at most order.
+     * Its denominator d solves numerator * d = -1 (mod denominator) and is the largest such d within order.
+     * @param numerator The numerator, coprime to the denominator.
+     * @param denominator The denominator, between 1 and order.
+     * @return The successor as {numerator, denominator}.
+     */
+    pair<long long, long long> successor(long long numerator, long long denominator, long long order) {
+        // Extended Euclid for the inverse of numerator modulo denominator.
+        long long remainder = numerator % denominator;
+        long long oldRest = remainder < 0 ? remainder + denominator : remainder;
+        long long rest = denominator;
+        long long oldInverse = 1;
+        long long inverse = 0;
+        while (rest != 0) {
+            long long quotient = oldRest / rest;
+            long long nextRest = oldRest - quotient * rest;
+            oldRest = rest;
+            rest = nextRest;
+            long long nextInverse = oldInverse - quotient * inverse;
+            oldInverse = inverse;
+            inverse = nextInverse;
+        }
+        long long smallest = ((-oldInverse) % denominator + denominator) % denominator;
+        long long nextDenominator = smallest + (order - smallest) / denominator * denominator;
+        return {(1 + numerator * nextDenominator) / denominator, nextDenominator};
+    }
+
+    /**
+     * @brief The largest fraction with denominator at most order that does not exceed value/scale.
+     * @param value The numerator of the bound, non-negative.
+     * @param scale The denominator of the bound, positive.
+     * @return The fraction as {numerator, denominator}, in lowest terms.
+     */
+    pair<long long, long long> floorTerm(__int128 value, __int128 scale, long long order) {
+        __int128 bestNumerator = value / scale;
+        __int128 bestDenominator = 1;
+        for (long long candidate = 2; candidate <= order; ++candidate) {
+            __int128 numerator = value * candidate / scale;
+            // Only a strictly larger value replaces the best, so the first (smallest) denominator wins and stays reduced.
+            if (numerator * bestDenominator > bestNumerator * candidate) {
+                bestNumerator = numerator;
+                bestDenominator = candidate;
+            }
+        }
+        return {static_cast<long long>(bestNumerator), static_cast<long long>(bestDenominator)};
+    }
+
+    /**
+     * @brief Check that a fraction is a term of the Farey sequence of the given order.
+     * @throws invalid_argument If it lies outside [0, 1] or its denominator exceeds order.
+     */
+    void requireTerm(const Fraction& term, int order) {
+        if (term.getNumerator() < 0 || term.getNumerator() > term.getDenominator() || term.getDenominator() > order) {
+            throw invalid_argument("Fraction is not a term of the Farey sequence");
+        }
+    }
+}
+
+/**
+ * @brief Create the end iterator.
+ */
+FareySequence::iterator::iterator()
+    : order(1), numerator(0), denominator(1), nextNumerator(0), nextDenominator(1), stopNumerator(0), stopDenominator(1) {}
+
+/**
+ * @brief Start at numerator/denominator and stop before stopNumerator/stopDenominator.
+ */
+FareySequence::iterator::iterator(long long order, long long numerator, long long denominator, long long stopNumerator, long long stopDenominator)
+    : order(order), numerator(numerator), denominator(denominator), nextNumerator(0), nextDenominator(1), stopNumerator(stopNumerator),
+      stopDenominator(stopDenominator) {
+    tie(nextNumerator, nextDenominator) = successor(numerator, denominator, order);
+}
+
+/**
+ * @brief Get the current term.
+ * @return The current term, in lowest terms without a gcd.
+ */
+Fraction FareySequence::iterator::operator*() const {
+    return Fraction::fromReduced(static_cast<int>(numerator), static_cast<int>(denominator));
+}
+
+/**
+ * @brief Move to the next term: for consecutive a/b, c/d the one after is (k c - a)/(k d - b), k = (order + b) / d.
+ * @return This iterator.
+ */
+FareySequence::iterator& FareySequence::iterator::operator++() {
+    long long factor = (order + denominator) / nextDenominator;
+    long long followingNumerator = factor * nextNumerator - numerator;
+    long long followingDenominator = factor * nextDenominator - denominator;
+    numerator = nextNumerator;
+    denominator = nextDenominator;
+    nextNumerator = followingNumerator;
+    nextDenominator = followingDenominator;
+    return *this;
+}
+
+/**
+ * @brief Move to the next term.
+ */
+void FareySequence::iterator::operator++(int) {
+    ++*this;
+}
+
+/**
+ * @brief Check whether the stop term has been reached.
+ * @return true at the end, false otherwise.
+ */
+bool FareySequence::iterator::operator==(default_sentinel_t) const {
+    return numerator == stopNumerator && denominator == stopDenominator;
+}
+
+/**
+ * @brief Create a piece of the sequence from raw terms; callers have validated them.
+ */
+FareySequence::FareySequence(long long order, long long firstNumerator, long long firstDenominator, long long stopNumerator, long long stopDenominator)
+    : order(order), firstNumerator(firstNumerator), firstDenominator(firstDenominator), stopNumerator(stopNumerator), stopDenominator(stopDenominator) {}
+
+/**
+ * @brief Create the whole Farey sequence of the given order, from 0/1 to 1/1.
+ * @param order The largest denominator.
+ * @throws invalid_argument If order is less than 1 or too large to continue past 1/1.
+ */
+FareySequence::FareySequence(int order) : FareySequence(order, 0, 1, 0, 1) {
+    if (order < 1 || order == numeric_limits<int>::max()) {
+        throw invalid_argument("Farey order must be between 1 and INT_MAX - 1");
+    }
+    // The term after 1/1 among all fractions with denominator <= order is (order + 1)/order.
+    stopNumerator = order + 1LL;
+    stopDenominator = order;
+}
+
+/**
+ * @brief Create the part of the Farey sequence of the given order between two of its terms.
+ * @param order The largest denominator.
+ * @param first The first term produced.
+ * @param last The last term produced.
+ * @throws invalid_argument If order is out of range, either bound is not a term, or first > last.
+ */
+FareySequence::FareySequence(int order, const Fraction& first, const Fraction& last) : FareySequence(order) {
+    requireTerm(first, order);
+    requireTerm(last, order);
+    if (static_cast<long long>(first.getNumerator()) * last.getDenominator() > static_cast<long long>(last.getNumerator()) * first.getDenominator()) {
+        throw invalid_argument("First term must not be greater than the last");
+    }
+    firstNumerator = first.getNumerator();
+    firstDenominator = first.getDenominator();
+    tie(stopNumerator, stopDenominator) = successor(last.getNumerator(), last.getDenominator(), order);
+}
+
+/**
+ * @brief Get an iterator at the first term.
+ * @return The begin iterator.
+ */
+FareySequence::iterator FareySequence::begin() const {
+    return iterator(order, firstNumerator, firstDenominator, stopNumerator, stopDenominator);
+}
+
+/**
+ * @brief Get the end sentinel.
+ * @return The end sentinel.
+ */
+default_sentinel_t FareySequence::end() const {
+    return default_sentinel;
+}
+
+/**
+ * @brief Cut the sequence at the terms nearest to evenly spaced values. Farey terms are equidistributed,
+ * so pieces of equal width hold about the same number of terms. Each piece starts from its own first term
+ * (its successor comes from extended Euclid), so the pieces can be walked on separate threads.
+ * @param parts The number of pieces wanted; fewer are returned when the sequence is too short.
+ * @return The pieces, in order.
+ * @throws invalid_argument If parts is zero.
+ */
+vector<FareySequence> FareySequence::split(size_t parts) const {
+    if (parts == 0) {
+        throw invalid_argument("Cannot split into zero parts");
+    }
+    vector<FareySequence> pieces;
+    long long pieceNumerator = firstNumerator;
+    long long pieceDenominator = firstDenominator;
+    __int128 count = static_cast<__int128>(parts);
+    for (size_t index = 1; index < parts; ++index) {
+        // first + (stop - first) * index / parts, as an exact ratio.
+        __int128 weight = static_cast<__int128>(index);
+        __int128 value = static_cast<__int128>(firstNumerator) * stopDenominator * (count - weight) + static_cast<__int128>(stopNumerator) * firstDenominator * weight;
+        __int128 scale = static_cast<__int128>(firstDenominator) * stopDenominator * count;
+        auto [numerator, denominator] = floorTerm(value, scale, order);
+        if (static_cast<__int128>(numerator) * pieceDenominator <= static_cast<__int128>(pieceNumerator) * denominator) {
+            continue;
+        }
+        pieces.push_back(FareySequence(order, pieceNumerator, pieceDenominator, numerator, denominator));
+        pieceNumerator = numerator;
+        pieceDenominator = denominator;
+    }
+    pieces.push_back(FareySequence(order, pieceNumerator, pieceDenominator, stopNumerator, stopDenominator));
+    return pieces;
+}
+
+/**
+ * @brief Find the next term after a fraction among all fractions with a bounded denominator.
+ * @param term The fraction to step from; its denominator must not exceed order.
+ * @param order The largest denominator.
+ * @return The smallest fraction greater than term with denominator at most order.
+ * @throws invalid_argument If order is less than 1 or smaller than the term's denominator.
+ * @throws overflow_error If the successor's numerator does not fit in int.
+ */
+Fraction ariel::farey_next(const Fraction& term, int order) {
+    if (order < 1 || term.getDenominator() > order) {
+        throw invalid_argument("Denominator exceeds the Farey order");
+    }
+    auto [numerator, denominator] = successor(term.getNumerator(), term.getDenominator(), order);
+    if (numerator > numeric_limits<int>::max()) {
+        throw overflow_error("The next term's numerator would result in integer overflow!");
+    }
+    return Fraction::fromReduced(static_cast<int>(numerator), static_cast<int>(denominator));
+}
@@ -0,0 +1,61 @@
+#ifndef FAREYSEQUENCE_HPP
+#define FAREYSEQUENCE_HPP
+
+#include "Fraction.hpp"
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+namespace ariel {
+
+    // The Farey sequence of the given order: every reduced fraction in [0, 1] whose denominator is at
+    // most order, in increasing order. Each term comes from the two before it by the next-term
+    // recurrence, so there is no gcd and no sort, and every step costs O(1).
+    class FareySequence : public std::ranges::view_interface<FareySequence> {
+        private:
+            long long order;
+            long long firstNumerator, firstDenominator;
+            long long stopNumerator, stopDenominator;  // the first term not produced
+
+            FareySequence(long long order, long long firstNumerator, long long firstDenominator, long long stopNumerator,
+                          long long stopDenominator);
+
+        public:
+            class iterator {
+                private:
+                    long long order;
+                    long long numerator, denominator;          // the current term
+                    long long nextNumerator, nextDenominator;  // the term after it
+                    long long stopNumerator, stopDenominator;
+
+                public:
+                    using iterator_concept = std::input_iterator_tag;
+                    using value_type = Fraction;
+                    using difference_type = std::ptrdiff_t;
+
+                    iterator();
+                    iterator(long long order, long long numerator, long long denominator, long long stopNumerator, long long stopDenominator);
+                    Fraction operator*() const;
+                    iterator& operator++();
+                    void operator++(int);
+                    bool operator==(std::default_sentinel_t) const;
+            };
+
+            // constructors
+            explicit FareySequence(int order);                                        // all of [0, 1]
+            FareySequence(int order, const Fraction& first, const Fraction& last);  // the terms in [first, last]
+
+            // range access
+            iterator begin() const;
+            std::default_sentinel_t end() const;
+
+            // Up to parts disjoint, independent pieces of similar length that together give this sequence in order.
+            std::vector<FareySequence> split(std::size_t parts) const;
+    };
+
+    // The smallest fraction greater than term with denominator at most order, found by extended Euclid.
+    Fraction farey_next(const Fraction& term, int order);
+}
+
+#endif /* FAREYSEQUENCE_HPP */
@@ -1,18 +1,25 @@
 #include "Fraction.hpp"   // Include header file
+#include "FractionPolicy.hpp"   // Include overflow policies
+#include "FractionCounters.hpp"   // Include operation counters
+#include "FractionProfile.hpp"   // Include the sampling width profiler
+#include "FractionProbes.hpp"   // Include USDT tracepoints
 #include <stdexcept>      // Include exception classes
 #include <iostream>       // Include input and output stream classes
 #include <sstream>        // Include string stream classes
 #include <limits>         // Include numeric limits
 #include <cstdlib>        // Include C Standard General Utilities Library
+#include <bit>            // Include std::bit_width
+#include <utility>        // Include std::swap
 
 using namespace std;     // Use standard namespace
 using namespace ariel;   // Use namespace ariel
+using detail::countFraction;
+using detail::FractionCounter;
+using detail::profileFraction;
 
-// Default constructor
-/**
- * @brief Create a new Fraction object with default values.
- */
-Fraction::Fraction() : numerator(0), denominator(1) {}
+#ifndef ARIEL_FRACTION_HEADER_ONLY
+#include "Fraction.ipp"   // Include the inlinable members, compiled out of line here
+#endif
 
 // Constructor with parameters
 /**
@@ -25,7 +32,12 @@ Fraction::Fraction(int numerator, int denominator) : numerator(numerator), denom
     if (denominator == 0) {
         throw std::invalid_argument("Denominator cannot be zero");
     }
+    countFraction(FractionCounter::Normalizations);
+    countFraction(FractionCounter::GcdCalls);
+    ARIEL_FRACTION_PROBE2(normalize, numerator, denominator);
+    ARIEL_FRACTION_PROBE2(gcd_entry, numerator, denominator);
     int gcdValue = abs(gcd(numerator, denominator));
+    ARIEL_FRACTION_PROBE3(gcd_exit, numerator, denominator, gcdValue);
     this->numerator = ((numerator < 0) ^ (denominator < 0)) ? -abs(numerator / gcdValue) : abs(numerator / gcdValue);
     this->denominator = abs(denominator / gcdValue);
 }
@@ -36,53 +48,19 @@ Fraction::Fraction(int numerator, int denominator) : numerator(numerator), denom
  * @param number The float value to convert to fraction.
  */
 Fraction::Fraction(float number) {
+    countFraction(FractionCounter::FloatConversions);
     if (number == 0) {
         this->numerator = 0;
         this->denominator = 1;
     } else {
         number = (int)(number * 1000);
+        countFraction(FractionCounter::GcdCalls);
         int gcdValue = abs(gcd(number, 1000));
         this->numerator = number / gcdValue;
         this->denominator = 1000 / gcdValue;
     }
 }
 
-// Getter functions
-/**
- * @brief Get the numerator of the fraction.
- * @return The numerator of the fraction.
- */
-int Fraction::getNumerator() const {
-    return numerator;
-}
-/**
- * @brief Get the denominator of the fraction.
- * @return The denominator of the fraction.
- */
-int Fraction::getDenominator() const {
-    return denominator;
-}
-
-// Setter functions
-/**
- * @brief Set the numerator of the fraction.
- * @param num The new numerator value.
- */
-void Fraction::setNumerator(int num) {
-    numerator = num;
-}
-/**
- * @brief Set the denominator of the fraction.
- * @param num The new denominator value.
- * @throws invalid_argument If denominator is 0.
- */
-void Fraction::setDenominator(int num) {
-    if (denominator == 0) {
-        throw std::invalid_argument("Denominator cannot be zero");
-    }
-    denominator = num;
-}
-
 /**
  * @brief Calculates the greatest common divisor (GCD) of the given numerator and denominator.
  * @param numerator The numerator of the fraction.
@@ -90,222 +68,277 @@ void Fraction::setDenominator(int num) {
  * @return The greatest common divisor of the numerator and denominator.
 */
 int Fraction::gcd(int numerator, int denominator) {
+    countFraction(FractionCounter::GcdIterations);
     if (numerator == 0) {
         return denominator;
     }
     return gcd(denominator % numerator, numerator);
 }
 
-/**
- * @brief Addition operator overload for Fraction class.
- * @param other The Fraction object to be added to this Fraction object.
- * @return A new Fraction object that represents the result of adding this and other.
- * @throw std::overflow_error if the addition results in integer overflow.
-*/
-Fraction Fraction::operator+(const Fraction& other) const {
-    if ((numerator != 0) && (other.numerator != 0))
-    {
-        if ((abs(numerator) > std::numeric_limits<int>::max() / abs(other.denominator)) ||
-        (abs(denominator) > std::numeric_limits<int>::max() / abs(other.numerator)) ||
-        (abs(denominator) > std::numeric_limits<int>::max() / abs(other.denominator))){
-            throw std::overflow_error("Multiplication the numerators would result in integer overflow!");
-        }
+namespace {
+
+    const long long INT_MAX_VALUE = std::numeric_limits<int>::max();
+    const long long INT_MIN_VALUE = std::numeric_limits<int>::min();
+
+    // True when |first * second| > INT_MAX, the check every operator used to repeat with divisions.
+    bool productOverflows(long long first, long long second) {
+        return llabs(first * second) > INT_MAX_VALUE;
     }
 
-    int num1 = numerator * other.denominator;
-    int num2 = other.numerator * denominator;
-    int new_denominator = denominator * other.denominator;
+    bool outOfIntRange(long long value) {
+        return value < INT_MIN_VALUE || value > INT_MAX_VALUE;
+    }
 
-    if ((num1 < 0) && (num2 < 0) && (num1 < std::numeric_limits<int>::min() - num2) ||
-    (num1 > 0) && (num2 > 0) && (num1 > std::numeric_limits<int>::max() - num2)) {
-        throw std::overflow_error("Multiplication the numerators would result in integer overflow!");
+    // Reduce an exact 64-bit quotient to lowest terms with a positive denominator; flag it if it does not fit in int.
+    WideResult reduceExact(long long numerator, long long denominator, bool overflow) {
+        countFraction(FractionCounter::GcdCalls);
+        ARIEL_FRACTION_PROBE2(gcd_entry, numerator, denominator);
+        long long gcdValue = detail::countedGcd(numerator, denominator);
+        ARIEL_FRACTION_PROBE3(gcd_exit, numerator, denominator, gcdValue);
+        numerator /= gcdValue;
+        denominator /= gcdValue;
+        if (denominator < 0) {
+            numerator = -numerator;
+            denominator = -denominator;
+        }
+        overflow |= outOfIntRange(numerator) | (denominator > INT_MAX_VALUE);
+        return WideResult{numerator, denominator, overflow, false};
     }
-    int new_numerator = num1 + num2;
-    return Fraction(new_numerator, new_denominator);
-}
 
-/**
- * @brief Subtraction operator overload for Fraction class.
- * @param other The Fraction object to be subtracted from this Fraction object.
- * @return A new Fraction object that represents the result of subtracting other from this.
- * @throw std::overflow_error if the subtraction results in integer overflow.
-*/
-Fraction Fraction::operator-(const Fraction& other) const {
-    if ((numerator != 0) && (other.numerator != 0))
-    {
-        if ((abs(numerator) > std::numeric_limits<int>::max() / abs(other.denominator)) ||
-        (abs(denominator) > std::numeric_limits<int>::max() / abs(other.numerator)) ||
-        (abs(denominator) > std::numeric_limits<int>::max() / abs(other.denominator))){
-            throw std::overflow_error("Multiplication the numerators would result in integer overflow!");
+    // The checked_* view of a wide result.
+    FractionResult toResult(const WideResult& result) {
+        if (result.divideByZero) {
+            return ariel::unexpected(FracError::DivideByZero);
         }
+        if (result.overflow) {
+            return ariel::unexpected(FracError::Overflow);
+        }
+        return Fraction::fromReduced(static_cast<int>(result.numerator), static_cast<int>(result.denominator));
     }
 
-    int num1 = numerator * other.denominator;
-    int num2 = other.numerator * denominator;
-    int new_denominator = denominator * other.denominator;
+    // base^exponent by squaring, or false if it exceeds INT_MAX. If (bits(base) - 1) * exponent >= 31 the
+    // power is at least 2^31, and otherwise it is below 2^62, so one bit-length test replaces per-step checks.
+    bool powerFits(unsigned long long base, unsigned long long exponent, unsigned long long& power) {
+        if (base > 1 && (static_cast<unsigned long long>(bit_width(base)) - 1) * exponent >= 31) {
+            return false;
+        }
+        power = 1;
+        for (; exponent != 0; exponent >>= 1) {
+            if ((exponent & 1) != 0) {
+                power *= base;
+            }
+            base = (exponent > 1) ? base * base : base;
+        }
+        return power <= static_cast<unsigned long long>(INT_MAX_VALUE);
+    }
 
-    if ((num1 < 0) && (num2 > 0) && (num1 < std::numeric_limits<int>::min() + num2) ||
-    (num1 > 0) && (num2 < 0) && (num1 > std::numeric_limits<int>::max() + num2)) {
-        throw std::overflow_error("Multiplication the numerators would result in integer overflow!");
+    // The body of wide_div, forced inline into operator/ and checked_div: the divide-by-zero branch pushed it
+    // past the inliner's size limit, and as an out-of-line call it made operator/ about 65% slower than operator*.
+    __attribute__((always_inline)) inline WideResult divideExact(const Fraction& left, const Fraction& right) {
+        if (right.getNumerator() == 0) {
+            countFraction(FractionCounter::DivideByZero);
+            return WideResult{(left.getNumerator() > 0) - (left.getNumerator() < 0), 1, false, true};
+        }
+        bool overflow = (left.getNumerator() != 0) &
+        (productOverflows(left.getNumerator(), right.getDenominator()) | productOverflows(left.getDenominator(), right.getNumerator()));
+        WideResult result = reduceExact(static_cast<long long>(left.getNumerator()) * right.getDenominator(),
+                                        static_cast<long long>(left.getDenominator()) * right.getNumerator(), overflow);
+        countFraction(FractionCounter::DivOverflows, result.overflow);
+        if (result.overflow) {
+            ARIEL_FRACTION_PROBE5(overflow, '/', left.getNumerator(), left.getDenominator(), right.getNumerator(), right.getDenominator());
+        }
+        return result;
     }
-    int new_numerator = num1 - num2;
-    return Fraction(new_numerator, new_denominator);
 }
 
-
 /**
- * @brief This method overloads the multiplication operator '*' for the Fraction class.
- * @param other The fraction to multiply with the current fraction.
- * @return The result of multiplying the current fraction with the other fraction.
- * @throws std::overflow_error if the operation would result in an integer overflow.
+ * @brief Add two fractions exactly in 64 bits.
+ * @param left The first addend.
+ * @param right The second addend.
+ * @return The reduced sum, flagged as overflow whenever a cross product, the
+ * product of the denominators or the unreduced numerator sum would leave the
+ * int range, exactly as operator+ has always thrown, or when the reduced sum
+ * itself does not fit. The checks are combined without short-circuiting so
+ * policies that do not throw stay branch-light.
  */
-Fraction Fraction::operator*(const Fraction& other) const {
-    if ((numerator != 0) && (other.numerator != 0))
-        {
-        // Check for potential integer overflow during multiplication.
-        if ((abs(numerator) > std::numeric_limits<int>::max() / abs(other.numerator)) ||
-        (abs(denominator) > std::numeric_limits<int>::max() / abs(other.denominator))) {
-            throw std::overflow_error("Multiplication the numerators would result in integer overflow!");
-        }
+WideResult ariel::wide_add(const Fraction& left, const Fraction& right) {
+    long long num1 = static_cast<long long>(left.getNumerator()) * right.getDenominator();
+    long long num2 = static_cast<long long>(right.getNumerator()) * left.getDenominator();
+    long long new_denominator = static_cast<long long>(left.getDenominator()) * right.getDenominator();
+    bool overflow = (left.getNumerator() != 0) & (right.getNumerator() != 0) &
+    (productOverflows(left.getNumerator(), right.getDenominator()) | productOverflows(left.getDenominator(), right.getNumerator()) |
+    productOverflows(left.getDenominator(), right.getDenominator()) | outOfIntRange(num1 + num2));
+    WideResult result = reduceExact(num1 + num2, new_denominator, overflow);
+    countFraction(FractionCounter::AddOverflows, result.overflow);
+    if (result.overflow) {
+        ARIEL_FRACTION_PROBE5(overflow, '+', left.getNumerator(), left.getDenominator(), right.getNumerator(), right.getDenominator());
     }
-
-    // Calculate the new numerator and denominator after multiplication.
-    int new_numerator = numerator * other.numerator;
-    int new_denominator = denominator * other.denominator;
-
-    return Fraction(new_numerator, new_denominator);
+    return result;
 }
 
 /**
- * @brief This method overloads the division operator '/' for the Fraction class.
- * @param other The fraction to divide the current fraction by.
- * @return The result of dividing the current fraction by the other fraction.
- * @throws std::runtime_error if attempting to divide by zero.
- * @throws std::overflow_error if the operation would result in an integer overflow.
-*/
-Fraction Fraction::operator/(const Fraction& other) const {
-    if (other.numerator == 0) {
-        throw std::runtime_error("Cannot divide by zero");
+ * @brief Subtract two fractions exactly in 64 bits.
+ * @param left The minuend.
+ * @param right The subtrahend.
+ * @return The reduced difference, flagged as overflow under the same rules as wide_add.
+ */
+WideResult ariel::wide_sub(const Fraction& left, const Fraction& right) {
+    long long num1 = static_cast<long long>(left.getNumerator()) * right.getDenominator();
+    long long num2 = static_cast<long long>(right.getNumerator()) * left.getDenominator();
+    long long new_denominator = static_cast<long long>(left.getDenominator()) * right.getDenominator();
+    bool overflow = (left.getNumerator() != 0) & (right.getNumerator() != 0) &
+    (productOverflows(left.getNumerator(), right.getDenominator()) | productOverflows(left.getDenominator(), right.getNumerator()) |
+    productOverflows(left.getDenominator(), right.getDenominator()) | outOfIntRange(num1 - num2));
+    WideResult result = reduceExact(num1 - num2, new_denominator, overflow);
+    countFraction(FractionCounter::SubOverflows, result.overflow);
+    if (result.overflow) {
+        ARIEL_FRACTION_PROBE5(overflow, '-', left.getNumerator(), left.getDenominator(), right.getNumerator(), right.getDenominator());
     }
+    return result;
+}
 
-    if ((numerator != 0) && (other.numerator != 0))
-    {
-    // Check for potential integer overflow during multiplication.
-        if ((abs(numerator) > std::numeric_limits<int>::max() / abs(other.denominator)) ||
-        (abs(denominator) > std::numeric_limits<int>::max() / abs(other.numerator))) {
-            throw std::overflow_error("Multiplication the numerators would result in integer overflow!");
-        }
+/**
+ * @brief Multiply two fractions exactly in 64 bits.
+ * @param left The first factor.
+ * @param right The second factor.
+ * @return The reduced product, flagged as overflow if either the numerator or the denominator product leaves the int range.
+ */
+WideResult ariel::wide_mul(const Fraction& left, const Fraction& right) {
+    bool overflow = (left.getNumerator() != 0) & (right.getNumerator() != 0) &
+    (productOverflows(left.getNumerator(), right.getNumerator()) | productOverflows(left.getDenominator(), right.getDenominator()));
+    WideResult result = reduceExact(static_cast<long long>(left.getNumerator()) * right.getNumerator(),
+                                    static_cast<long long>(left.getDenominator()) * right.getDenominator(), overflow);
+    countFraction(FractionCounter::MulOverflows, result.overflow);
+    if (result.overflow) {
+        ARIEL_FRACTION_PROBE5(overflow, '*', left.getNumerator(), left.getDenominator(), right.getNumerator(), right.getDenominator());
     }
-
-    // Calculate the new numerator and denominator after division.
-    int new_numerator = numerator * other.denominator;
-    int new_denominator = denominator * other.numerator;
-
-    return Fraction(new_numerator, new_denominator);
+    return result;
 }
 
 /**
- * @brief This method checks whether the current fraction is equal to the other fraction.
- * @param other The fraction to compare with the current fraction.
- * @return true if the fractions are equal, false otherwise.
-*/
-bool Fraction::operator==(const Fraction& other) const {
-    // Convert both fractions to floating-point numbers for comparison.
-    float num1 = ((float)numerator / denominator);
-    float num2 = ((float)other.numerator / other.denominator);
-
-    // Check if the difference between the fractions is within a small tolerance.
-    if (num1 > num2) {
-        return (num1 - num2) < 0.001;
-    }
-    else {
-        return (num2 - num1) < 0.001;
-    }
+ * @brief Divide two fractions exactly in 64 bits.
+ * @param left The dividend.
+ * @param right The divisor.
+ * @return The reduced quotient, flagged as overflow if a cross product leaves the int range,
+ * or flagged as divideByZero with the sign of left as its numerator if right is zero.
+ */
+WideResult ariel::wide_div(const Fraction& left, const Fraction& right) {
+    return divideExact(left, right);
 }
 
 /**
- * @brief This method checks whether the current fraction is not equal to the other fraction.
- * @param other The fraction to compare with the current fraction.
- * @return true if the fractions are not equal, false if they are equal.
-*/
-bool Fraction::operator!=(const Fraction& other) const {
-    return !(*this == other);
+ * @brief Add two fractions without throwing.
+ * @param left The first addend.
+ * @param right The second addend.
+ * @return The reduced sum, or FracError::Overflow under the rules of wide_add.
+ */
+FractionResult ariel::checked_add(const Fraction& left, const Fraction& right) {
+    return toResult(wide_add(left, right));
 }
 
 /**
- * @brief This method checks whether the current fraction is greater than the other fraction.
- * @param other The fraction to compare with the current fraction.
- * @return true if the current fraction is greater than the other fraction, false otherwise.
-*/
-bool Fraction::operator>(const Fraction& other) const {
-    return numerator * other.denominator > other.numerator * denominator;
+ * @brief Subtract two fractions without throwing.
+ * @param left The minuend.
+ * @param right The subtrahend.
+ * @return The reduced difference, or FracError::Overflow under the rules of wide_sub.
+ */
+FractionResult ariel::checked_sub(const Fraction& left, const Fraction& right) {
+    return toResult(wide_sub(left, right));
 }
 
 /**
- * @brief This method checks whether the current fraction is less than the other fraction.
- * @param other The fraction to compare with the current fraction.
- * @return true if the current fraction is less than the other fraction, false otherwise.
-*/
-bool Fraction::operator<(const Fraction& other) const {
-    return numerator * other.denominator < other.numerator * denominator;
+ * @brief Multiply two fractions without throwing.
+ * @param left The first factor.
+ * @param right The second factor.
+ * @return The reduced product, or FracError::Overflow under the rules of wide_mul.
+ */
+FractionResult ariel::checked_mul(const Fraction& left, const Fraction& right) {
+    return toResult(wide_mul(left, right));
 }
 
 /**
- * @brief This method checks whether the current fraction is greater than or equal to the other fraction.
- * @param other The fraction to compare with the current fraction.
- * @return true if the current fraction is greater than or equal to the other fraction, false otherwise.
-*/
-bool Fraction::operator>=(const Fraction& other) const {
-    return !(*this < other);
+ * @brief Divide two fractions without throwing.
+ * @param left The dividend.
+ * @param right The divisor.
+ * @return The reduced quotient, FracError::DivideByZero if right is zero, or FracError::Overflow under the rules of wide_div.
+ */
+FractionResult ariel::checked_div(const Fraction& left, const Fraction& right) {
+    return toResult(divideExact(left, right));
 }
 
 /**
- * @brief This method checks whether the current fraction is less than or equal to the other fraction.
- * @param other The fraction to compare with the current fraction.
- * @return true if the current fraction is less than or equal to the other fraction, false otherwise.
-*/
-bool Fraction::operator<=(const Fraction& other) const {
-    return !(*this > other);
+ * @brief Raise a fraction to an integer power. The numerator and denominator are powered separately
+ * by squaring; powers of coprime integers stay coprime, so the result needs no gcd.
+ * @param base The fraction to raise.
+ * @param exponent The power; negative powers raise the reciprocal, and any fraction to the 0 is 1.
+ * @return The reduced power.
+ * @throws runtime_error If base is zero and exponent is negative.
+ * @throws overflow_error If the numerator or denominator of the result does not fit in int.
+ */
+Fraction ariel::pow(const Fraction& base, int exponent) {
+    unsigned long long numerator = static_cast<unsigned long long>(llabs(base.getNumerator()));
+    unsigned long long denominator = static_cast<unsigned long long>(base.getDenominator());
+    bool negative = base.getNumerator() < 0 && (exponent & 1) != 0;
+    if (exponent < 0) {
+        if (numerator == 0) {
+            throw runtime_error("Cannot divide by zero");
+        }
+        swap(numerator, denominator);
+    }
+    unsigned long long magnitude = exponent < 0 ? 0 - static_cast<unsigned long long>(static_cast<long long>(exponent)) : static_cast<unsigned long long>(exponent);
+    unsigned long long numeratorPower = 0;
+    unsigned long long denominatorPower = 0;
+    if (!powerFits(numerator, magnitude, numeratorPower) || !powerFits(denominator, magnitude, denominatorPower)) {
+        throw overflow_error("Raising the fraction to this power would result in integer overflow!");
+    }
+    int result = static_cast<int>(numeratorPower);
+    return Fraction::fromReduced(negative ? -result : result, static_cast<int>(denominatorPower));
 }
 
 /**
- * @brief This method overloads the pre-increment operator '++' for the Fraction class.
- * @return The fraction after incrementing its numerator by the value of the denominator.
+ * @brief Addition operator overload for Fraction class.
+ * @param other The Fraction object to be added to this Fraction object.
+ * @return A new Fraction object that represents the result of adding this and other.
+ * @throw std::overflow_error if the addition results in integer overflow.
 */
-Fraction Fraction::operator++() {
-    numerator += denominator;
-return *this;
+Fraction Fraction::operator+(const Fraction& other) const {
+    profileFraction(ProfiledOp::Add, *this, other);
+    return FractionArithmetic<ThrowPolicy>::add(*this, other);
 }
 
 /**
- * @brief This method overloads the post-increment operator '++' for the Fraction class.
- * @param int Dummy parameter to differentiate from the pre-increment operator.
- * @return A copy of the fraction before incrementing, followed by incrementing its numerator by the value of the denominator.
+ * @brief Subtraction operator overload for Fraction class.
+ * @param other The Fraction object to be subtracted from this Fraction object.
+ * @return A new Fraction object that represents the result of subtracting other from this.
+ * @throw std::overflow_error if the subtraction results in integer overflow.
 */
-Fraction Fraction::operator++(int) {
-    Fraction temp(*this);
-    ++(*this);
-    return temp;
+Fraction Fraction::operator-(const Fraction& other) const {
+    profileFraction(ProfiledOp::Sub, *this, other);
+    return FractionArithmetic<ThrowPolicy>::sub(*this, other);
 }
 
+
 /**
- * @brief This method overloads the pre-decrement operator '--' for the Fraction class.
- * @return The fraction after decrementing its numerator by the value of the denominator.
-*/
-Fraction Fraction::operator--() {
-    numerator -= denominator;
-    return *this;
+ * @brief This method overloads the multiplication operator '*' for the Fraction class.
+ * @param other The fraction to multiply with the current fraction.
+ * @return The result of multiplying the current fraction with the other fraction.
+ * @throws std::overflow_error if the operation would result in an integer overflow.
+ */
+Fraction Fraction::operator*(const Fraction& other) const {
+    profileFraction(ProfiledOp::Mul, *this, other);
+    return FractionArithmetic<ThrowPolicy>::mul(*this, other);
 }
 
 /**
- * @brief This method overloads the post-decrement operator '--' for the Fraction class.
- * @param int Dummy parameter to differentiate from the pre-decrement operator.
- * @return A copy of the fraction before decrementing, followed by decrementing its numerator by the value of the denominator.
+ * @brief This method overloads the division operator '/' for the Fraction class.
+ * @param other The fraction to divide the current fraction by.
+ * @return The result of dividing the current fraction by the other fraction.
+ * @throws std::runtime_error if attempting to divide by zero.
+ * @throws std::overflow_error if the operation would result in an integer overflow.
 */
-Fraction Fraction::operator--(int) {
-    Fraction temp(*this);
-    --(*this);
-    return temp;
+Fraction Fraction::operator/(const Fraction& other) const {
+    profileFraction(ProfiledOp::Div, *this, other);
+    return ThrowPolicy::apply(divideExact(*this, other));
 }
 
 /**
@@ -332,22 +365,29 @@ std::ostream& ariel::operator<<(std::ostream& outs, const Fraction& fraction) {
 std::istream& ariel::operator>>(std::istream& ins, Fraction& fraction) {
     int denominator;
     char slash;
+    countFraction(FractionCounter::Parses);
 
     // Read the numerator
     ins >> fraction.numerator;
     if (ins.peek() == '.') {
+        countFraction(FractionCounter::ParseErrors);
+        ARIEL_FRACTION_PROBE1(parse_error, "Operator with floating-point can't be input");
         throw std::runtime_error("Operator with floating-point can't be input");
     }
 
     ins.ignore(1);
     // Check if the next character is a slash
     if (ins.fail()) {
+        countFraction(FractionCounter::ParseErrors);
+        ARIEL_FRACTION_PROBE1(parse_error, "Invalid input format");
         throw std::runtime_error("Invalid input format");
     }
 
     // Read the denominator
     ins >> denominator;
     if (denominator == 0) {
+        countFraction(FractionCounter::ParseErrors);
+        ARIEL_FRACTION_PROBE1(parse_error, "Denominator cannot be zero");
         throw std::runtime_error("Denominator cannot be zero");
     }
 
@@ -386,9 +426,7 @@ Fraction ariel::operator-(const float number, const Fraction& other) {
 */
 Fraction ariel::operator*(const float number, const Fraction& other) {
     Fraction num(number);
-    int new_numerator = num.numerator * other.numerator;
-    int new_denominator = num.denominator * other.denominator;
-    return Fraction(new_numerator, new_denominator);
+    return num * other;
 }
 
 /**
@@ -399,9 +437,7 @@ Fraction ariel::operator*(const float number, const Fraction& other) {
 */
 Fraction ariel::operator/(const float number, const Fraction& other) {
     Fraction num(number);
-    int new_numerator = num.numerator * other.denominator;
-    int new_denominator = num.denominator * other.numerator;
-    return Fraction(new_numerator, new_denominator);
+    return num / other;
 }
 
 /**
@@ -441,7 +477,7 @@ bool ariel::operator!=(const float number, const Fraction& other) {
 */
 bool ariel::operator>(const float number, const Fraction& other) {
     Fraction num(number);
-    return num.numerator * other.denominator > other.numerator * num.denominator;
+    return static_cast<long long>(num.numerator) * other.denominator > static_cast<long long>(other.numerator) * num.denominator;
 }
 
 /**
@@ -452,7 +488,7 @@ bool ariel::operator>(const float number, const Fraction& other) {
 */
 bool ariel::operator<(const float number, const Fraction& other) {
     Fraction num(number);
-    return num.numerator * other.denominator < other.numerator * num.denominator;
+    return static_cast<long long>(num.numerator) * other.denominator < static_cast<long long>(other.numerator) * num.denominator;
 }
 
 /**
@@ -2,9 +2,19 @@
 #define FRACTION_HPP
 
 #include <iostream>
+#include "Expected.hpp"
 
 namespace ariel {
 
+    // Why a checked operation produced no Fraction.
+    enum class FracError {
+        Overflow,      // the result, or an intermediate product, does not fit in int
+        DivideByZero   // the divisor is zero
+    };
+
+    class Fraction;
+    using FractionResult = Expected<Fraction, FracError>;
+
     class Fraction {
         private:
             int numerator;
@@ -17,6 +27,7 @@ namespace ariel {
             Fraction();
             Fraction(int numerator, int denominator);
             Fraction(float number);
+            static Fraction fromReduced(int numerator, int denominator);  // no gcd, no checks: caller supplies lowest terms
 
             // getter functions
             int getNumerator() const;
@@ -64,6 +75,23 @@ namespace ariel {
             friend bool operator>=(float, const Fraction& other);
             friend bool operator<=(float, const Fraction& other);
     };
+
+    // non-throwing arithmetic; the Fraction operators throw on the errors these return
+    FractionResult checked_add(const Fraction& left, const Fraction& right);
+    FractionResult checked_sub(const Fraction& left, const Fraction& right);
+    FractionResult checked_mul(const Fraction& left, const Fraction& right);
+    FractionResult checked_div(const Fraction& left, const Fraction& right);
+
+    // integer power by squaring; powers of a reduced fraction stay reduced, so there is no gcd
+    Fraction pow(const Fraction& base, int exponent);
 }
 
+// ARIEL_FRACTION_HEADER_ONLY defines the hot members here so they inline across translation units.
+#ifdef ARIEL_FRACTION_HEADER_ONLY
+#define ARIEL_FRACTION_INLINE inline
+#include "Fraction.ipp"
+#else
+#define ARIEL_FRACTION_INLINE
+#endif
+
 #endif /* FRACTION_HPP */
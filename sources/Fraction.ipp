@@ -0,0 +1,184 @@
+#ifndef FRACTION_IPP
+#define FRACTION_IPP
+
+// The small, hot members of Fraction. Fraction.cpp includes this file out of line by default;
+// defining ARIEL_FRACTION_HEADER_ONLY makes Fraction.hpp include it instead, with every
+// definition marked inline, so callers in other translation units can inline them.
+// The macro must be set the same way for every translation unit, Fraction.cpp included.
+
+#include <limits>
+#include <stdexcept>
+
+namespace ariel {
+
+    // Default constructor
+    /**
+     * @brief Create a new Fraction object with default values.
+     */
+    ARIEL_FRACTION_INLINE Fraction::Fraction() : numerator(0), denominator(1) {}
+
+    // Getter functions
+    /**
+     * @brief Get the numerator of the fraction.
+     * @return The numerator of the fraction.
+     */
+    ARIEL_FRACTION_INLINE int Fraction::getNumerator() const {
+        return numerator;
+    }
+    /**
+     * @brief Get the denominator of the fraction.
+     * @return The denominator of the fraction.
+     */
+    ARIEL_FRACTION_INLINE int Fraction::getDenominator() const {
+        return denominator;
+    }
+
+    // Setter functions
+    /**
+     * @brief Set the numerator of the fraction.
+     * @param num The new numerator value.
+     */
+    ARIEL_FRACTION_INLINE void Fraction::setNumerator(int num) {
+        numerator = num;
+    }
+    /**
+     * @brief Set the denominator of the fraction.
+     * @param num The new denominator value.
+     * @throws invalid_argument If denominator is 0.
+     */
+    ARIEL_FRACTION_INLINE void Fraction::setDenominator(int num) {
+        if (denominator == 0) {
+            throw std::invalid_argument("Denominator cannot be zero");
+        }
+        denominator = num;
+    }
+
+    /**
+     * @brief Create a Fraction from a numerator and denominator already in lowest terms.
+     * @param numerator The numerator of the fraction.
+     * @param denominator The denominator of the fraction; must be positive and coprime to numerator.
+     * @return The fraction, built without a gcd or any validation.
+     */
+    ARIEL_FRACTION_INLINE Fraction Fraction::fromReduced(int numerator, int denominator) {
+        Fraction result;
+        result.numerator = numerator;
+        result.denominator = denominator;
+        return result;
+    }
+
+    /**
+     * @brief This method checks whether the current fraction is equal to the other fraction.
+     * @param other The fraction to compare with the current fraction.
+     * @return true if the fractions are equal, false otherwise.
+    */
+    ARIEL_FRACTION_INLINE bool Fraction::operator==(const Fraction& other) const {
+        // Convert both fractions to floating-point numbers for comparison.
+        float num1 = ((float)numerator / denominator);
+        float num2 = ((float)other.numerator / other.denominator);
+
+        // Check if the difference between the fractions is within a small tolerance.
+        if (num1 > num2) {
+            return (num1 - num2) < 0.001;
+        }
+        else {
+            return (num2 - num1) < 0.001;
+        }
+    }
+
+    /**
+     * @brief This method checks whether the current fraction is not equal to the other fraction.
+     * @param other The fraction to compare with the current fraction.
+     * @return true if the fractions are not equal, false if they are equal.
+    */
+    ARIEL_FRACTION_INLINE bool Fraction::operator!=(const Fraction& other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief This method checks whether the current fraction is greater than the other fraction.
+     * @param other The fraction to compare with the current fraction.
+     * @return true if the current fraction is greater than the other fraction, false otherwise.
+    */
+    ARIEL_FRACTION_INLINE bool Fraction::operator>(const Fraction& other) const {
+        return static_cast<long long>(numerator) * other.denominator > static_cast<long long>(other.numerator) * denominator;
+    }
+
+    /**
+     * @brief This method checks whether the current fraction is less than the other fraction.
+     * @param other The fraction to compare with the current fraction.
+     * @return true if the current fraction is less than the other fraction, false otherwise.
+    */
+    ARIEL_FRACTION_INLINE bool Fraction::operator<(const Fraction& other) const {
+        return static_cast<long long>(numerator) * other.denominator < static_cast<long long>(other.numerator) * denominator;
+    }
+
+    /**
+     * @brief This method checks whether the current fraction is greater than or equal to the other fraction.
+     * @param other The fraction to compare with the current fraction.
+     * @return true if the current fraction is greater than or equal to the other fraction, false otherwise.
+    */
+    ARIEL_FRACTION_INLINE bool Fraction::operator>=(const Fraction& other) const {
+        return !(*this < other);
+    }
+
+    /**
+     * @brief This method checks whether the current fraction is less than or equal to the other fraction.
+     * @param other The fraction to compare with the current fraction.
+     * @return true if the current fraction is less than or equal to the other fraction, false otherwise.
+    */
+    ARIEL_FRACTION_INLINE bool Fraction::operator<=(const Fraction& other) const {
+        return !(*this > other);
+    }
+
+    /**
+     * @brief This method overloads the pre-increment operator '++' for the Fraction class.
+     * @return The fraction after incrementing its numerator by the value of the denominator.
+     * @throws overflow_error If the new numerator would not fit in int; the fraction is left unchanged.
+    */
+    ARIEL_FRACTION_INLINE Fraction Fraction::operator++() {
+        long long result = static_cast<long long>(numerator) + denominator;
+        if (result > std::numeric_limits<int>::max()) {
+            throw std::overflow_error("Incrementing the fraction would result in integer overflow!");
+        }
+        numerator = static_cast<int>(result);
+        return *this;
+    }
+
+    /**
+     * @brief This method overloads the post-increment operator '++' for the Fraction class.
+     * @param int Dummy parameter to differentiate from the pre-increment operator.
+     * @return A copy of the fraction before incrementing, followed by incrementing its numerator by the value of the denominator.
+    */
+    ARIEL_FRACTION_INLINE Fraction Fraction::operator++(int) {
+        Fraction temp(*this);
+        ++(*this);
+        return temp;
+    }
+
+    /**
+     * @brief This method overloads the pre-decrement operator '--' for the Fraction class.
+     * @return The fraction after decrementing its numerator by the value of the denominator.
+     * @throws overflow_error If the new numerator would not fit in int; the fraction is left unchanged.
+    */
+    ARIEL_FRACTION_INLINE Fraction Fraction::operator--() {
+        long long result = static_cast<long long>(numerator) - denominator;
+        if (result < std::numeric_limits<int>::min()) {
+            throw std::overflow_error("Decrementing the fraction would result in integer overflow!");
+        }
+        numerator = static_cast<int>(result);
+        return *this;
+    }
+
+    /**
+     * @brief This method overloads the post-decrement operator '--' for the Fraction class.
+     * @param int Dummy parameter to differentiate from the pre-decrement operator.
+     * @return A copy of the fraction before decrementing, followed by decrementing its numerator by the value of the denominator.
+    */
+    ARIEL_FRACTION_INLINE Fraction Fraction::operator--(int) {
+        Fraction temp(*this);
+        --(*this);
+        return temp;
+    }
+}
+
+#endif /* FRACTION_IPP */
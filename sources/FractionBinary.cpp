@@ -0,0 +1,412 @@
+#include "FractionBinary.hpp"   // Include header file
+#include <array>                // Include std::array
+#include <cstring>              // Include memcpy and memcmp
+#include <limits>               // Include numeric limits
+#include <numeric>              // Include std::gcd
+#include <stdexcept>            // Include exception classes
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+
+    const char MAGIC[4] = {'F', 'R', 'A', 'C'};
+    const uint16_t VERSION = 1;
+    const uint16_t BYTE_ORDER_MARK = 0x0102;
+
+    struct FileHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t byteOrder;
+        uint32_t encoding;
+        uint32_t blockRecords;
+    };
+
+    struct BlockHeader {
+        uint32_t count;
+        uint32_t bytes;      // payload length, before padding
+        uint32_t checksum;   // CRC-32 of the payload
+    };
+
+    // A stream block larger than this is treated as corrupt rather than allocated.
+    const uint32_t MAX_STREAM_BLOCK_BYTES = 64U << 20;
+
+    // A varint record takes two to ten bytes.
+    const uint64_t MIN_VARINT_RECORD = 2;
+    const uint64_t MAX_VARINT_RECORD = 10;
+
+    static_assert(sizeof(FractionRecord) == 8, "FractionRecord must be two packed int32 fields");
+    static_assert(sizeof(FileHeader) == 16 && sizeof(BlockHeader) == 12, "Headers must keep payloads 4-byte aligned");
+
+    // Payloads are padded so the next block header, and fixed records, stay 4-byte aligned.
+    size_t padded(size_t bytes) {
+        return (bytes + 3) & ~static_cast<size_t>(3);
+    }
+
+    array<uint32_t, 256> makeCrcTable() {
+        array<uint32_t, 256> table{};
+        for (uint32_t index = 0; index < 256; ++index) {
+            uint32_t value = index;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1U) ? (0xEDB88320U ^ (value >> 1)) : (value >> 1);
+            }
+            table[index] = value;
+        }
+        return table;
+    }
+
+    uint32_t zigzag(int32_t value) {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+    int32_t unzigzag(uint32_t value) {
+        return static_cast<int32_t>((value >> 1) ^ (~(value & 1U) + 1U));
+    }
+
+    void putVarint(vector<unsigned char>& out, uint32_t value) {
+        while (value >= 0x80U) {
+            out.push_back(static_cast<unsigned char>(value | 0x80U));
+            value >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    const unsigned char* getVarint(const unsigned char* cursor, const unsigned char* end, uint32_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 35 && cursor != end; shift += 7) {
+            unsigned char byte = *cursor++;
+            if (shift == 28 && (byte & 0xF0U) != 0) {
+                // the fifth byte holds only the top four bits; anything more would be shifted out
+                throw runtime_error("Malformed varint in fraction block");
+            }
+            value |= static_cast<uint32_t>(byte & 0x7FU) << shift;
+            if ((byte & 0x80U) == 0) {
+                return cursor;
+            }
+        }
+        throw runtime_error("Truncated varint in fraction block");
+    }
+
+    // Validates a file header and returns the encoding it declares.
+    FractionEncoding checkHeader(const FileHeader& header, const string& source) {
+        if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+            throw runtime_error(source + " is not a version 1 fraction file");
+        }
+        if (header.byteOrder != BYTE_ORDER_MARK) {
+            throw runtime_error(source + " was written with a different byte order");
+        }
+        if (header.encoding > static_cast<uint32_t>(FractionEncoding::Varint)) {
+            throw runtime_error(source + " uses an unknown encoding");
+        }
+        return static_cast<FractionEncoding>(header.encoding);
+    }
+
+    // Whether a block header's payload length is possible for its record count.
+    bool consistentBlock(const BlockHeader& block, FractionEncoding encoding) {
+        uint64_t count = block.count;
+        if (encoding == FractionEncoding::Fixed) {
+            return block.bytes == count * sizeof(FractionRecord);
+        }
+        return count * MIN_VARINT_RECORD <= block.bytes && block.bytes <= count * MAX_VARINT_RECORD;
+    }
+
+    // Decodes the record at cursor and returns the position after it.
+    // Records from other writers may be unreduced or have a negative denominator; they come back in lowest terms.
+    const unsigned char* decodeRecord(const unsigned char* cursor, const unsigned char* end, FractionEncoding encoding, FractionRecord& record) {
+        if (encoding == FractionEncoding::Fixed) {
+            if (end - cursor < static_cast<ptrdiff_t>(sizeof(record))) {
+                throw runtime_error("Truncated record in fraction block");
+            }
+            memcpy(&record, cursor, sizeof(record));
+            cursor += sizeof(record);
+        } else {
+            uint32_t numerator = 0;
+            uint32_t denominator = 0;
+            cursor = getVarint(cursor, end, numerator);
+            cursor = getVarint(cursor, end, denominator);
+            record = {unzigzag(numerator), unzigzag(denominator)};
+        }
+        if (record.denominator == 0) {
+            throw runtime_error("Denominator cannot be zero");
+        }
+        if (record.denominator < 0 || (record.numerator != 1 && record.numerator != -1 && record.denominator != 1)) {
+            long long numerator = record.numerator;
+            long long denominator = record.denominator;
+            long long divisor = gcd(numerator, denominator);
+            numerator /= (denominator < 0) ? -divisor : divisor;
+            denominator /= (denominator < 0) ? -divisor : divisor;
+            if (numerator > numeric_limits<int32_t>::max() || denominator > numeric_limits<int32_t>::max()) {
+                throw runtime_error("Record does not fit in a Fraction");
+            }
+            record = {static_cast<int32_t>(numerator), static_cast<int32_t>(denominator)};
+        }
+        return cursor;
+    }
+}
+
+/**
+ * @brief Compute the CRC-32 (IEEE polynomial) of a byte range.
+ * @param data The bytes to checksum.
+ * @param size The number of bytes.
+ * @return The checksum.
+ */
+uint32_t ariel::crc32(const unsigned char* data, size_t size) {
+    static const array<uint32_t, 256> table = makeCrcTable();
+    uint32_t crc = 0xFFFFFFFFU;
+    for (size_t index = 0; index < size; ++index) {
+        crc = table[(crc ^ data[index]) & 0xFFU] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Start a binary fraction stream by writing its file header.
+ * @param out The stream to write to; it should be opened in binary mode.
+ * @param encoding How records are encoded in this file.
+ * @param blockRecords The number of records per checksummed block.
+ * @throws invalid_argument If blockRecords is 0.
+ */
+FractionWriter::FractionWriter(ostream& out, FractionEncoding encoding, uint32_t blockRecords)
+    : out(out), encoding(encoding), blockRecords(blockRecords), pending(0) {
+    if (blockRecords == 0) {
+        throw std::invalid_argument("Block size cannot be zero");
+    }
+    FileHeader header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.encoding = static_cast<uint32_t>(encoding);
+    header.blockRecords = blockRecords;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+/**
+ * @brief Flush any records still buffered.
+ */
+FractionWriter::~FractionWriter() {
+    finish();
+}
+
+/**
+ * @brief Append one fraction to the stream.
+ * @param fraction The fraction to write.
+ */
+void FractionWriter::write(const Fraction& fraction) {
+    if (encoding == FractionEncoding::Fixed) {
+        FractionRecord record{fraction.getNumerator(), fraction.getDenominator()};
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&record);
+        payload.insert(payload.end(), bytes, bytes + sizeof(record));
+    } else {
+        putVarint(payload, zigzag(fraction.getNumerator()));
+        putVarint(payload, zigzag(fraction.getDenominator()));
+    }
+    if (++pending == blockRecords) {
+        flushBlock();
+    }
+}
+
+/**
+ * @brief Append every fraction of a FractionVector to the stream.
+ * @param fractions The fractions to write, in order.
+ */
+void FractionWriter::write(const FractionVector& fractions) {
+    for (size_t index = 0; index < fractions.size(); ++index) {
+        write(fractions[index]);
+    }
+}
+
+/**
+ * @brief Write out the buffered records as a final, possibly short, block.
+ */
+void FractionWriter::finish() {
+    if (pending > 0) {
+        flushBlock();
+    }
+    out.flush();
+}
+
+/**
+ * @brief Write the buffered records as one block: header, payload, then alignment padding.
+ */
+void FractionWriter::flushBlock() {
+    BlockHeader header{pending, static_cast<uint32_t>(payload.size()), crc32(payload.data(), payload.size())};
+    payload.resize(padded(payload.size()), 0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(payload.data()), static_cast<streamsize>(payload.size()));
+    payload.clear();
+    pending = 0;
+}
+
+/**
+ * @brief Map a binary fraction file and index its blocks.
+ * @param path The file to read.
+ * @param verify Whether to check every block checksum up front.
+ * @throws runtime_error If the file is not a fraction file of this version and byte order, is truncated, or fails a checksum.
+ */
+FractionFileReader::FractionFileReader(const string& path, bool verify) : file(path), fileEncoding(FractionEncoding::Fixed), records(0) {
+    FileHeader header{};
+    if (file.size() < sizeof(header)) {
+        throw std::runtime_error(path + " is too short to be a fraction file");
+    }
+    memcpy(&header, file.data(), sizeof(header));
+    fileEncoding = checkHeader(header, path);
+
+    size_t offset = sizeof(header);
+    while (offset < file.size()) {
+        BlockHeader block{};
+        if (file.size() - offset < sizeof(block)) {
+            throw std::runtime_error(path + " ends inside a block header");
+        }
+        memcpy(&block, file.data() + offset, sizeof(block));
+        offset += sizeof(block);
+        // Every record takes at least two bytes, so the record total stays below the file size.
+        if (file.size() - offset < block.bytes || !consistentBlock(block, fileEncoding)) {
+            throw std::runtime_error(path + " has a truncated or malformed block");
+        }
+        blocks.push_back({offset, block.count, block.bytes, block.checksum});
+        records += block.count;
+        offset += padded(block.bytes);
+        if (verify && !verifyBlock(blocks.size() - 1)) {
+            throw std::runtime_error(path + " fails the checksum of block " + to_string(blocks.size() - 1));
+        }
+    }
+}
+
+/**
+ * @brief Get the encoding of the file.
+ * @return The encoding chosen by the writer.
+ */
+FractionEncoding FractionFileReader::encoding() const {
+    return fileEncoding;
+}
+
+/**
+ * @brief Get the total number of records.
+ * @return The number of fractions in the file.
+ */
+size_t FractionFileReader::size() const {
+    return records;
+}
+
+/**
+ * @brief Get the number of blocks.
+ * @return The number of checksummed blocks in the file.
+ */
+size_t FractionFileReader::blockCount() const {
+    return blocks.size();
+}
+
+/**
+ * @brief Get the number of records in a block.
+ * @param block The block index.
+ * @return The number of fractions stored in the block.
+ */
+size_t FractionFileReader::blockSize(size_t block) const {
+    return blocks.at(block).count;
+}
+
+/**
+ * @brief View the records of a block in place, without copying or checking them.
+ * @param block The block index.
+ * @return A span over the block's records inside the mapping, valid while the reader lives.
+ * @throws logic_error If the file uses the varint encoding, which cannot be viewed in place.
+ */
+span<const FractionRecord> FractionFileReader::recordsOf(size_t block) const {
+    if (fileEncoding != FractionEncoding::Fixed) {
+        throw std::logic_error("Only fixed-width fraction files can be viewed in place");
+    }
+    const Block& entry = blocks.at(block);
+    return {reinterpret_cast<const FractionRecord*>(file.data() + entry.offset), entry.count};
+}
+
+/**
+ * @brief Check a block against its stored checksum.
+ * @param block The block index.
+ * @return true if the payload matches the checksum, false otherwise.
+ */
+bool FractionFileReader::verifyBlock(size_t block) const {
+    const Block& entry = blocks.at(block);
+    return crc32(reinterpret_cast<const unsigned char*>(file.data()) + entry.offset, entry.bytes) == entry.checksum;
+}
+
+/**
+ * @brief Decode every record of the file into a FractionVector.
+ * @return The fractions in file order, in lowest terms with positive denominators.
+ * @throws runtime_error If a record is malformed or has a zero denominator.
+ */
+FractionVector FractionFileReader::readAll() const {
+    FractionVector fractions(records);
+    size_t index = 0;
+    for (size_t block = 0; block < blocks.size(); ++block) {
+        const Block& entry = blocks[block];
+        const auto* cursor = reinterpret_cast<const unsigned char*>(file.data()) + entry.offset;
+        const unsigned char* end = cursor + entry.bytes;
+        for (uint32_t record = 0; record < entry.count; ++record, ++index) {
+            FractionRecord value{};
+            cursor = decodeRecord(cursor, end, fileEncoding, value);
+            fractions.set(index, value.numerator, value.denominator);
+        }
+    }
+    return fractions;
+}
+
+/**
+ * @brief Start reading a binary fraction stream by consuming its file header.
+ * @param in The stream to read from, opened in binary mode.
+ * @throws runtime_error If the stream does not start with a valid fraction file header.
+ * Unlike FractionFileReader this needs only one block in memory at a time, so it
+ * also works on pipes.
+ */
+FractionStreamReader::FractionStreamReader(istream& in)
+    : in(in), streamEncoding(FractionEncoding::Fixed), blockRecords(0), remaining(0), cursor(0) {
+    FileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("Stream is too short to be a fraction file");
+    }
+    streamEncoding = checkHeader(header, "Stream");
+    blockRecords = header.blockRecords;
+}
+
+/**
+ * @brief Get the encoding of the stream.
+ * @return The encoding chosen by the writer.
+ */
+FractionEncoding FractionStreamReader::encoding() const {
+    return streamEncoding;
+}
+
+/**
+ * @brief Read the next record, loading and verifying the next block when needed.
+ * @param record Receives the record, in lowest terms with a positive denominator.
+ * @return true if a record was read, false at the end of the stream.
+ * @throws runtime_error If a block header is implausible (more records than the file header allows, or over
+ * 64 MiB), or a block is truncated, fails its checksum or holds a malformed record.
+ */
+bool FractionStreamReader::next(FractionRecord& record) {
+    while (remaining == 0) {
+        BlockHeader block{};
+        if (!in.read(reinterpret_cast<char*>(&block), sizeof(block))) {
+            if (in.gcount() != 0) {
+                throw std::runtime_error("Stream ends inside a block header");
+            }
+            return false;
+        }
+        if (block.count > blockRecords || block.bytes > MAX_STREAM_BLOCK_BYTES || !consistentBlock(block, streamEncoding)) {
+            throw std::runtime_error("Stream has a malformed block header");
+        }
+        payload.resize(padded(block.bytes));
+        if (!in.read(reinterpret_cast<char*>(payload.data()), static_cast<streamsize>(payload.size()))) {
+            throw std::runtime_error("Stream ends inside a block");
+        }
+        if (crc32(payload.data(), block.bytes) != block.checksum) {
+            throw std::runtime_error("Stream block fails its checksum");
+        }
+        payload.resize(block.bytes);
+        remaining = block.count;
+        cursor = 0;
+    }
+    const unsigned char* begin = payload.data() + cursor;
+    cursor += static_cast<size_t>(decodeRecord(begin, payload.data() + payload.size(), streamEncoding, record) - begin);
+    --remaining;
+    return true;
+}
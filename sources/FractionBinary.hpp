@@ -0,0 +1,107 @@
+#ifndef FRACTIONBINARY_HPP
+#define FRACTIONBINARY_HPP
+
+#include "Fraction.hpp"
+#include "FractionVector.hpp"
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ariel {
+
+    // How the records of a binary fraction file are stored, chosen once per file.
+    enum class FractionEncoding : std::uint32_t {
+        Fixed = 0,   // native-endian int32 numerator/denominator pairs, readable in place
+        Varint = 1   // zigzag varint numerator followed by varint denominator
+    };
+
+    // One stored fraction, laid out like the int fields of Fraction.
+    struct FractionRecord {
+        std::int32_t numerator;
+        std::int32_t denominator;
+    };
+
+    // Streams fractions into the binary format: a file header, then checksummed blocks of records.
+    class FractionWriter {
+        private:
+            std::ostream& out;
+            FractionEncoding encoding;
+            std::uint32_t blockRecords;
+            std::uint32_t pending;
+            std::vector<unsigned char> payload;
+            void flushBlock();
+
+        public:
+            // constructors
+            FractionWriter(std::ostream& out, FractionEncoding encoding = FractionEncoding::Fixed, std::uint32_t blockRecords = 4096);
+            FractionWriter(const FractionWriter&) = delete;
+            FractionWriter& operator=(const FractionWriter&) = delete;
+            ~FractionWriter();
+
+            // write functions
+            void write(const Fraction& fraction);
+            void write(const FractionVector& fractions);
+            void finish();  // flush the partial last block; called by the destructor too
+    };
+
+    // Memory-maps a binary fraction file and exposes its blocks without copying them.
+    class FractionFileReader {
+        private:
+            struct Block {
+                std::size_t offset;  // of the payload within the file
+                std::uint32_t count;
+                std::uint32_t bytes;
+                std::uint32_t checksum;
+            };
+            MappedFile file;
+            FractionEncoding fileEncoding;
+            std::vector<Block> blocks;
+            std::size_t records;
+
+        public:
+            // constructors
+            explicit FractionFileReader(const std::string& path, bool verify = true);
+
+            // getter functions
+            FractionEncoding encoding() const;
+            std::size_t size() const;  // total number of records
+            std::size_t blockCount() const;
+            std::size_t blockSize(std::size_t block) const;
+
+            // record access
+            std::span<const FractionRecord> recordsOf(std::size_t block) const;  // Fixed files only, zero-copy
+            bool verifyBlock(std::size_t block) const;
+            FractionVector readAll() const;
+    };
+
+    // Reads a binary fraction stream record by record, holding one block at a time.
+    class FractionStreamReader {
+        private:
+            std::istream& in;
+            FractionEncoding streamEncoding;
+            std::uint32_t blockRecords;  // the most records a block may hold, from the file header
+            std::vector<unsigned char> payload;
+            std::uint32_t remaining;  // records left in the current block
+            std::size_t cursor;       // offset of the next record in payload
+
+        public:
+            // constructors
+            explicit FractionStreamReader(std::istream& in);
+
+            // getter functions
+            FractionEncoding encoding() const;
+
+            // record access
+            bool next(FractionRecord& record);
+    };
+
+    // CRC-32 (IEEE) of a byte range, as stored in every block header.
+    std::uint32_t crc32(const unsigned char* data, std::size_t size);
+}
+
+#endif /* FRACTIONBINARY_HPP */
@@ -0,0 +1,346 @@
+#include "FractionColumn.hpp"   // Include header file
+#include <algorithm>            // Include std::sort, std::unique and std::lower_bound
+#include <bit>                  // Include std::bit_width
+#include <cstring>              // Include memcpy
+#include <limits>               // Include numeric_limits
+#include <stdexcept>            // Include exception classes
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+
+    // Column header: count, records per block, dictionary size, block count.
+    const size_t HEADER_BYTES = 4 * sizeof(uint32_t);
+    // Block header: run count, the bit widths of dictionary index, run length and residual, then the first numerator.
+    const size_t BLOCK_HEADER_BYTES = 2 * sizeof(uint32_t) + 4;
+
+    uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>((value >> 1) ^ (~(value & 1U) + 1U));
+    }
+
+    // The numerator the previous fraction would have over denominator, rounded down.
+    // Equal denominators predict the previous numerator, so runs reduce to plain deltas.
+    int64_t predict(int64_t previousNumerator, int64_t previousDenominator, int64_t denominator) {
+        if (previousDenominator == denominator || previousDenominator == 0) {
+            return previousNumerator;
+        }
+        int64_t scaled = previousNumerator * denominator;
+        int64_t quotient = scaled / previousDenominator;
+        if ((scaled % previousDenominator != 0) && ((scaled < 0) != (previousDenominator < 0))) {
+            --quotient;
+        }
+        return quotient;
+    }
+
+    uint64_t residual(const int* numerators, const int* denominators, uint32_t index) {
+        return zigzag(numerators[index] - predict(numerators[index - 1], denominators[index - 1], denominators[index]));
+    }
+
+    unsigned char widthOf(uint64_t value) {
+        return static_cast<unsigned char>(bit_width(value));
+    }
+
+    void putWord(vector<unsigned char>& out, uint32_t value) {
+        const auto* raw = reinterpret_cast<const unsigned char*>(&value);
+        out.insert(out.end(), raw, raw + sizeof(value));
+    }
+
+    // Appends fixed-width fields to a stream of 64-bit words, low bits first.
+    class BitWriter {
+        private:
+            vector<uint64_t> words;
+            size_t position = 0;
+
+        public:
+            void write(uint64_t value, unsigned width) {
+                if (width == 0) {
+                    return;
+                }
+                size_t offset = position & 63U;
+                if (offset == 0) {
+                    words.push_back(0);
+                }
+                words.back() |= value << offset;
+                if (offset + width > 64) {
+                    words.push_back(value >> (64 - offset));
+                }
+                position += width;
+            }
+
+            void appendTo(vector<unsigned char>& out) {
+                words.push_back(0);  // lets the reader always load two words
+                const auto* raw = reinterpret_cast<const unsigned char*>(words.data());
+                out.insert(out.end(), raw, raw + words.size() * sizeof(uint64_t));
+            }
+    };
+
+    // Reads fields written by BitWriter, straddling word boundaries as needed.
+    class BitReader {
+        private:
+            const unsigned char* words;
+            size_t position = 0;
+
+            uint64_t word(size_t index) const {
+                uint64_t value = 0;
+                memcpy(&value, words + index * sizeof(uint64_t), sizeof(value));
+                return value;
+            }
+
+        public:
+            explicit BitReader(const unsigned char* words) : words(words) {}
+
+            uint64_t read(unsigned width) {
+                if (width == 0) {
+                    return 0;
+                }
+                size_t index = position >> 6;
+                size_t offset = position & 63U;
+                uint64_t value = word(index) >> offset;
+                if (offset + width > 64) {
+                    value |= word(index + 1) << (64 - offset);
+                }
+                position += width;
+                return (width == 64) ? value : (value & ((uint64_t{1} << width) - 1));
+            }
+    };
+}
+
+/**
+ * @brief Adopt an encoded column, for example one read back from an archive.
+ * @param encoded The bytes produced by encode().
+ * @throws runtime_error If the bytes are too short for the header, dictionary and block table they declare,
+ * or a block offset is out of order or leaves no room for its block.
+ */
+FractionColumn::FractionColumn(vector<unsigned char> encoded) : bytes(std::move(encoded)), count(0), blockRecords(0), dictionarySize(0), blocks(0) {
+    if (bytes.size() < HEADER_BYTES) {
+        throw std::runtime_error("Fraction column is too short");
+    }
+    count = readWord(0);
+    blockRecords = readWord(4);
+    dictionarySize = readWord(8);
+    blocks = readWord(12);
+    size_t tables = HEADER_BYTES + (size_t{dictionarySize} + blocks) * sizeof(uint32_t);
+    if (blockRecords == 0 || bytes.size() < tables || blocks != (uint64_t{count} + blockRecords - 1) / blockRecords) {
+        throw std::runtime_error("Fraction column header is malformed");
+    }
+    // Each block needs its header and at least the trailing zero word, and blocks follow each other in order.
+    size_t previous = tables;
+    for (uint32_t block = 0; block < blocks; ++block) {
+        size_t offset = blockOffset(block);
+        if (offset < previous || bytes.size() - offset < BLOCK_HEADER_BYTES + sizeof(uint64_t)) {
+            throw std::runtime_error("Fraction column block table is malformed");
+        }
+        previous = offset + BLOCK_HEADER_BYTES + sizeof(uint64_t);
+    }
+}
+
+/**
+ * @brief Compress a sequence of fractions into a column.
+ * @param fractions The fractions to encode; runs of equal denominator compress best.
+ * @param blockRecords The number of fractions per independently decodable block.
+ * @return The encoded column.
+ * @throws invalid_argument If blockRecords is 0.
+ */
+FractionColumn FractionColumn::encode(const FractionVector& fractions, uint32_t blockRecords) {
+    if (blockRecords == 0) {
+        throw std::invalid_argument("Block size cannot be zero");
+    }
+    const int* numerators = fractions.numeratorData();
+    const int* denominators = fractions.denominatorData();
+    const auto count = static_cast<uint32_t>(fractions.size());
+
+    vector<int> dictionary(denominators, denominators + count);
+    sort(dictionary.begin(), dictionary.end());
+    dictionary.erase(unique(dictionary.begin(), dictionary.end()), dictionary.end());
+    auto indexOf = [&](int denominator) {
+        return static_cast<uint64_t>(lower_bound(dictionary.begin(), dictionary.end(), denominator) - dictionary.begin());
+    };
+
+    const uint32_t blockCount = (count + blockRecords - 1) / blockRecords;
+    vector<unsigned char> out;
+    putWord(out, count);
+    putWord(out, blockRecords);
+    putWord(out, static_cast<uint32_t>(dictionary.size()));
+    putWord(out, blockCount);
+    for (int denominator : dictionary) {
+        putWord(out, static_cast<uint32_t>(denominator));
+    }
+    const size_t offsetTable = out.size();
+    out.resize(out.size() + size_t{blockCount} * sizeof(uint32_t));
+
+    const unsigned char indexBits = widthOf(dictionary.empty() ? 0 : dictionary.size() - 1);
+    for (uint32_t block = 0; block < blockCount; ++block) {
+        const uint32_t begin = block * blockRecords;
+        const uint32_t end = min(count, begin + blockRecords);
+
+        // First pass: the widest value of every field decides its packed width.
+        uint32_t runs = 0;
+        uint64_t maxLength = 0;
+        uint64_t maxResidual = 0;
+        for (uint32_t first = begin; first < end;) {
+            uint32_t last = first + 1;
+            while (last < end && denominators[last] == denominators[first]) {
+                ++last;
+            }
+            maxLength = max<uint64_t>(maxLength, last - first - 1);
+            ++runs;
+            first = last;
+        }
+        for (uint32_t index = begin + 1; index < end; ++index) {
+            maxResidual = max(maxResidual, residual(numerators, denominators, index));
+        }
+        const unsigned char lengthBits = widthOf(maxLength);
+        const unsigned char residualBits = widthOf(maxResidual);
+
+        // Second pass: run headers interleaved with the residuals of the records they open.
+        auto offset = static_cast<uint32_t>(out.size());
+        memcpy(out.data() + offsetTable + block * sizeof(uint32_t), &offset, sizeof(offset));
+        putWord(out, runs);
+        out.insert(out.end(), {indexBits, lengthBits, residualBits, 0});
+        putWord(out, static_cast<uint32_t>(numerators[begin]));
+        BitWriter writer;
+        for (uint32_t first = begin; first < end;) {
+            uint32_t last = first + 1;
+            while (last < end && denominators[last] == denominators[first]) {
+                ++last;
+            }
+            writer.write(indexOf(denominators[first]), indexBits);
+            writer.write(last - first - 1, lengthBits);
+            for (uint32_t index = max(first, begin + 1); index < last; ++index) {
+                writer.write(residual(numerators, denominators, index), residualBits);
+            }
+            first = last;
+        }
+        writer.appendTo(out);
+    }
+    return FractionColumn(std::move(out));
+}
+
+/**
+ * @brief Read a 32-bit header word.
+ * @param offset The byte offset of the word.
+ * @return The word.
+ */
+uint32_t FractionColumn::readWord(size_t offset) const {
+    uint32_t value = 0;
+    memcpy(&value, bytes.data() + offset, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Read a block's offset from the block table.
+ * @param block The block index, below blocks.
+ * @return The byte offset of the block header.
+ */
+size_t FractionColumn::blockOffset(size_t block) const {
+    return readWord(HEADER_BYTES + (dictionarySize + block) * sizeof(uint32_t));
+}
+
+/**
+ * @brief Get the encoded bytes.
+ * @return The bytes to archive; FractionColumn(bytes) restores the column.
+ */
+const vector<unsigned char>& FractionColumn::data() const {
+    return bytes;
+}
+
+/**
+ * @brief Get the number of fractions in the column.
+ * @return The number of encoded fractions.
+ */
+size_t FractionColumn::size() const {
+    return count;
+}
+
+/**
+ * @brief Get the number of blocks.
+ * @return The number of independently decodable blocks.
+ */
+size_t FractionColumn::blockCount() const {
+    return blocks;
+}
+
+/**
+ * @brief Get the number of fractions in a block.
+ * @param block The block index.
+ * @return The number of fractions the block decodes to.
+ * @throws out_of_range If block is not a valid block index.
+ */
+size_t FractionColumn::blockSize(size_t block) const {
+    if (block >= blocks) {
+        throw std::out_of_range("Block index out of range");
+    }
+    return min<size_t>(blockRecords, count - block * blockRecords);
+}
+
+/**
+ * @brief Decode one block without touching the others.
+ * @param block The block index.
+ * @param numerators Receives blockSize(block) numerators.
+ * @param denominators Receives blockSize(block) denominators.
+ * @throws out_of_range If block is not a valid block index.
+ * @throws runtime_error If the block refers past the end of the dictionary, declares more bits than it holds
+ * or decodes a numerator outside the range of int.
+ */
+void FractionColumn::decodeBlock(size_t block, int* numerators, int* denominators) const {
+    const size_t records = blockSize(block);
+    const size_t offset = blockOffset(block);
+    const uint32_t runs = readWord(offset);
+    const unsigned char* widths = bytes.data() + offset + sizeof(uint32_t);
+    const unsigned indexBits = widths[0];
+    const unsigned lengthBits = widths[1];
+    const unsigned residualBits = widths[2];
+
+    // The reader loads one word past the last field, which the encoder pads with a zero word.
+    const size_t end = (block + 1 < blocks) ? blockOffset(block + 1) : bytes.size();
+    const size_t words = (end - offset - BLOCK_HEADER_BYTES) / sizeof(uint64_t);
+    const uint64_t bits = uint64_t{runs} * (indexBits + lengthBits) + (records - 1) * uint64_t{residualBits};
+    if (indexBits > 64 || lengthBits > 64 || residualBits > 64 || runs > records || bits > (words - 1) * uint64_t{64}) {
+        throw std::runtime_error("Fraction column block is malformed");
+    }
+
+    BitReader reader(bytes.data() + offset + BLOCK_HEADER_BYTES);
+    int64_t previousNumerator = static_cast<int>(readWord(offset + BLOCK_HEADER_BYTES - sizeof(uint32_t)));
+    int64_t previousDenominator = 0;
+    size_t index = 0;
+    for (uint32_t run = 0; run < runs && index < records; ++run) {
+        const uint64_t entry = reader.read(indexBits);
+        if (entry >= dictionarySize) {
+            throw std::runtime_error("Fraction column block is malformed");
+        }
+        const int denominator = static_cast<int>(readWord(HEADER_BYTES + entry * sizeof(uint32_t)));
+        const size_t length = reader.read(lengthBits) + 1;
+        for (size_t step = 0; step < length && index < records; ++step, ++index) {
+            // A corrupt residual can be up to 64 bits wide; the sum must neither overflow nor leave int,
+            // since the next prediction multiplies it by a denominator.
+            if (index > 0 && (__builtin_add_overflow(predict(previousNumerator, previousDenominator, denominator), unzigzag(reader.read(residualBits)), &previousNumerator) ||
+                              previousNumerator < numeric_limits<int>::min() || previousNumerator > numeric_limits<int>::max())) {
+                throw std::runtime_error("Fraction column block is malformed");
+            }
+            previousDenominator = denominator;
+            numerators[index] = static_cast<int>(previousNumerator);
+            denominators[index] = denominator;
+        }
+    }
+    if (index < records) {
+        throw std::runtime_error("Fraction column block is malformed");
+    }
+}
+
+/**
+ * @brief Decode the whole column.
+ * @return The fractions, in their original order.
+ */
+FractionVector FractionColumn::decode() const {
+    FractionVector fractions(count);
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t first = block * blockRecords;
+        decodeBlock(block, fractions.numeratorData() + first, fractions.denominatorData() + first);
+    }
+    return fractions;
+}
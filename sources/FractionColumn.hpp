@@ -0,0 +1,45 @@
+#ifndef FRACTIONCOLUMN_HPP
+#define FRACTIONCOLUMN_HPP
+
+#include "FractionVector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ariel {
+
+    // A compressed, immutable column of fractions that decodes one block at a time.
+    //
+    // Denominators are dictionary-encoded and grouped into runs of equal
+    // denominator. Each numerator is stored as its difference from the
+    // previous fraction rescaled to its denominator, which is a plain delta
+    // inside a run and stays small across runs when the column is sorted.
+    // Every field of a block is bit-packed at the narrowest width it needs.
+    class FractionColumn {
+        private:
+            std::vector<unsigned char> bytes;
+            std::uint32_t count;
+            std::uint32_t blockRecords;
+            std::uint32_t dictionarySize;
+            std::uint32_t blocks;
+            std::uint32_t readWord(std::size_t offset) const;
+            std::size_t blockOffset(std::size_t block) const;
+
+        public:
+            // constructors
+            explicit FractionColumn(std::vector<unsigned char> encoded);  // adopt bytes produced by encode(); throws std::runtime_error if malformed
+            static FractionColumn encode(const FractionVector& fractions, std::uint32_t blockRecords = 1024);
+
+            // getter functions
+            const std::vector<unsigned char>& data() const;
+            std::size_t size() const;
+            std::size_t blockCount() const;
+            std::size_t blockSize(std::size_t block) const;
+
+            // decoding
+            void decodeBlock(std::size_t block, int* numerators, int* denominators) const;
+            FractionVector decode() const;
+    };
+}
+
+#endif /* FRACTIONCOLUMN_HPP */
@@ -0,0 +1,44 @@
+#include "FractionCounters.hpp"   // Include header file
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+#ifdef ARIEL_FRACTION_STATS
+detail::PaddedCounter ariel::detail::fractionCounters[static_cast<size_t>(detail::FractionCounter::Count)];
+#endif
+
+namespace {
+    uint64_t read(detail::FractionCounter counter) {
+#ifdef ARIEL_FRACTION_STATS
+        return detail::fractionCounters[static_cast<size_t>(counter)].value.load(memory_order_relaxed);
+#else
+        (void)counter;
+        return 0;
+#endif
+    }
+}
+
+/**
+ * @brief Take a snapshot of the Fraction operation counters.
+ * @return The current counts; all 0 unless built with ARIEL_FRACTION_STATS.
+ * Counters are read one at a time, so a snapshot taken while other threads
+ * count is not atomic across fields.
+ */
+FractionCounters ariel::fraction_stats() {
+    using detail::FractionCounter;
+    return FractionCounters{read(FractionCounter::GcdCalls), read(FractionCounter::GcdIterations), read(FractionCounter::Normalizations),
+                            read(FractionCounter::AddOverflows), read(FractionCounter::SubOverflows), read(FractionCounter::MulOverflows),
+                            read(FractionCounter::DivOverflows), read(FractionCounter::DivideByZero), read(FractionCounter::FloatConversions),
+                            read(FractionCounter::Parses), read(FractionCounter::ParseErrors)};
+}
+
+/**
+ * @brief Zero every Fraction operation counter.
+ */
+void ariel::reset_fraction_stats() {
+#ifdef ARIEL_FRACTION_STATS
+    for (detail::PaddedCounter& counter : detail::fractionCounters) {
+        counter.value.store(0, memory_order_relaxed);
+    }
+#endif
+}
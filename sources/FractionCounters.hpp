@@ -0,0 +1,72 @@
+#ifndef FRACTIONCOUNTERS_HPP
+#define FRACTIONCOUNTERS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+namespace ariel {
+
+    // A snapshot of the Fraction operation counters. Counting is compiled in only when every
+    // translation unit is built with ARIEL_FRACTION_STATS; otherwise every field reads 0.
+    struct FractionCounters {
+        std::uint64_t gcdCalls;          // reductions: constructors, 64-bit cores and parseFraction
+        std::uint64_t gcdIterations;     // remainder steps of Fraction::gcd and of the 64-bit reductions
+        std::uint64_t normalizations;    // Fraction(int, int) constructions
+        std::uint64_t addOverflows;      // overflow checks that fired, per operator, under every policy
+        std::uint64_t subOverflows;
+        std::uint64_t mulOverflows;
+        std::uint64_t divOverflows;
+        std::uint64_t divideByZero;
+        std::uint64_t floatConversions;  // Fraction(float) constructions
+        std::uint64_t parses;            // operator>> and parseFraction calls
+        std::uint64_t parseErrors;
+    };
+
+    // read or zero the counters; both are safe to call while other threads count
+    FractionCounters fraction_stats();
+    void reset_fraction_stats();
+
+    namespace detail {
+        enum class FractionCounter : std::size_t {
+            GcdCalls, GcdIterations, Normalizations, AddOverflows, SubOverflows, MulOverflows, DivOverflows,
+            DivideByZero, FloatConversions, Parses, ParseErrors, Count
+        };
+
+#ifdef ARIEL_FRACTION_STATS
+        // each counter on its own cache line, so threads bumping different counters do not contend
+        struct alignas(64) PaddedCounter {
+            std::atomic<std::uint64_t> value{0};
+        };
+        extern PaddedCounter fractionCounters[static_cast<std::size_t>(FractionCounter::Count)];
+
+        inline void countFraction(FractionCounter counter, std::uint64_t amount = 1) {
+            fractionCounters[static_cast<std::size_t>(counter)].value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        // std::gcd as Euclid's remainder steps, so the 64-bit reductions add to GcdIterations the way
+        // Fraction::gcd does: one step per remainder taken, plus the final test against zero.
+        inline long long countedGcd(long long first, long long second) {
+            unsigned long long smaller = (first < 0) ? 0ULL - static_cast<unsigned long long>(first) : static_cast<unsigned long long>(first);
+            unsigned long long larger = (second < 0) ? 0ULL - static_cast<unsigned long long>(second) : static_cast<unsigned long long>(second);
+            std::uint64_t steps = 1;
+            for (; smaller != 0; ++steps) {
+                larger %= smaller;
+                std::swap(smaller, larger);
+            }
+            countFraction(FractionCounter::GcdIterations, steps);
+            return static_cast<long long>(larger);
+        }
+#else
+        inline void countFraction(FractionCounter, std::uint64_t = 1) {}
+
+        inline long long countedGcd(long long first, long long second) {
+            return std::gcd(first, second);
+        }
+#endif
+    }
+}
+
+#endif /* FRACTIONCOUNTERS_HPP */
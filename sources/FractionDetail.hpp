@@ -0,0 +1,64 @@
+#ifndef FRACTIONDETAIL_HPP
+#define FRACTIONDETAIL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Internal helpers shared by the sources and tools; not part of the public API.
+namespace ariel {
+    namespace detail {
+
+        // Work items per thread when input is split up front, so uneven pieces still balance.
+        inline constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
+        // Greatest common divisor of two 128-bit values. The result is unsigned so that a
+        // magnitude of 2^127 cannot overflow; it is 0 only when both values are 0.
+        inline unsigned __int128 gcdWide(__int128 first, __int128 second) {
+            unsigned __int128 left = first < 0 ? -static_cast<unsigned __int128>(first) : static_cast<unsigned __int128>(first);
+            unsigned __int128 right = second < 0 ? -static_cast<unsigned __int128>(second) : static_cast<unsigned __int128>(second);
+            while (right != 0) {
+                unsigned __int128 rest = left % right;
+                left = right;
+                right = rest;
+            }
+            return left;
+        }
+
+        // Run task(index) for every index in [0, tasks) on up to threads threads, the calling thread
+        // included. Indices are handed out in order from a shared counter. Every index runs even if
+        // some throw; afterwards the exception of the lowest failing index is rethrown.
+        template <typename Task>
+        void runParallel(std::size_t tasks, unsigned threads, Task&& task) {
+            std::vector<std::exception_ptr> errors(tasks);
+            std::atomic<std::size_t> next{0};
+            auto worker = [&]() {
+                for (std::size_t index = next++; index < tasks; index = next++) {
+                    try {
+                        task(index);
+                    } catch (...) {
+                        errors[index] = std::current_exception();
+                    }
+                }
+            };
+            std::vector<std::thread> pool;
+            for (unsigned index = 1; index < std::min<std::size_t>(threads, tasks); ++index) {
+                pool.emplace_back(worker);
+            }
+            worker();
+            for (std::thread& member : pool) {
+                member.join();
+            }
+            for (const std::exception_ptr& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+    }
+}
+
+#endif /* FRACTIONDETAIL_HPP */
@@ -0,0 +1,313 @@
+#include "FractionInterval.hpp"   // Include header file
+#include "FractionDetail.hpp"     // Include detail::gcdWide
+#include <limits>                 // Include numeric limits
+#include <stdexcept>              // Include exception classes
+#include <utility>                // Include std::pair
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+    // An unreduced endpoint; the denominator is always positive.
+    struct Exact {
+        __int128 numerator;
+        __int128 denominator;
+    };
+
+    Exact exact(const Fraction& value) {
+        return Exact{value.getNumerator(), value.getDenominator()};
+    }
+
+    // Terms are at most 2^62 in magnitude, so both cross products fit in 128 bits.
+    bool isLess(const Exact& left, const Exact& right) {
+        return left.numerator * right.denominator < right.numerator * left.denominator;
+    }
+
+    Exact add(const Exact& left, const Exact& right) {
+        return Exact{left.numerator * right.denominator + right.numerator * left.denominator, left.denominator * right.denominator};
+    }
+
+    Exact subtract(const Exact& left, const Exact& right) {
+        return Exact{left.numerator * right.denominator - right.numerator * left.denominator, left.denominator * right.denominator};
+    }
+
+    Exact multiply(const Exact& left, const Exact& right) {
+        return Exact{left.numerator * right.numerator, left.denominator * right.denominator};
+    }
+
+    Exact divide(const Exact& left, const Exact& right) {
+        __int128 sign = right.numerator < 0 ? -1 : 1;
+        return Exact{sign * left.numerator * right.denominator, sign * left.denominator * right.numerator};
+    }
+
+    bool fitsInt(__int128 value) {
+        return value >= numeric_limits<int>::min() && value <= numeric_limits<int>::max();
+    }
+
+    __int128 floorDivide(__int128 numerator, __int128 denominator) {
+        __int128 quotient = numerator / denominator;
+        return (numerator % denominator < 0) ? quotient - 1 : quotient;
+    }
+
+    /**
+     * @brief Round numerator/denominator (in lowest terms) to a neighbour with denominator <= bound.
+     * The last convergent within the bound and the largest semiconvergent after it lie on opposite
+     * sides of the value with nothing of denominator <= bound between them, so one is the floor
+     * and the other the ceiling.
+     * @param up true for the ceiling, false for the floor.
+     * @return The rounded endpoint.
+     * @throws overflow_error If its numerator does not fit in int.
+     */
+    Fraction roundToBound(__int128 numerator, __int128 denominator, int bound, bool up) {
+        __int128 term = floorDivide(numerator, denominator);
+        __int128 rest = numerator - term * denominator;
+        __int128 convergentNumerator = term, previousNumerator = 1;
+        __int128 convergentDenominator = 1, previousDenominator = 0;
+        Exact result{convergentNumerator, convergentDenominator};
+        for (;;) {
+            numerator = denominator;
+            denominator = rest;
+            if (denominator == 0) {  // the value itself is within the bound
+                result = Exact{convergentNumerator, convergentDenominator};
+                break;
+            }
+            term = numerator / denominator;
+            rest = numerator - term * denominator;
+            __int128 nextDenominator = term * convergentDenominator + previousDenominator;
+            if (nextDenominator > bound) {
+                __int128 steps = (bound - previousDenominator) / convergentDenominator;
+                Exact convergent{convergentNumerator, convergentDenominator};
+                Exact semiconvergent{previousNumerator + steps * convergentNumerator, previousDenominator + steps * convergentDenominator};
+                bool semiconvergentBelow = isLess(semiconvergent, convergent);
+                result = (up == semiconvergentBelow) ? convergent : semiconvergent;
+                break;
+            }
+            __int128 nextNumerator = term * convergentNumerator + previousNumerator;
+            previousNumerator = convergentNumerator;
+            convergentNumerator = nextNumerator;
+            previousDenominator = convergentDenominator;
+            convergentDenominator = nextDenominator;
+        }
+        if (!fitsInt(result.numerator)) {
+            throw overflow_error("Interval endpoint would result in integer overflow!");
+        }
+        return Fraction::fromReduced(static_cast<int>(result.numerator), static_cast<int>(result.denominator));
+    }
+
+    /**
+     * @brief Reduce an endpoint once, rounding it outward when it exceeds the bound.
+     * @param bound The largest allowed denominator, or 0 for exact endpoints.
+     * @param up true for an upper endpoint, false for a lower one.
+     * @return The endpoint as a Fraction.
+     * @throws overflow_error If the endpoint cannot be represented.
+     */
+    Fraction finish(Exact value, int bound, bool up) {
+        auto divisor = static_cast<__int128>(detail::gcdWide(value.numerator, value.denominator));
+        value.numerator /= divisor;
+        value.denominator /= divisor;
+        if (fitsInt(value.numerator) && value.denominator <= (bound == 0 ? numeric_limits<int>::max() : bound)) {
+            return Fraction::fromReduced(static_cast<int>(value.numerator), static_cast<int>(value.denominator));
+        }
+        if (bound == 0) {
+            throw overflow_error("Interval endpoint would result in integer overflow!");
+        }
+        return roundToBound(value.numerator, value.denominator, bound, up);
+    }
+
+    // The smallest and largest of four candidate endpoints, compared exactly.
+    pair<Exact, Exact> extremes(const Exact (&candidates)[4]) {
+        Exact smallest = candidates[0];
+        Exact largest = candidates[0];
+        for (const Exact& candidate : candidates) {
+            smallest = isLess(candidate, smallest) ? candidate : smallest;
+            largest = isLess(largest, candidate) ? candidate : largest;
+        }
+        return {smallest, largest};
+    }
+
+    int combinedBound(int left, int right) {
+        if (left == 0 || right == 0) {
+            return left == 0 ? right : left;
+        }
+        return left < right ? left : right;
+    }
+}
+
+/**
+ * @brief Create the interval [0, 0].
+ */
+FractionInterval::FractionInterval() : lower(), upper(), maxDenominator(0) {}
+
+/**
+ * @brief Create the interval holding a single value.
+ * @param point The value.
+ */
+FractionInterval::FractionInterval(const Fraction& point) : lower(point), upper(point), maxDenominator(0) {}
+
+/**
+ * @brief Create the interval [lower, upper].
+ * @param lower The lower endpoint.
+ * @param upper The upper endpoint.
+ * @throws invalid_argument If lower > upper.
+ */
+FractionInterval::FractionInterval(const Fraction& lower, const Fraction& upper) : lower(lower), upper(upper), maxDenominator(0) {
+    if (lower > upper) {
+        throw invalid_argument("Lower endpoint cannot exceed the upper endpoint");
+    }
+}
+
+/**
+ * @brief Get the lower endpoint.
+ * @return The lower endpoint.
+ */
+Fraction FractionInterval::getLower() const {
+    return lower;
+}
+
+/**
+ * @brief Get the upper endpoint.
+ * @return The upper endpoint.
+ */
+Fraction FractionInterval::getUpper() const {
+    return upper;
+}
+
+/**
+ * @brief Get the denominator bound results are widened to.
+ * @return The bound, or 0 if endpoints are kept exact.
+ */
+int FractionInterval::getMaxDenominator() const {
+    return maxDenominator;
+}
+
+/**
+ * @brief Switch to bounded endpoints, rounding the current ones outward.
+ * @param maxDenominator The largest denominator an endpoint may have.
+ * @return The widened interval; it contains this one.
+ * @throws invalid_argument If maxDenominator is less than 1.
+ * @throws overflow_error If a rounded endpoint's numerator does not fit in int.
+ */
+FractionInterval FractionInterval::widened(int maxDenominator) const {
+    if (maxDenominator < 1) {
+        throw invalid_argument("Maximum denominator must be at least 1");
+    }
+    FractionInterval result(finish(exact(lower), maxDenominator, false), finish(exact(upper), maxDenominator, true));
+    result.maxDenominator = maxDenominator;
+    return result;
+}
+
+/**
+ * @brief Add two intervals: [a + c, b + d].
+ * @param other The interval to add.
+ * @return The sum.
+ * @throws overflow_error If an exact endpoint does not fit in int.
+ */
+FractionInterval FractionInterval::operator+(const FractionInterval& other) const {
+    int bound = combinedBound(maxDenominator, other.maxDenominator);
+    FractionInterval result(finish(add(exact(lower), exact(other.lower)), bound, false), finish(add(exact(upper), exact(other.upper)), bound, true));
+    result.maxDenominator = bound;
+    return result;
+}
+
+/**
+ * @brief Subtract two intervals: [a - d, b - c].
+ * @param other The interval to subtract.
+ * @return The difference.
+ * @throws overflow_error If an exact endpoint does not fit in int.
+ */
+FractionInterval FractionInterval::operator-(const FractionInterval& other) const {
+    int bound = combinedBound(maxDenominator, other.maxDenominator);
+    FractionInterval result(finish(subtract(exact(lower), exact(other.upper)), bound, false),
+                            finish(subtract(exact(upper), exact(other.lower)), bound, true));
+    result.maxDenominator = bound;
+    return result;
+}
+
+/**
+ * @brief Multiply two intervals. The four endpoint products are formed unreduced, compared
+ * exactly, and only the smallest and largest are reduced.
+ * @param other The interval to multiply by.
+ * @return The product.
+ * @throws overflow_error If an exact endpoint does not fit in int.
+ */
+FractionInterval FractionInterval::operator*(const FractionInterval& other) const {
+    Exact products[4] = {multiply(exact(lower), exact(other.lower)), multiply(exact(lower), exact(other.upper)),
+                         multiply(exact(upper), exact(other.lower)), multiply(exact(upper), exact(other.upper))};
+    auto [smallest, largest] = extremes(products);
+    int bound = combinedBound(maxDenominator, other.maxDenominator);
+    FractionInterval result(finish(smallest, bound, false), finish(largest, bound, true));
+    result.maxDenominator = bound;
+    return result;
+}
+
+/**
+ * @brief Divide two intervals, the same way as multiplication by the reciprocal endpoints.
+ * @param other The interval to divide by.
+ * @return The quotient.
+ * @throws runtime_error If other contains zero.
+ * @throws overflow_error If an exact endpoint does not fit in int.
+ */
+FractionInterval FractionInterval::operator/(const FractionInterval& other) const {
+    if (other.lower.getNumerator() <= 0 && other.upper.getNumerator() >= 0) {
+        throw runtime_error("Cannot divide by zero");
+    }
+    Exact quotients[4] = {divide(exact(lower), exact(other.lower)), divide(exact(lower), exact(other.upper)),
+                          divide(exact(upper), exact(other.lower)), divide(exact(upper), exact(other.upper))};
+    auto [smallest, largest] = extremes(quotients);
+    int bound = combinedBound(maxDenominator, other.maxDenominator);
+    FractionInterval result(finish(smallest, bound, false), finish(largest, bound, true));
+    result.maxDenominator = bound;
+    return result;
+}
+
+/**
+ * @brief Check whether a value lies in the interval.
+ * @param value The value.
+ * @return true if lower <= value <= upper, false otherwise.
+ */
+bool FractionInterval::contains(const Fraction& value) const {
+    return lower <= value && value <= upper;
+}
+
+/**
+ * @brief Check whether another interval lies inside this one.
+ * @param other The other interval.
+ * @return true if every value of other is in this interval, false otherwise.
+ */
+bool FractionInterval::contains(const FractionInterval& other) const {
+    return lower <= other.lower && other.upper <= upper;
+}
+
+/**
+ * @brief Check whether two intervals share at least one value.
+ * @param other The other interval.
+ * @return true if they overlap or touch, false otherwise.
+ */
+bool FractionInterval::intersects(const FractionInterval& other) const {
+    return lower <= other.upper && other.lower <= upper;
+}
+
+/**
+ * @brief Get the values the two intervals share.
+ * @param other The other interval.
+ * @return The intersection, bounded like the operands.
+ * @throws invalid_argument If the intervals do not intersect.
+ */
+FractionInterval FractionInterval::intersection(const FractionInterval& other) const {
+    if (!intersects(other)) {
+        throw invalid_argument("Intervals do not intersect");
+    }
+    FractionInterval result(lower < other.lower ? other.lower : lower, upper < other.upper ? upper : other.upper);
+    result.maxDenominator = combinedBound(maxDenominator, other.maxDenominator);
+    return result;
+}
+
+/**
+ * @brief Print an interval as [lower, upper].
+ * @param outs The output stream.
+ * @param interval The interval to print.
+ * @return The output stream.
+ */
+ostream& ariel::operator<<(ostream& outs, const FractionInterval& interval) {
+    return outs << "[" << interval.lower << ", " << interval.upper << "]";
+}
@@ -0,0 +1,52 @@
+#ifndef FRACTIONINTERVAL_HPP
+#define FRACTIONINTERVAL_HPP
+
+#include "Fraction.hpp"
+#include <iostream>
+
+namespace ariel {
+
+    // A closed interval [lower, upper] with exact Fraction endpoints, for error bounds.
+    // Endpoint arithmetic runs on unreduced 128-bit pairs and is compared exactly, so only the
+    // two winning endpoints are ever reduced. With a maximum denominator set, endpoints that are
+    // too wide are rounded outward instead, which keeps the interval an enclosure while stopping
+    // endpoint sizes from growing with every operation.
+    class FractionInterval {
+        private:
+            Fraction lower;
+            Fraction upper;
+            int maxDenominator;  // 0 for exact endpoints
+
+        public:
+            // constructors
+            FractionInterval();                                           // [0, 0]
+            explicit FractionInterval(const Fraction& point);             // [point, point]
+            FractionInterval(const Fraction& lower, const Fraction& upper);
+
+            // getter functions
+            Fraction getLower() const;
+            Fraction getUpper() const;
+            int getMaxDenominator() const;
+
+            // widening: a copy whose endpoints, and every result computed from it, have denominator <= maxDenominator
+            FractionInterval widened(int maxDenominator) const;
+
+            // arithmetic operator overloading; results are bounded when either operand is
+            FractionInterval operator+(const FractionInterval& other) const;
+            FractionInterval operator-(const FractionInterval& other) const;
+            FractionInterval operator*(const FractionInterval& other) const;
+            FractionInterval operator/(const FractionInterval& other) const;  // throws if other contains 0
+
+            // set tests
+            bool contains(const Fraction& value) const;
+            bool contains(const FractionInterval& other) const;
+            bool intersects(const FractionInterval& other) const;
+            FractionInterval intersection(const FractionInterval& other) const;  // throws if the intervals are disjoint
+
+            friend std::ostream& operator<<(std::ostream& outs, const FractionInterval& interval);
+    };
+
+    std::ostream& operator<<(std::ostream& outs, const FractionInterval& interval);
+}
+
+#endif /* FRACTIONINTERVAL_HPP */
@@ -0,0 +1,227 @@
+#include "FractionLoader.hpp"   // Include header file
+#include "MappedFile.hpp"       // Include read-only file mappings
+#include "FractionCounters.hpp" // Include operation counters
+#include "FractionProbes.hpp"   // Include USDT tracepoints
+#include "FractionDetail.hpp"   // Include detail::runParallel
+#include <algorithm>            // Include std::count and std::min
+#include <charconv>             // Include std::from_chars
+#include <cstring>              // Include memchr
+#include <cstdlib>              // Include C Standard General Utilities Library
+#include <limits>               // Include numeric limits
+#include <thread>               // Include hardware_concurrency
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+
+    // Files smaller than this are parsed on the calling thread unless a thread count is given.
+    const size_t MIN_PARALLEL_BYTES = 1 << 20;
+
+    bool isBlank(char character) {
+        return character == ' ' || character == '\t' || character == '\r';
+    }
+
+    const char* skipBlanks(const char* first, const char* last) {
+        while (first != last && isBlank(*first)) {
+            ++first;
+        }
+        return first;
+    }
+
+    ParseResult parseError(const char* position, const char* message) {
+        detail::countFraction(detail::FractionCounter::ParseErrors);
+        ARIEL_FRACTION_PROBE1(parse_error, message);
+        return {position, message};
+    }
+
+    // Per-chunk parse state: where its lines start in the output and its first error, if any.
+    struct Chunk {
+        string_view text;
+        size_t firstLine = 0;
+        size_t errorLine = numeric_limits<size_t>::max();
+        const char* error = nullptr;
+    };
+
+    size_t countLines(string_view text) {
+        size_t lines = static_cast<size_t>(count(text.begin(), text.end(), '\n'));
+        if (!text.empty() && text.back() != '\n') {
+            ++lines;
+        }
+        return lines;
+    }
+
+    void parseChunk(Chunk& chunk, int* numerators, int* denominators) {
+        const char* cursor = chunk.text.data();
+        const char* end = cursor + chunk.text.size();
+        size_t line = chunk.firstLine;
+        while (cursor != end) {
+            const char* newline = static_cast<const char*>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+            const char* lineEnd = (newline == nullptr) ? end : newline;
+            ParseResult result = parseFraction(cursor, lineEnd, numerators[line], denominators[line]);
+            if (result.error == nullptr && skipBlanks(result.ptr, lineEnd) != lineEnd) {
+                result.error = "Unexpected characters after fraction";
+            }
+            if (result.error != nullptr) {
+                chunk.errorLine = line;
+                chunk.error = result.error;
+                return;
+            }
+            ++line;
+            cursor = (newline == nullptr) ? end : newline + 1;
+        }
+    }
+}
+
+/**
+ * @brief Create a parse error that names the file and line.
+ * @param path The file being loaded.
+ * @param line The 1-based line of the error.
+ * @param message What was wrong with the line.
+ */
+FractionParseError::FractionParseError(const string& path, size_t line, const char* message)
+    : runtime_error(path + ":" + to_string(line) + ": " + message), lineNumber(line) {}
+
+/**
+ * @brief Get the line the error was found on.
+ * @return The 1-based line number.
+ */
+size_t FractionParseError::line() const {
+    return lineNumber;
+}
+
+/**
+ * @brief Parse a fraction written as "n/d" or "n d" without going through a stream.
+ * @param first The first character to parse; leading blanks are skipped.
+ * @param last One past the last character available.
+ * @param numerator Receives the reduced numerator.
+ * @param denominator Receives the reduced, positive denominator.
+ * @return The position after the fraction, and nullptr as error on success or a message on failure.
+ * The result matches what operator>> followed by the Fraction constructor would store.
+ */
+ParseResult ariel::parseFraction(const char* first, const char* last, int& numerator, int& denominator) {
+    detail::countFraction(detail::FractionCounter::Parses);
+    first = skipBlanks(first, last);
+    long long num = 0;
+    from_chars_result parsed = from_chars(first, last, num);
+    if (parsed.ec != errc()) {
+        return parseError(first, "Expected an integer numerator");
+    }
+    if (num < numeric_limits<int>::min() || num > numeric_limits<int>::max()) {
+        return parseError(first, "Fraction does not fit in int");
+    }
+    first = skipBlanks(parsed.ptr, last);
+    if (first != last && *first == '.') {
+        return parseError(first, "Operator with floating-point can't be input");
+    }
+    if (first != last && *first == '/') {
+        first = skipBlanks(first + 1, last);
+    } else if (first == parsed.ptr) {
+        return parseError(first, "Invalid input format");
+    }
+    long long den = 0;
+    parsed = from_chars(first, last, den);
+    if (parsed.ec != errc()) {
+        return parseError(first, "Expected an integer denominator");
+    }
+    if (den < numeric_limits<int>::min() || den > numeric_limits<int>::max()) {
+        return parseError(first, "Fraction does not fit in int");
+    }
+    if (parsed.ptr != last && *parsed.ptr == '.') {
+        return parseError(parsed.ptr, "Operator with floating-point can't be input");
+    }
+    if (den == 0) {
+        return parseError(first, "Denominator cannot be zero");
+    }
+    // Both terms fit in int here, so the gcd and the sign flip below cannot overflow long long.
+    detail::countFraction(detail::FractionCounter::GcdCalls);
+    ARIEL_FRACTION_PROBE2(gcd_entry, num, den);
+    long long gcdValue = detail::countedGcd(num, den);
+    ARIEL_FRACTION_PROBE3(gcd_exit, num, den, gcdValue);
+    num /= gcdValue;
+    den /= gcdValue;
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    if (num < numeric_limits<int>::min() || num > numeric_limits<int>::max() || den > numeric_limits<int>::max()) {
+        return parseError(first, "Fraction does not fit in int");
+    }
+    numerator = static_cast<int>(num);
+    denominator = static_cast<int>(den);
+    return {parsed.ptr, nullptr};
+}
+
+/**
+ * @brief Split a text buffer into pieces that start and end on line boundaries.
+ * @param data The text to split.
+ * @param size The number of bytes of text.
+ * @param parts The desired number of pieces; fewer are returned when lines are long.
+ * @return The pieces, in order, covering the whole buffer.
+ */
+vector<string_view> ariel::splitLines(const char* data, size_t size, size_t parts) {
+    vector<string_view> pieces;
+    parts = max<size_t>(parts, 1);
+    size_t begin = 0;
+    for (size_t part = 1; part <= parts && begin < size; ++part) {
+        size_t end = (part == parts) ? size : max(begin, size / parts * part);
+        if (end < size) {
+            const void* newline = memchr(data + end, '\n', size - end);
+            end = (newline == nullptr) ? size : static_cast<size_t>(static_cast<const char*>(newline) - data) + 1;
+        }
+        if (end > begin) {
+            pieces.emplace_back(data + begin, end - begin);
+            begin = end;
+        }
+    }
+    return pieces;
+}
+
+/**
+ * @brief Load a text file with one fraction per line into a FractionVector.
+ * @param path The file to load.
+ * @param threads The number of worker threads, or 0 to pick one per hardware thread for large files.
+ * @return The fractions in file order, reduced as the Fraction constructor would.
+ * @throws runtime_error If the file cannot be mapped.
+ * @throws FractionParseError For the first malformed line, including blank lines.
+ * The file is memory-mapped and parsed in two parallel passes: one counts the
+ * lines of every chunk so the output can be preallocated and each chunk knows
+ * its first line, the other parses every chunk straight into its slice of the
+ * numerator and denominator columns.
+ */
+FractionVector ariel::loadFractions(const string& path, unsigned threads) {
+    MappedFile file(path);
+    if (threads == 0) {
+        threads = (file.size() < MIN_PARALLEL_BYTES) ? 1 : max(1U, thread::hardware_concurrency());
+    }
+
+    vector<string_view> pieces = splitLines(file.data(), file.size(), threads * detail::CHUNKS_PER_THREAD);
+    vector<Chunk> chunks(pieces.size());
+    for (size_t index = 0; index < pieces.size(); ++index) {
+        chunks[index].text = pieces[index];
+    }
+
+    auto runParallel = [&](auto task) {
+        detail::runParallel(chunks.size(), threads, [&](size_t index) { task(chunks[index]); });
+    };
+
+    runParallel([](Chunk& chunk) { chunk.firstLine = countLines(chunk.text); });
+    size_t total = 0;
+    for (Chunk& chunk : chunks) {
+        size_t lines = chunk.firstLine;
+        chunk.firstLine = total;
+        total += lines;
+    }
+
+    FractionVector fractions(total);
+    int* numerators = fractions.numeratorData();
+    int* denominators = fractions.denominatorData();
+    runParallel([&](Chunk& chunk) { parseChunk(chunk, numerators, denominators); });
+
+    for (const Chunk& chunk : chunks) {
+        if (chunk.error != nullptr) {
+            throw FractionParseError(path, chunk.errorLine + 1, chunk.error);
+        }
+    }
+    return fractions;
+}
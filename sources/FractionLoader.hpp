@@ -0,0 +1,39 @@
+#ifndef FRACTIONLOADER_HPP
+#define FRACTIONLOADER_HPP
+
+#include "FractionVector.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ariel {
+
+    // Outcome of parseFraction: where parsing stopped, and a static message if it failed.
+    struct ParseResult {
+        const char* ptr;
+        const char* error;  // nullptr on success
+    };
+
+    // Thrown by loadFractions for the first malformed line of a file.
+    class FractionParseError : public std::runtime_error {
+        private:
+            std::size_t lineNumber;
+
+        public:
+            FractionParseError(const std::string& path, std::size_t line, const char* message);
+            std::size_t line() const;  // 1-based line of the error
+    };
+
+    // Parse one "n/d" (or "n d") fraction from [first, last) into reduced, sign-normalized form.
+    ParseResult parseFraction(const char* first, const char* last, int& numerator, int& denominator);
+
+    // Split [data, data + size) into at most parts pieces, each ending right after a newline (or at the end).
+    std::vector<std::string_view> splitLines(const char* data, std::size_t size, std::size_t parts);
+
+    // Load a file with one fraction per line, parsing chunks of it on threads workers (0 = one per core).
+    FractionVector loadFractions(const std::string& path, unsigned threads = 0);
+}
+
+#endif /* FRACTIONLOADER_HPP */
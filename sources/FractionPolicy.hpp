@@ -0,0 +1,104 @@
+#ifndef FRACTIONPOLICY_HPP
+#define FRACTIONPOLICY_HPP
+
+#include "Fraction.hpp"
+#include "ContinuedFraction.hpp"
+#include <limits>
+#include <stdexcept>
+
+namespace ariel {
+
+    // The exact result of an operation, reduced in 64 bits, before any policy narrows it to int.
+    struct WideResult {
+        long long numerator;
+        long long denominator;  // positive; 1 when divideByZero is set
+        bool overflow;          // the operator rules for int overflow fired
+        bool divideByZero;
+    };
+
+    // A 64-bit fraction in lowest terms, the wider backend PromotePolicy returns.
+    struct WideFraction {
+        long long numerator;
+        long long denominator;
+    };
+
+    // Exact 64-bit cores shared by every policy, by the checked_* functions and by the operators.
+    WideResult wide_add(const Fraction& left, const Fraction& right);
+    WideResult wide_sub(const Fraction& left, const Fraction& right);
+    WideResult wide_mul(const Fraction& left, const Fraction& right);
+    WideResult wide_div(const Fraction& left, const Fraction& right);
+
+    // Throws std::overflow_error or std::runtime_error, as the Fraction operators do.
+    struct ThrowPolicy {
+        using result_type = Fraction;
+        static Fraction apply(const WideResult& result) {
+            if (result.divideByZero) {
+                throw std::runtime_error("Cannot divide by zero");
+            }
+            if (result.overflow) {
+                throw std::overflow_error("Multiplication the numerators would result in integer overflow!");
+            }
+            return Fraction::fromReduced(static_cast<int>(result.numerator), static_cast<int>(result.denominator));
+        }
+    };
+
+    // Returns 0/1 on error and raises a per-thread sticky flag; the select compiles to conditional moves.
+    struct FlagPolicy {
+        using result_type = Fraction;
+        static bool& flag() {
+            thread_local bool sticky = false;
+            return sticky;
+        }
+        static bool raised() { return flag(); }
+        static void clear() { flag() = false; }
+        static Fraction apply(const WideResult& result) {
+            bool failed = result.overflow | result.divideByZero;
+            flag() |= failed;
+            return Fraction::fromReduced(failed ? 0 : static_cast<int>(result.numerator), failed ? 1 : static_cast<int>(result.denominator));
+        }
+    };
+
+    // Clamps to the closest representable value: +-INT_MAX/1 past the int range, otherwise the
+    // closest fraction with both terms in int, but never 0 for a nonzero result (+-1/INT_MAX instead).
+    // Division by zero saturates by the sign of the dividend.
+    struct SaturatePolicy {
+        using result_type = Fraction;
+        static Fraction apply(const WideResult& result) {
+            const int limit = std::numeric_limits<int>::max();
+            if (result.divideByZero) {
+                return Fraction::fromReduced(result.numerator > 0 ? limit : (result.numerator < 0 ? -limit : 0), 1);
+            }
+            if (!result.overflow) {
+                return Fraction::fromReduced(static_cast<int>(result.numerator), static_cast<int>(result.denominator));
+            }
+            Fraction closest = limit_terms(result.numerator, result.denominator, limit, limit);
+            if (closest.getNumerator() == 0 && result.numerator != 0) {
+                return Fraction::fromReduced(result.numerator > 0 ? 1 : -1, limit);
+            }
+            return closest;
+        }
+    };
+
+    // Never overflows: every result is returned exactly as a WideFraction.
+    struct PromotePolicy {
+        using result_type = WideFraction;
+        static WideFraction apply(const WideResult& result) {
+            if (result.divideByZero) {
+                throw std::runtime_error("Cannot divide by zero");
+            }
+            return WideFraction{result.numerator, result.denominator};
+        }
+    };
+
+    // Fraction arithmetic whose overflow handling is chosen by Policy, e.g. FractionArithmetic<FlagPolicy>::mul(a, b).
+    template <typename Policy>
+    struct FractionArithmetic {
+        using result_type = typename Policy::result_type;
+        static result_type add(const Fraction& left, const Fraction& right) { return Policy::apply(wide_add(left, right)); }
+        static result_type sub(const Fraction& left, const Fraction& right) { return Policy::apply(wide_sub(left, right)); }
+        static result_type mul(const Fraction& left, const Fraction& right) { return Policy::apply(wide_mul(left, right)); }
+        static result_type div(const Fraction& left, const Fraction& right) { return Policy::apply(wide_div(left, right)); }
+    };
+}
+
+#endif /* FRACTIONPOLICY_HPP */
@@ -0,0 +1,339 @@
+#include "FractionPolynomial.hpp"   // Include header file
+#include "FractionDetail.hpp"       // Include detail::gcdWide and detail::runParallel
+#include <algorithm>                // Include std::max and std::min
+#include <limits>                   // Include numeric limits
+#include <stdexcept>                // Include exception classes
+#include <thread>                   // Include thread::hardware_concurrency
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+    // Batches smaller than this are evaluated on the calling thread unless a thread count is given.
+    const size_t MIN_PARALLEL_POINTS = 4096;
+    const size_t POINTS_PER_CHUNK = 1024;
+
+    size_t bitLength(unsigned long long value) {
+        return value == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(value));
+    }
+
+    size_t bitLength(long long value) {
+        return bitLength(value < 0 ? 0 - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value));
+    }
+
+    bool sameFraction(const Fraction& left, const Fraction& right) {
+        return left.getNumerator() == right.getNumerator() && left.getDenominator() == right.getDenominator();
+    }
+}
+
+/**
+ * @brief Drop trailing zero coefficients and rebuild the common-denominator form.
+ */
+void FractionPolynomial::prepare() {
+    while (!coefficients.empty() && coefficients.back().getNumerator() == 0) {
+        coefficients.pop_back();
+    }
+    common = BigInt(1);
+    for (const Fraction& coefficient : coefficients) {
+        BigInt denominator(coefficient.getDenominator());
+        common = common / BigInt::gcd(common, denominator) * denominator;
+    }
+    integers.clear();
+    smallIntegers.clear();
+    small = common.fitsLongLong();
+    smallCommon = small ? common.toLongLong() : 0;
+    smallBits = 0;
+    for (const Fraction& coefficient : coefficients) {
+        integers.push_back(BigInt(coefficient.getNumerator()) * (common / BigInt(coefficient.getDenominator())));
+        small = small && integers.back().fitsLongLong();
+        if (small) {
+            smallIntegers.push_back(integers.back().toLongLong());
+            smallBits = max(smallBits, bitLength(smallIntegers.back()));
+        }
+    }
+}
+
+/**
+ * @brief Build a polynomial from exact coefficients.
+ * @throws overflow_error If a coefficient does not fit in a Fraction.
+ */
+FractionPolynomial FractionPolynomial::fromBig(vector<BigFraction> values) {
+    while (!values.empty() && values.back().getNumerator().isZero()) {
+        values.pop_back();
+    }
+    vector<Fraction> result;
+    result.reserve(values.size());
+    for (const BigFraction& value : values) {
+        result.push_back(value.toFraction());
+    }
+    return FractionPolynomial(result);
+}
+
+/**
+ * @brief Get the coefficients as exact BigFractions, for the arithmetic operators.
+ */
+vector<BigFraction> FractionPolynomial::toBig() const {
+    return vector<BigFraction>(coefficients.begin(), coefficients.end());
+}
+
+/**
+ * @brief Create the zero polynomial.
+ */
+FractionPolynomial::FractionPolynomial() : common(1), smallCommon(1), smallBits(0), small(true) {}
+
+/**
+ * @brief Create a polynomial from its coefficients.
+ * @param coefficients coefficients[i] is the coefficient of x^i.
+ */
+FractionPolynomial::FractionPolynomial(vector<Fraction> coefficients) : coefficients(move(coefficients)), smallCommon(1), smallBits(0), small(true) {
+    prepare();
+}
+
+/**
+ * @brief Get the degree.
+ * @return The highest power with a nonzero coefficient, or -1 for the zero polynomial.
+ */
+int FractionPolynomial::degree() const {
+    return static_cast<int>(coefficients.size()) - 1;
+}
+
+/**
+ * @brief Get the coefficients.
+ * @return The coefficients, lowest power first, without trailing zeros.
+ */
+const vector<Fraction>& FractionPolynomial::getCoefficients() const {
+    return coefficients;
+}
+
+/**
+ * @brief Evaluate at a point. For x = p/q and coefficients A_i / L, Horner's scheme computes
+ * sum A_i p^i q^(n-i) on integers, and the value is that over L q^n, reduced once. The bit lengths
+ * of the inputs decide up front whether every step fits in 128 bits; otherwise BigInt is used.
+ * @param point The point.
+ * @return The value.
+ * @throws overflow_error If the value does not fit in a Fraction.
+ */
+Fraction FractionPolynomial::evaluate(const Fraction& point) const {
+    if (coefficients.empty()) {
+        return Fraction();
+    }
+    size_t power = coefficients.size() - 1;
+    long long numerator = point.getNumerator();
+    long long denominator = point.getDenominator();
+    size_t denominatorBits = bitLength(denominator);
+    size_t step = max(bitLength(numerator), denominatorBits) + 1;
+    if (!small || smallBits + power * step > 126 || bitLength(smallCommon) + power * denominatorBits > 126) {
+        return evaluateExact(point).toFraction();
+    }
+
+    __int128 value = smallIntegers[power];
+    __int128 scale = 1;
+    for (size_t index = power; index-- > 0;) {
+        scale *= denominator;
+        value = value * numerator + smallIntegers[index] * scale;
+    }
+    scale *= smallCommon;
+    auto divisor = static_cast<__int128>(detail::gcdWide(value, scale));
+    value /= divisor;
+    scale /= divisor;
+    if (value < numeric_limits<int>::min() || value > numeric_limits<int>::max() || scale > numeric_limits<int>::max()) {
+        throw overflow_error("Evaluating the polynomial would result in integer overflow!");
+    }
+    return Fraction::fromReduced(static_cast<int>(value), static_cast<int>(scale));
+}
+
+/**
+ * @brief Evaluate at a point with BigInt Horner, so the value is always exact.
+ * @param point The point.
+ * @return The value, in lowest terms.
+ */
+BigFraction FractionPolynomial::evaluateExact(const Fraction& point) const {
+    if (coefficients.empty()) {
+        return BigFraction();
+    }
+    BigInt numerator(point.getNumerator());
+    BigInt denominator(point.getDenominator());
+    size_t power = coefficients.size() - 1;
+    BigInt value = integers[power];
+    BigInt scale(1);
+    for (size_t index = power; index-- > 0;) {
+        scale *= denominator;
+        value = value * numerator + integers[index] * scale;
+    }
+    return BigFraction(value, scale * common);
+}
+
+/**
+ * @brief Evaluate at many points. Chunks of points are handed to worker threads.
+ * 128-bit Horner does not vectorize, so the batch is spread over threads rather than SIMD lanes.
+ * @param points The points.
+ * @param count The number of points.
+ * @param out Receives count values.
+ * @param threads The number of worker threads, or 0 to pick one per hardware thread for large batches.
+ * @throws overflow_error For the first point, in order, whose value does not fit; other outputs may be written.
+ */
+void FractionPolynomial::evaluate(const Fraction* points, size_t count, Fraction* out, unsigned threads) const {
+    if (threads == 0) {
+        threads = (count < MIN_PARALLEL_POINTS) ? 1 : max(1U, thread::hardware_concurrency());
+    }
+    size_t chunks = (count + POINTS_PER_CHUNK - 1) / POINTS_PER_CHUNK;
+    detail::runParallel(chunks, threads, [&](size_t chunk) {
+        size_t end = min(count, (chunk + 1) * POINTS_PER_CHUNK);
+        for (size_t index = chunk * POINTS_PER_CHUNK; index < end; ++index) {
+            out[index] = evaluate(points[index]);
+        }
+    });
+}
+
+/**
+ * @brief Add two polynomials.
+ * @param other The polynomial to add.
+ * @return The sum.
+ * @throws overflow_error If a coefficient does not fit in a Fraction.
+ */
+FractionPolynomial FractionPolynomial::operator+(const FractionPolynomial& other) const {
+    vector<BigFraction> result = toBig();
+    result.resize(max(coefficients.size(), other.coefficients.size()));
+    for (size_t index = 0; index < other.coefficients.size(); ++index) {
+        result[index] = result[index] + BigFraction(other.coefficients[index]);
+    }
+    return fromBig(move(result));
+}
+
+/**
+ * @brief Subtract two polynomials.
+ * @param other The polynomial to subtract.
+ * @return The difference.
+ * @throws overflow_error If a coefficient does not fit in a Fraction.
+ */
+FractionPolynomial FractionPolynomial::operator-(const FractionPolynomial& other) const {
+    vector<BigFraction> result = toBig();
+    result.resize(max(coefficients.size(), other.coefficients.size()));
+    for (size_t index = 0; index < other.coefficients.size(); ++index) {
+        result[index] = result[index] - BigFraction(other.coefficients[index]);
+    }
+    return fromBig(move(result));
+}
+
+/**
+ * @brief Multiply two polynomials. Each product coefficient is summed exactly over the common
+ * denominators of the operands and reduced once.
+ * @param other The polynomial to multiply by.
+ * @return The product.
+ * @throws overflow_error If a coefficient does not fit in a Fraction.
+ */
+FractionPolynomial FractionPolynomial::operator*(const FractionPolynomial& other) const {
+    if (coefficients.empty() || other.coefficients.empty()) {
+        return FractionPolynomial();
+    }
+    vector<BigInt> sums(coefficients.size() + other.coefficients.size() - 1);
+    for (size_t left = 0; left < coefficients.size(); ++left) {
+        for (size_t right = 0; right < other.coefficients.size(); ++right) {
+            sums[left + right] += integers[left] * other.integers[right];
+        }
+    }
+    BigInt scale = common * other.common;
+    vector<BigFraction> result;
+    result.reserve(sums.size());
+    for (const BigInt& sum : sums) {
+        result.emplace_back(sum, scale);
+    }
+    return fromBig(move(result));
+}
+
+/**
+ * @brief Divide by another polynomial when the division leaves no remainder.
+ * @param other The divisor.
+ * @return The quotient.
+ * @throws runtime_error If other is the zero polynomial.
+ * @throws invalid_argument If the remainder is not zero.
+ * @throws overflow_error If a coefficient does not fit in a Fraction.
+ */
+FractionPolynomial FractionPolynomial::operator/(const FractionPolynomial& other) const {
+    FractionPolynomial quotient;
+    FractionPolynomial remainder;
+    divmod(*this, other, quotient, remainder);
+    if (remainder.degree() >= 0) {
+        throw invalid_argument("Polynomial division is not exact");
+    }
+    return quotient;
+}
+
+/**
+ * @brief Get the remainder of dividing by another polynomial.
+ * @param other The divisor.
+ * @return The remainder, of lower degree than other.
+ * @throws runtime_error If other is the zero polynomial.
+ * @throws overflow_error If a coefficient does not fit in a Fraction.
+ */
+FractionPolynomial FractionPolynomial::operator%(const FractionPolynomial& other) const {
+    FractionPolynomial quotient;
+    FractionPolynomial remainder;
+    divmod(*this, other, quotient, remainder);
+    return remainder;
+}
+
+/**
+ * @brief Long division with exact rational coefficients: dividend = quotient * divisor + remainder.
+ * @param dividend The polynomial to divide.
+ * @param divisor The polynomial to divide by.
+ * @param quotient Receives the quotient.
+ * @param remainder Receives the remainder, of lower degree than divisor.
+ * @throws runtime_error If divisor is the zero polynomial.
+ * @throws overflow_error If a coefficient does not fit in a Fraction.
+ */
+void FractionPolynomial::divmod(const FractionPolynomial& dividend, const FractionPolynomial& divisor, FractionPolynomial& quotient,
+                                FractionPolynomial& remainder) {
+    if (divisor.coefficients.empty()) {
+        throw runtime_error("Cannot divide by zero");
+    }
+    vector<BigFraction> rest = dividend.toBig();
+    vector<BigFraction> lower = divisor.toBig();
+    size_t divisorSize = lower.size();
+    if (rest.size() < divisorSize) {
+        quotient = FractionPolynomial();
+        remainder = dividend;
+        return;
+    }
+    vector<BigFraction> result(rest.size() - divisorSize + 1);
+    for (size_t shift = result.size(); shift-- > 0;) {
+        result[shift] = rest[shift + divisorSize - 1] / lower.back();
+        for (size_t index = 0; index < divisorSize; ++index) {
+            rest[shift + index] = rest[shift + index] - result[shift] * lower[index];
+        }
+    }
+    rest.resize(divisorSize - 1);
+    quotient = fromBig(move(result));
+    remainder = fromBig(move(rest));
+}
+
+/**
+ * @brief Differentiate.
+ * @return The derivative.
+ * @throws overflow_error If a coefficient does not fit in a Fraction.
+ */
+FractionPolynomial FractionPolynomial::derivative() const {
+    vector<BigFraction> result;
+    for (size_t index = 1; index < coefficients.size(); ++index) {
+        result.push_back(BigFraction(coefficients[index]) * BigFraction(BigInt(static_cast<long long>(index))));
+    }
+    return fromBig(move(result));
+}
+
+/**
+ * @brief Check whether two polynomials have the same coefficients, exactly.
+ * @param other The polynomial to compare with.
+ * @return true if they are equal, false otherwise.
+ */
+bool FractionPolynomial::operator==(const FractionPolynomial& other) const {
+    return equal(coefficients.begin(), coefficients.end(), other.coefficients.begin(), other.coefficients.end(), sameFraction);
+}
+
+/**
+ * @brief Check whether two polynomials differ.
+ * @param other The polynomial to compare with.
+ * @return true if any coefficient differs, false otherwise.
+ */
+bool FractionPolynomial::operator!=(const FractionPolynomial& other) const {
+    return !(*this == other);
+}
@@ -0,0 +1,60 @@
+#ifndef FRACTIONPOLYNOMIAL_HPP
+#define FRACTIONPOLYNOMIAL_HPP
+
+#include "BigFraction.hpp"
+#include "BigInt.hpp"
+#include "Fraction.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace ariel {
+
+    // A polynomial with Fraction coefficients. The coefficients are also kept over one common
+    // denominator, so evaluation runs Horner's scheme on integers and reduces once at the end.
+    class FractionPolynomial {
+        private:
+            std::vector<Fraction> coefficients;  // lowest power first, no trailing zeros
+
+            // coefficient i is integers[i] / common
+            std::vector<BigInt> integers;
+            BigInt common;
+            std::vector<long long> smallIntegers;  // the same, when everything fits in long long
+            long long smallCommon;
+            std::size_t smallBits;                 // the widest of smallIntegers, in bits
+            bool small;
+
+            void prepare();
+            static FractionPolynomial fromBig(std::vector<BigFraction> values);
+            std::vector<BigFraction> toBig() const;
+
+        public:
+            // constructors
+            FractionPolynomial();                                       // the zero polynomial
+            explicit FractionPolynomial(std::vector<Fraction> coefficients);  // coefficients[i] multiplies x^i
+
+            // getter functions
+            int degree() const;  // -1 for the zero polynomial
+            const std::vector<Fraction>& getCoefficients() const;
+
+            // evaluation
+            Fraction evaluate(const Fraction& point) const;           // throws std::overflow_error if the value does not fit
+            BigFraction evaluateExact(const Fraction& point) const;   // never overflows
+            void evaluate(const Fraction* points, std::size_t count, Fraction* out, unsigned threads = 0) const;  // 0 = one per core for large batches
+
+            // arithmetic operator overloading for FractionPolynomial objects; results must have Fraction coefficients
+            FractionPolynomial operator+(const FractionPolynomial& other) const;
+            FractionPolynomial operator-(const FractionPolynomial& other) const;
+            FractionPolynomial operator*(const FractionPolynomial& other) const;
+            FractionPolynomial operator/(const FractionPolynomial& other) const;  // throws std::invalid_argument unless the division is exact
+            FractionPolynomial operator%(const FractionPolynomial& other) const;
+            static void divmod(const FractionPolynomial& dividend, const FractionPolynomial& divisor, FractionPolynomial& quotient,
+                               FractionPolynomial& remainder);
+            FractionPolynomial derivative() const;
+
+            // comparison
+            bool operator==(const FractionPolynomial& other) const;
+            bool operator!=(const FractionPolynomial& other) const;
+    };
+}
+
+#endif /* FRACTIONPOLYNOMIAL_HPP */
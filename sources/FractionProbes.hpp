@@ -0,0 +1,39 @@
+#ifndef FRACTIONPROBES_HPP
+#define FRACTIONPROBES_HPP
+
+// USDT (user-level statically defined tracing) probes in the Fraction hot paths, under the
+// provider "ariel_fraction". When <sys/sdt.h> is available (systemtap-sdt-dev) each probe is a
+// single nop plus an ELF note, so an unattached probe costs nothing measurable; otherwise, or
+// with ARIEL_FRACTION_NO_PROBES defined, every probe expands to nothing. For example:
+//
+//     bpftrace -e 'usdt:./fractool:ariel_fraction:overflow { printf("%c %d/%d %d/%d\n", arg0, arg1, arg2, arg3, arg4); }'
+//
+// Probes and their arguments:
+//     normalize      numerator, denominator                  Fraction(int, int) before reduction
+//     gcd_entry      first, second                           a reduction starts
+//     gcd_exit       first, second, gcd
+//     overflow       operator ('+', '-', '*', '/'), left numerator, left denominator,
+//                    right numerator, right denominator       an overflow check fired
+//     parse_error    message (char*)                         operator>> or parseFraction rejected input
+
+#if !defined(ARIEL_FRACTION_NO_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define ARIEL_FRACTION_HAS_PROBES 1
+#endif
+#endif
+
+#ifdef ARIEL_FRACTION_HAS_PROBES
+#define ARIEL_FRACTION_PROBE1(name, first) DTRACE_PROBE1(ariel_fraction, name, first)
+#define ARIEL_FRACTION_PROBE2(name, first, second) DTRACE_PROBE2(ariel_fraction, name, first, second)
+#define ARIEL_FRACTION_PROBE3(name, first, second, third) DTRACE_PROBE3(ariel_fraction, name, first, second, third)
+#define ARIEL_FRACTION_PROBE5(name, first, second, third, fourth, fifth) \
+    DTRACE_PROBE5(ariel_fraction, name, first, second, third, fourth, fifth)
+#else
+#define ARIEL_FRACTION_PROBE1(name, first) do { } while (0)
+#define ARIEL_FRACTION_PROBE2(name, first, second) do { } while (0)
+#define ARIEL_FRACTION_PROBE3(name, first, second, third) do { } while (0)
+#define ARIEL_FRACTION_PROBE5(name, first, second, third, fourth, fifth) do { } while (0)
+#endif
+
+#endif /* FRACTIONPROBES_HPP */
@@ -0,0 +1,206 @@
+#include "FractionProfile.hpp"   // Include header file
+#include <atomic>                // Include relaxed atomic histogram buckets
+#include <cstdlib>               // Include std::getenv and std::llabs
+#include <fstream>               // Include file output for the exit dump
+#include <iomanip>               // Include column formatting
+#include <numeric>               // Include std::gcd
+#include <string>                // Include std::string
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+    const size_t OPERATORS = static_cast<size_t>(ProfiledOp::Count);
+    const size_t BUCKETS = 65;
+    const char* const OPERATOR_NAMES[OPERATORS] = {"operator+", "operator-", "operator*", "operator/"};
+
+
+#ifdef ARIEL_FRACTION_PROFILE
+    // Bit width of |value|; 0 for zero.
+    size_t widthOf(long long value) {
+        unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+        return magnitude == 0 ? 0 : static_cast<size_t>(64 - __builtin_clzll(magnitude));
+    }
+
+    struct Histograms {
+        atomic<uint64_t> samples{0};
+        atomic<uint64_t> operands[BUCKETS];
+        atomic<uint64_t> results[BUCKETS];
+        atomic<uint64_t> gcds[BUCKETS];
+    };
+    Histograms histograms[OPERATORS];
+
+    void bump(atomic<uint64_t>* buckets, long long value) {
+        buckets[widthOf(value)].fetch_add(1, memory_order_relaxed);
+    }
+
+    void copy(const atomic<uint64_t>* from, WidthHistogram& to) {
+        for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            to.buckets[bucket] = from[bucket].load(memory_order_relaxed);
+        }
+    }
+
+    unsigned initialRate() {
+        const char* rate = getenv("ARIEL_FRACTION_PROFILE_RATE");
+        return rate != nullptr ? static_cast<unsigned>(strtoul(rate, nullptr, 10)) : 1024;
+    }
+
+    // Writes the profile at exit when ARIEL_FRACTION_PROFILE_OUT names a file or "-".
+    struct ExitDump {
+        ~ExitDump() {
+            const char* path = getenv("ARIEL_FRACTION_PROFILE_OUT");
+            if (path == nullptr) {
+                return;
+            }
+            if (string(path) == "-") {
+                dump_fraction_profile(cerr);
+            } else {
+                ofstream file(path);
+                dump_fraction_profile(file);
+            }
+        }
+    };
+    ExitDump exitDump;
+#endif
+}
+
+#ifdef ARIEL_FRACTION_PROFILE
+namespace {
+    atomic<unsigned> profileRate{initialRate()};
+
+    // How many calls to skip while sampling is off before checking the rate again.
+    const unsigned IDLE_RECHECK = 1 << 16;
+}
+
+/**
+ * @brief Record one sampled call, recomputing its exact result in 64 bits, and restart the countdown.
+ * @param op The operator that ran.
+ * @param left The left operand.
+ * @param right The right operand.
+ */
+void ariel::detail::profileSample(ProfiledOp op, const Fraction& left, const Fraction& right) {
+    unsigned rate = profileRate.load(memory_order_relaxed);
+    profileCountdown = rate != 0 ? rate : IDLE_RECHECK;
+    if (rate == 0) {
+        return;
+    }
+    long long leftNumerator = left.getNumerator();
+    long long leftDenominator = left.getDenominator();
+    long long rightNumerator = right.getNumerator();
+    long long rightDenominator = right.getDenominator();
+    long long numerator = 0;
+    long long denominator = 0;
+    switch (op) {
+        case ProfiledOp::Add:
+            numerator = leftNumerator * rightDenominator + rightNumerator * leftDenominator;
+            denominator = leftDenominator * rightDenominator;
+            break;
+        case ProfiledOp::Sub:
+            numerator = leftNumerator * rightDenominator - rightNumerator * leftDenominator;
+            denominator = leftDenominator * rightDenominator;
+            break;
+        case ProfiledOp::Mul:
+            numerator = leftNumerator * rightNumerator;
+            denominator = leftDenominator * rightDenominator;
+            break;
+        default:
+            numerator = leftNumerator * rightDenominator;
+            denominator = leftDenominator * rightNumerator;
+            break;
+    }
+    if (denominator == 0) {
+        return;  // division by zero has no result to profile
+    }
+    long long gcdValue = gcd(numerator, denominator);
+    Histograms& histogram = histograms[static_cast<size_t>(op)];
+    histogram.samples.fetch_add(1, memory_order_relaxed);
+    bump(histogram.operands, leftNumerator);
+    bump(histogram.operands, leftDenominator);
+    bump(histogram.operands, rightNumerator);
+    bump(histogram.operands, rightDenominator);
+    bump(histogram.results, numerator / gcdValue);
+    bump(histogram.results, denominator / gcdValue);
+    bump(histogram.gcds, gcdValue);
+}
+#endif
+
+/**
+ * @brief Count the values in a histogram.
+ * @return The sum of all buckets.
+ */
+uint64_t WidthHistogram::total() const {
+    uint64_t sum = 0;
+    for (uint64_t count : buckets) {
+        sum += count;
+    }
+    return sum;
+}
+
+/**
+ * @brief Sample one call in every rate calls, per thread.
+ * @param rate The sampling interval; 0 stops sampling. Has no effect without ARIEL_FRACTION_PROFILE.
+ */
+void ariel::set_fraction_profile_rate(unsigned rate) {
+#ifdef ARIEL_FRACTION_PROFILE
+    profileRate.store(rate, memory_order_relaxed);
+    detail::profileCountdown = rate != 0 ? rate : IDLE_RECHECK;
+#else
+    (void)rate;
+#endif
+}
+
+/**
+ * @brief Take a snapshot of the sampled histograms.
+ * @return One profile per operator, indexed by ProfiledOp; empty without ARIEL_FRACTION_PROFILE.
+ */
+FractionProfile ariel::fraction_profile() {
+    FractionProfile profile{};
+#ifdef ARIEL_FRACTION_PROFILE
+    for (size_t op = 0; op < OPERATORS; ++op) {
+        profile[op].samples = histograms[op].samples.load(memory_order_relaxed);
+        copy(histograms[op].operands, profile[op].operands);
+        copy(histograms[op].results, profile[op].results);
+        copy(histograms[op].gcds, profile[op].gcds);
+    }
+#endif
+    return profile;
+}
+
+/**
+ * @brief Clear every sampled histogram.
+ */
+void ariel::reset_fraction_profile() {
+#ifdef ARIEL_FRACTION_PROFILE
+    for (Histograms& histogram : histograms) {
+        histogram.samples.store(0, memory_order_relaxed);
+        for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            histogram.operands[bucket].store(0, memory_order_relaxed);
+            histogram.results[bucket].store(0, memory_order_relaxed);
+            histogram.gcds[bucket].store(0, memory_order_relaxed);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Print the profile as one table per sampled operator, skipping empty widths.
+ * @param outs The stream to write to.
+ */
+void ariel::dump_fraction_profile(ostream& outs) {
+    FractionProfile profile = fraction_profile();
+    for (size_t op = 0; op < OPERATORS; ++op) {
+        const OperatorProfile& current = profile[op];
+        if (current.samples == 0) {
+            continue;
+        }
+        outs << OPERATOR_NAMES[op] << ": " << current.samples << " samples\n";
+        outs << setw(8) << "bits" << setw(14) << "operands" << setw(14) << "results" << setw(14) << "gcd" << "\n";
+        for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            if (current.operands.buckets[bucket] + current.results.buckets[bucket] + current.gcds.buckets[bucket] == 0) {
+                continue;
+            }
+            outs << setw(8) << bucket << setw(14) << current.operands.buckets[bucket] << setw(14) << current.results.buckets[bucket]
+                 << setw(14) << current.gcds.buckets[bucket] << "\n";
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef FRACTIONPROFILE_HPP
+#define FRACTIONPROFILE_HPP
+
+#include "Fraction.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+namespace ariel {
+
+    // The Fraction operators the profiler samples.
+    enum class ProfiledOp { Add, Sub, Mul, Div, Count };
+
+    // Counts of values by bit width: bucket w holds magnitudes in [2^(w-1), 2^w), bucket 0 holds zero.
+    struct WidthHistogram {
+        std::array<std::uint64_t, 65> buckets{};
+        std::uint64_t total() const;
+    };
+
+    // What one operator saw over the sampled calls.
+    struct OperatorProfile {
+        std::uint64_t samples = 0;
+        WidthHistogram operands;  // all four operand terms
+        WidthHistogram results;   // reduced result terms, exact in 64 bits even when int overflows
+        WidthHistogram gcds;      // the gcd the result was reduced by
+    };
+
+    using FractionProfile = std::array<OperatorProfile, static_cast<std::size_t>(ProfiledOp::Count)>;
+
+    // Sampling is compiled in only when every translation unit is built with ARIEL_FRACTION_PROFILE.
+    // It then records one call in every `rate` per thread (default 1024, or ARIEL_FRACTION_PROFILE_RATE
+    // from the environment; 0 stops sampling). A new rate applies to the calling thread at once and to
+    // other threads after their next sample. Setting ARIEL_FRACTION_PROFILE_OUT to a path, or to "-"
+    // for stderr, dumps the profile at exit.
+    void set_fraction_profile_rate(unsigned rate);
+    FractionProfile fraction_profile();
+    void reset_fraction_profile();
+    void dump_fraction_profile(std::ostream& outs);
+
+    namespace detail {
+#ifdef ARIEL_FRACTION_PROFILE
+        // Calls left until this thread's next sample; refilled from the sampling rate after each one.
+        inline thread_local unsigned profileCountdown = 1;
+        __attribute__((cold, noinline)) void profileSample(ProfiledOp op, const Fraction& left, const Fraction& right);
+
+        // Unsampled calls cost a per-thread decrement and a branch. The sampled call recomputes
+        // the exact result out of line, so the operators pass nothing but their operands.
+        inline void profileFraction(ProfiledOp op, const Fraction& left, const Fraction& right) {
+            if (--profileCountdown == 0) {
+                profileSample(op, left, right);
+            }
+        }
+#else
+        inline void profileFraction(ProfiledOp, const Fraction&, const Fraction&) {}
+#endif
+    }
+}
+
+#endif /* FRACTIONPROFILE_HPP */
@@ -0,0 +1,354 @@
+#include "FractionStats.hpp"   // Include header file
+#include <numeric>             // Include std::gcd
+#include <stdexcept>           // Include exception classes
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+    BigInt lcm(const BigInt& first, const BigInt& second) {
+        return first / BigInt::gcd(first, second) * second;
+    }
+
+    // C(n, k) for every k, as doubles.
+    vector<double> binomialRow(int row) {
+        vector<double> coefficients(static_cast<size_t>(row) + 1, 1.0);
+        for (int index = 1; index < row; ++index) {
+            coefficients[static_cast<size_t>(index)] = coefficients[static_cast<size_t>(index) - 1] * (row - index + 1) / index;
+        }
+        return coefficients;
+    }
+}
+
+/**
+ * @brief Construct an empty accumulator.
+ * @param order The highest moment to keep.
+ * @param mode Whether to keep exact power sums as well as approximate ones.
+ * @throws invalid_argument If order is below 1.
+ */
+FractionStats::FractionStats(int order, StatsMode mode)
+        : order(order), mode(mode), count(0), common(1), smallCommon(1), shift(0) {
+    if (order < 1) {
+        throw invalid_argument("Order must be at least 1");
+    }
+    if (mode == StatsMode::Exact) {
+        sums.assign(static_cast<size_t>(order), BigInt(0));
+        pending.assign(static_cast<size_t>(order), 0);
+    }
+    shiftedSums.assign(static_cast<size_t>(order), 0.0);
+}
+
+/**
+ * @brief Move the 128-bit partial sums into the wide ones.
+ */
+void FractionStats::flush() {
+    for (size_t index = 0; index < pending.size(); ++index) {
+        if (pending[index] != 0) {
+            sums[index] += BigInt::fromInt128(pending[index]);
+            pending[index] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Switch to a multiple of the common denominator, scaling the j-th power sum by factor^j.
+ * @param newCommon A multiple of common.
+ */
+void FractionStats::rescale(const BigInt& newCommon) {
+    flush();
+    BigInt factor = newCommon / common;
+    BigInt scale = factor;
+    for (BigInt& sum : sums) {
+        sum *= scale;
+        scale *= factor;
+    }
+    common = newCommon;
+    smallCommon = common.fitsLongLong() ? common.toLongLong() : 0;
+}
+
+/**
+ * @brief Add the powers of value * common to the power sums. While everything fits, the powers are
+ * formed and summed in 128 bits; the wide sums are only touched when a 128-bit partial sum would overflow.
+ * @param value The value.
+ */
+void FractionStats::addExact(const Fraction& value) {
+    long long numerator = value.getNumerator();
+    long long denominator = value.getDenominator();
+    if (smallCommon != 0) {
+        if (smallCommon % denominator != 0) {
+            __int128 next = static_cast<__int128>(smallCommon / std::gcd(smallCommon, denominator)) * denominator;
+            rescale(BigInt::fromInt128(next));
+        }
+    } else if (!(common % BigInt(denominator)).isZero()) {
+        rescale(lcm(common, BigInt(denominator)));
+    }
+    if (smallCommon == 0) {
+        BigInt scaled = BigInt(numerator) * (common / BigInt(denominator));
+        BigInt power = scaled;
+        for (size_t index = 0; index < sums.size(); ++index) {
+            sums[index] += power;
+            power *= scaled;
+        }
+        return;
+    }
+    __int128 scaled = static_cast<__int128>(numerator) * (smallCommon / denominator);
+    __int128 power = scaled;
+    for (size_t index = 0; index < pending.size(); ++index) {
+        __int128 sum = 0;
+        if (__builtin_add_overflow(pending[index], power, &sum)) {
+            sums[index] += BigInt::fromInt128(pending[index]);
+            sum = power;
+        }
+        pending[index] = sum;
+        __int128 next = 0;
+        if (index + 1 < pending.size() && __builtin_mul_overflow(power, scaled, &next)) {
+            // the remaining powers do not fit in 128 bits
+            BigInt wide = BigInt::fromInt128(scaled);
+            BigInt widePower = BigInt::fromInt128(power) * wide;
+            for (++index; index < sums.size(); ++index) {
+                sums[index] += widePower;
+                widePower *= wide;
+            }
+            return;
+        }
+        power = next;
+    }
+}
+
+/**
+ * @brief Add one value.
+ * @param value The value.
+ */
+void FractionStats::add(const Fraction& value) {
+    if (mode == StatsMode::Exact) {
+        addExact(value);
+    }
+    double approximate = static_cast<double>(value.getNumerator()) / value.getDenominator();
+    if (count == 0) {
+        shift = approximate;
+    }
+    double offset = approximate - shift;
+    double power = offset;
+    for (double& sum : shiftedSums) {
+        sum += power;
+        power *= offset;
+    }
+    ++count;
+}
+
+/**
+ * @brief Combine with another accumulator, as if its values had been added here.
+ * @param other An accumulator with the same order and mode.
+ * @throws invalid_argument If the order or mode differs.
+ */
+void FractionStats::merge(const FractionStats& other) {
+    if (other.order != order || other.mode != mode) {
+        throw invalid_argument("Cannot merge statistics of a different order or mode");
+    }
+    if (&other == this) {
+        FractionStats copy(other);
+        merge(copy);
+        return;
+    }
+    if (other.count == 0) {
+        return;
+    }
+    if (mode == StatsMode::Exact) {
+        BigInt newCommon = lcm(common, other.common);
+        if (newCommon != common) {
+            rescale(newCommon);
+        }
+        flush();
+        BigInt factor = common / other.common;
+        BigInt scale = factor;
+        for (size_t index = 0; index < sums.size(); ++index) {
+            sums[index] += (other.sums[index] + BigInt::fromInt128(other.pending[index])) * scale;
+            scale *= factor;
+        }
+    }
+    if (count == 0) {
+        shift = other.shift;
+        shiftedSums = other.shiftedSums;
+    } else {
+        // sum (x - shift)^j = sum_i C(j, i) delta^(j - i) sum (x - other.shift)^i, with delta = other.shift - shift
+        double delta = other.shift - shift;
+        for (int power = 1; power <= order; ++power) {
+            vector<double> binomial = binomialRow(power);
+            double deltaPower = 1;
+            double sum = 0;
+            for (int inner = power; inner >= 0; --inner) {
+                double otherSum = (inner == 0) ? static_cast<double>(other.count) : other.shiftedSums[static_cast<size_t>(inner) - 1];
+                sum += binomial[static_cast<size_t>(inner)] * deltaPower * otherSum;
+                deltaPower *= delta;
+            }
+            shiftedSums[static_cast<size_t>(power) - 1] += sum;
+        }
+    }
+    count += other.count;
+}
+
+/**
+ * @brief Get the number of values added.
+ * @return The count.
+ */
+long long FractionStats::getCount() const {
+    return count;
+}
+
+/**
+ * @brief Get the highest moment kept.
+ * @return The order.
+ */
+int FractionStats::getOrder() const {
+    return order;
+}
+
+/**
+ * @brief Get the mode.
+ * @return Exact or Approximate.
+ */
+StatsMode FractionStats::getMode() const {
+    return mode;
+}
+
+/**
+ * @brief The raw moment: the j-th power sum divided by count.
+ * @param power The power, 1 <= power <= order.
+ * @return sum x^power / count, exactly.
+ */
+BigFraction FractionStats::powerSum(int power) const {
+    size_t index = static_cast<size_t>(power) - 1;
+    BigInt scale = common;
+    for (int step = 1; step < power; ++step) {
+        scale *= common;
+    }
+    return BigFraction(sums[index] + BigInt::fromInt128(pending[index]), scale * BigInt(count));
+}
+
+/**
+ * @brief Get the exact mean.
+ * @return The mean.
+ * @throws logic_error In approximate mode.
+ * @throws runtime_error If no values were added.
+ */
+BigFraction FractionStats::exactMean() const {
+    if (mode != StatsMode::Exact) {
+        throw logic_error("Exact statistics are not kept in approximate mode");
+    }
+    if (count == 0) {
+        throw runtime_error("No values were added");
+    }
+    return powerSum(1);
+}
+
+/**
+ * @brief Get an exact central moment, expanded from the raw moments:
+ * mu_k = sum_j C(k, j) (-mean)^(k - j) m_j, with m_0 = 1.
+ * @param power The order of the moment, 1 <= power <= order.
+ * @return The central moment.
+ * @throws invalid_argument If power is out of range.
+ * @throws logic_error In approximate mode.
+ * @throws runtime_error If no values were added.
+ */
+BigFraction FractionStats::exactMoment(int power) const {
+    if (power < 1 || power > order) {
+        throw invalid_argument("Moment order out of range");
+    }
+    BigFraction negatedMean = -exactMean();
+    BigFraction moment;
+    BigFraction meanPower(BigInt(1));
+    BigInt binomial(1);
+    for (int inner = power; inner >= 0; --inner) {
+        BigFraction raw = (inner == 0) ? BigFraction(BigInt(1)) : powerSum(inner);
+        moment = moment + BigFraction(binomial) * meanPower * raw;
+        meanPower = meanPower * negatedMean;
+        binomial = binomial * BigInt(inner) / BigInt(power - inner + 1);
+    }
+    return moment;
+}
+
+/**
+ * @brief Get the mean as a Fraction.
+ * @return The mean.
+ * @throws overflow_error If it does not fit in a Fraction.
+ */
+Fraction FractionStats::mean() const {
+    return exactMean().toFraction();
+}
+
+/**
+ * @brief Get the population variance as a Fraction.
+ * @return The second central moment.
+ * @throws invalid_argument If order is below 2.
+ * @throws overflow_error If it does not fit in a Fraction.
+ */
+Fraction FractionStats::variance() const {
+    return exactMoment(2).toFraction();
+}
+
+/**
+ * @brief Get the sample variance, with Bessel's correction.
+ * @return The variance times count / (count - 1).
+ * @throws runtime_error For fewer than two values.
+ * @throws overflow_error If it does not fit in a Fraction.
+ */
+Fraction FractionStats::sampleVariance() const {
+    if (count < 2) {
+        throw runtime_error("Sample variance needs at least two values");
+    }
+    return (exactMoment(2) * BigFraction(BigInt(count), BigInt(count - 1))).toFraction();
+}
+
+/**
+ * @brief Get a central moment as a Fraction.
+ * @param power The order of the moment, 1 <= power <= order.
+ * @return The central moment.
+ * @throws overflow_error If it does not fit in a Fraction.
+ */
+Fraction FractionStats::moment(int power) const {
+    return exactMoment(power).toFraction();
+}
+
+/**
+ * @brief Get the mean in floating point.
+ * @return The approximate mean.
+ * @throws runtime_error If no values were added.
+ */
+double FractionStats::approximateMean() const {
+    if (count == 0) {
+        throw runtime_error("No values were added");
+    }
+    return shift + shiftedSums[0] / static_cast<double>(count);
+}
+
+/**
+ * @brief Get the population variance in floating point.
+ * @return The approximate variance.
+ */
+double FractionStats::approximateVariance() const {
+    return approximateMoment(2);
+}
+
+/**
+ * @brief Get a central moment in floating point. The sums are about the first value, not zero,
+ * which keeps the cancellation in the expansion small when values sit far from the origin.
+ * @param power The order of the moment, 1 <= power <= order.
+ * @return The approximate central moment.
+ * @throws invalid_argument If power is out of range.
+ * @throws runtime_error If no values were added.
+ */
+double FractionStats::approximateMoment(int power) const {
+    if (power < 1 || power > order) {
+        throw invalid_argument("Moment order out of range");
+    }
+    double offset = approximateMean() - shift;
+    vector<double> binomial = binomialRow(power);
+    double offsetPower = 1;
+    double moment = 0;
+    for (int inner = power; inner >= 0; --inner) {
+        double raw = (inner == 0) ? 1.0 : shiftedSums[static_cast<size_t>(inner) - 1] / static_cast<double>(count);
+        moment += binomial[static_cast<size_t>(inner)] * offsetPower * raw;
+        offsetPower *= -offset;
+    }
+    return moment;
+}
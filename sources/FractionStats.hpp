@@ -0,0 +1,69 @@
+#ifndef FRACTIONSTATS_HPP
+#define FRACTIONSTATS_HPP
+
+#include "BigFraction.hpp"
+#include "BigInt.hpp"
+#include "Fraction.hpp"
+#include <vector>
+
+namespace ariel {
+
+    enum class StatsMode {
+        Exact,        // power sums in wide integers; exact and approximate results
+        Approximate,  // power sums in doubles only; approximate results
+    };
+
+    // A streaming accumulator of mean, variance and central moments up to a chosen order.
+    // Exact mode keeps sum (x * common)^j as integers over one common denominator, so adding a value
+    // costs a few integer multiplications and nothing is reduced until a result is asked for.
+    class FractionStats {
+        private:
+            int order;
+            StatsMode mode;
+            long long count;
+
+            // exact: the j-th power sum is (sums[j-1] + pending[j-1]) / common^j
+            BigInt common;
+            long long smallCommon;  // common, while it fits in long long; 0 otherwise
+            std::vector<BigInt> sums;
+            std::vector<__int128> pending;
+
+            // approximate: the j-th power sum of (x - shift), shifted to keep cancellation small
+            double shift;
+            std::vector<double> shiftedSums;
+
+            void flush();
+            void rescale(const BigInt& newCommon);
+            void addExact(const Fraction& value);
+            BigFraction powerSum(int power) const;
+
+        public:
+            // constructors
+            explicit FractionStats(int order = 4, StatsMode mode = StatsMode::Exact);  // throws std::invalid_argument if order < 1
+
+            // accumulation
+            void add(const Fraction& value);
+            void merge(const FractionStats& other);  // throws std::invalid_argument unless order and mode match
+
+            // getter functions
+            long long getCount() const;
+            int getOrder() const;
+            StatsMode getMode() const;
+
+            // exact results; throw std::logic_error in approximate mode, std::runtime_error when empty,
+            // and std::overflow_error (the Fraction versions) when the result does not fit
+            BigFraction exactMean() const;
+            BigFraction exactMoment(int power) const;  // central moment, 1 <= power <= order
+            Fraction mean() const;
+            Fraction variance() const;                 // population variance
+            Fraction sampleVariance() const;           // throws std::runtime_error for fewer than two values
+            Fraction moment(int power) const;
+
+            // approximate results in either mode; throw std::runtime_error when empty
+            double approximateMean() const;
+            double approximateVariance() const;
+            double approximateMoment(int power) const;
+    };
+}
+
+#endif /* FRACTIONSTATS_HPP */
@@ -0,0 +1,127 @@
+#include "FractionVector.hpp"   // Include header file
+
+using namespace ariel;   // Use namespace ariel
+
+/**
+ * @brief Create an empty FractionVector.
+ */
+FractionVector::FractionVector() = default;
+
+/**
+ * @brief Create a FractionVector holding count fractions equal to 0/1.
+ * @param count The number of fractions.
+ */
+FractionVector::FractionVector(std::size_t count) : numerators(count, 0), denominators(count, 1) {}
+
+/**
+ * @brief Get the number of fractions.
+ * @return The number of fractions stored.
+ */
+std::size_t FractionVector::size() const {
+    return numerators.size();
+}
+
+/**
+ * @brief Check whether the vector holds no fractions.
+ * @return true if the vector is empty, false otherwise.
+ */
+bool FractionVector::empty() const {
+    return numerators.empty();
+}
+
+/**
+ * @brief Change the number of fractions, filling new slots with 0/1.
+ * @param count The new number of fractions.
+ */
+void FractionVector::resize(std::size_t count) {
+    numerators.resize(count, 0);
+    denominators.resize(count, 1);
+}
+
+/**
+ * @brief Preallocate room for count fractions in both columns.
+ * @param count The number of fractions to make room for.
+ */
+void FractionVector::reserve(std::size_t count) {
+    numerators.reserve(count);
+    denominators.reserve(count);
+}
+
+/**
+ * @brief Remove all fractions.
+ */
+void FractionVector::clear() {
+    numerators.clear();
+    denominators.clear();
+}
+
+/**
+ * @brief Get the fraction at the given index.
+ * @param index The position of the fraction.
+ * @return The fraction stored at index.
+ */
+Fraction FractionVector::operator[](std::size_t index) const {
+    return Fraction::fromReduced(numerators[index], denominators[index]);
+}
+
+/**
+ * @brief Store a fraction at the given index.
+ * @param index The position to write.
+ * @param fraction The fraction to store.
+ */
+void FractionVector::set(std::size_t index, const Fraction& fraction) {
+    numerators[index] = fraction.getNumerator();
+    denominators[index] = fraction.getDenominator();
+}
+
+/**
+ * @brief Store a numerator/denominator pair at the given index without reducing it.
+ * @param index The position to write.
+ * @param numerator The numerator, already reduced against denominator.
+ * @param denominator The denominator, already positive and reduced.
+ */
+void FractionVector::set(std::size_t index, int numerator, int denominator) {
+    numerators[index] = numerator;
+    denominators[index] = denominator;
+}
+
+/**
+ * @brief Append a fraction to the end of the vector.
+ * @param fraction The fraction to append.
+ */
+void FractionVector::push_back(const Fraction& fraction) {
+    numerators.push_back(fraction.getNumerator());
+    denominators.push_back(fraction.getDenominator());
+}
+
+/**
+ * @brief Get the numerator column.
+ * @return A pointer to size() contiguous numerators.
+ */
+int* FractionVector::numeratorData() {
+    return numerators.data();
+}
+
+/**
+ * @brief Get the denominator column.
+ * @return A pointer to size() contiguous denominators.
+ */
+int* FractionVector::denominatorData() {
+    return denominators.data();
+}
+
+/**
+ * @brief Get the numerator column.
+ * @return A pointer to size() contiguous numerators.
+ */
+const int* FractionVector::numeratorData() const {
+    return numerators.data();
+}
+
+/**
+ * @brief Get the denominator column.
+ * @return A pointer to size() contiguous denominators.
+ */
+const int* FractionVector::denominatorData() const {
+    return denominators.data();
+}
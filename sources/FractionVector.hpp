@@ -0,0 +1,42 @@
+#ifndef FRACTIONVECTOR_HPP
+#define FRACTIONVECTOR_HPP
+
+#include "Fraction.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace ariel {
+
+    // A structure-of-arrays sequence of fractions: numerators and denominators live in separate columns.
+    class FractionVector {
+        private:
+            std::vector<int> numerators;
+            std::vector<int> denominators;
+
+        public:
+            // constructors
+            FractionVector();
+            explicit FractionVector(std::size_t count);  // count fractions, all 0/1
+
+            // size functions
+            std::size_t size() const;
+            bool empty() const;
+            void resize(std::size_t count);
+            void reserve(std::size_t count);
+            void clear();
+
+            // element access
+            Fraction operator[](std::size_t index) const;
+            void set(std::size_t index, const Fraction& fraction);
+            void set(std::size_t index, int numerator, int denominator);  // caller keeps the pair reduced
+            void push_back(const Fraction& fraction);
+
+            // column access
+            int* numeratorData();
+            int* denominatorData();
+            const int* numeratorData() const;
+            const int* denominatorData() const;
+    };
+}
+
+#endif /* FRACTIONVECTOR_HPP */
@@ -0,0 +1,86 @@
+#include "MappedFile.hpp"   // Include header file
+#include <stdexcept>        // Include exception classes
+#include <utility>          // Include std::exchange
+#include <fcntl.h>          // Include open
+#include <sys/mman.h>       // Include mmap and munmap
+#include <sys/stat.h>       // Include fstat
+#include <unistd.h>         // Include close
+
+using namespace ariel;   // Use namespace ariel
+
+/**
+ * @brief Map the whole file at path into memory, read-only.
+ * @param path The file to map.
+ * @throws runtime_error If the file cannot be opened, inspected or mapped.
+ * An empty file yields an empty mapping without calling mmap.
+ */
+MappedFile::MappedFile(const std::string& path) : bytes(nullptr), length(0) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat " + path);
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    if (length > 0) {
+        void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map " + path);
+        }
+        ::madvise(mapping, length, MADV_WILLNEED);
+        bytes = static_cast<const char*>(mapping);
+    }
+    ::close(fd);
+}
+
+/**
+ * @brief Take over the mapping of other, leaving it empty.
+ * @param other The mapping to move from.
+ */
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : bytes(std::exchange(other.bytes, nullptr)), length(std::exchange(other.length, 0)) {}
+
+/**
+ * @brief Release the current mapping and take over the mapping of other.
+ * @param other The mapping to move from.
+ * @return This mapping.
+ */
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        if (bytes != nullptr) {
+            ::munmap(const_cast<char*>(bytes), length);
+        }
+        bytes = std::exchange(other.bytes, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
+
+/**
+ * @brief Unmap the file.
+ */
+MappedFile::~MappedFile() {
+    if (bytes != nullptr) {
+        ::munmap(const_cast<char*>(bytes), length);
+    }
+}
+
+/**
+ * @brief Get the first byte of the mapping.
+ * @return A pointer to the mapped bytes, or nullptr for an empty file.
+ */
+const char* MappedFile::data() const {
+    return bytes;
+}
+
+/**
+ * @brief Get the size of the mapping.
+ * @return The number of mapped bytes.
+ */
+std::size_t MappedFile::size() const {
+    return length;
+}
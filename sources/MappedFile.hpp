@@ -0,0 +1,30 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace ariel {
+
+    // A read-only memory mapping of a whole file, released on destruction.
+    class MappedFile {
+        private:
+            const char* bytes;
+            std::size_t length;
+
+        public:
+            // constructors
+            explicit MappedFile(const std::string& path);
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            MappedFile(MappedFile&& other) noexcept;
+            MappedFile& operator=(MappedFile&& other) noexcept;
+            ~MappedFile();
+
+            // getter functions
+            const char* data() const;
+            std::size_t size() const;
+    };
+}
+
+#endif /* MAPPEDFILE_HPP */
@@ -0,0 +1,363 @@
+#include "ModularEngine.hpp"   // Include header file
+#include <algorithm>           // Include std::min and std::swap
+#include "FractionDetail.hpp"  // Include detail::runParallel
+#include <atomic>              // Include the stop flag
+#include <mutex>               // Include the fold lock
+#include <stdexcept>           // Include exception classes
+#include <thread>              // Include thread::hardware_concurrency
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+    // Primes are taken downward from here, so every residue and product of two residues fits an unsigned __int128.
+    const uint64_t PRIME_CEILING = uint64_t(1) << 62;
+
+    uint64_t multiplyMod(uint64_t left, uint64_t right, uint64_t modulus) {
+        return static_cast<uint64_t>(static_cast<unsigned __int128>(left) * right % modulus);
+    }
+
+    uint64_t powerMod(uint64_t base, uint64_t exponent, uint64_t modulus) {
+        uint64_t result = 1 % modulus;
+        for (base %= modulus; exponent != 0; exponent >>= 1) {
+            if ((exponent & 1) != 0) {
+                result = multiplyMod(result, base, modulus);
+            }
+            base = multiplyMod(base, base, modulus);
+        }
+        return result;
+    }
+
+    // Miller-Rabin with the first twelve prime bases, which is deterministic for every 64-bit candidate.
+    bool isPrime(uint64_t candidate) {
+        const uint64_t bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+        for (uint64_t base : bases) {
+            if (candidate % base == 0) {
+                return candidate == base;
+            }
+        }
+        uint64_t odd = candidate - 1;
+        int twos = 0;
+        for (; (odd & 1) == 0; odd >>= 1) {
+            ++twos;
+        }
+        for (uint64_t base : bases) {
+            uint64_t value = powerMod(base, odd, candidate);
+            if (value == 1 || value == candidate - 1) {
+                continue;
+            }
+            bool composite = true;
+            for (int round = 1; round < twos && composite; ++round) {
+                value = multiplyMod(value, value, candidate);
+                composite = value != candidate - 1;
+            }
+            if (composite) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The largest prime below the given odd bound.
+    uint64_t primeBelow(uint64_t bound) {
+        uint64_t candidate = bound - 2;
+        while (!isPrime(candidate)) {
+            candidate -= 2;
+        }
+        return candidate;
+    }
+
+    uint64_t residueOf(const BigInt& value, uint64_t modulus) {
+        return static_cast<uint64_t>((value % BigInt(static_cast<long long>(modulus))).toLongLong());
+    }
+
+    /**
+     * @brief Fold one more residue into value mod product, keeping value in [0, product).
+     */
+    void combine(BigInt& value, BigInt& product, uint64_t residue, uint64_t prime) {
+        PrimeField field(prime);
+        uint64_t step = field.divide(field.subtract(residue, residueOf(value, prime)), residueOf(product, prime));
+        value += product * BigInt(static_cast<long long>(step));
+        product *= BigInt(static_cast<long long>(prime));
+    }
+
+    /**
+     * @brief Find n/d with n^2, d^2 < product/2 and n = d * value (mod product), by the half-extended Euclid.
+     * @return false when no such fraction exists yet, i.e. more primes are needed.
+     */
+    bool reconstruct(const BigInt& value, const BigInt& product, BigFraction& result) {
+        BigInt remainder0 = product, remainder1 = value;
+        BigInt cofactor0(0), cofactor1(1);
+        BigInt quotient, rest;
+        while (remainder1 * remainder1 * BigInt(2) >= product) {
+            BigInt::divmod(remainder0, remainder1, quotient, rest);
+            remainder0 = remainder1;
+            remainder1 = rest;
+            BigInt next = cofactor0 - quotient * cofactor1;
+            cofactor0 = cofactor1;
+            cofactor1 = next;
+        }
+        if (cofactor1.isZero() || cofactor1 * cofactor1 * BigInt(2) >= product || BigInt::gcd(remainder1, cofactor1) != BigInt(1)) {
+            return false;
+        }
+        if (cofactor1.sign() < 0) {
+            remainder1 = -remainder1;
+            cofactor1 = -cofactor1;
+        }
+        result = BigFraction::fromReduced(remainder1, cofactor1);
+        return true;
+    }
+}
+
+/**
+ * @brief Construct the field of integers modulo a prime.
+ * @param modulus A prime below 2^62; primality is not checked.
+ * @throws invalid_argument If the modulus is below 2 or not below 2^62.
+ */
+PrimeField::PrimeField(uint64_t modulus) : modulus(modulus) {
+    if (modulus < 2 || modulus >= PRIME_CEILING) {
+        throw invalid_argument("Modulus must be a prime below 2^62");
+    }
+}
+
+/**
+ * @brief Get the modulus.
+ * @return The prime.
+ */
+uint64_t PrimeField::getModulus() const {
+    return modulus;
+}
+
+/**
+ * @brief Add two residues.
+ * @return (left + right) mod p.
+ */
+uint64_t PrimeField::add(uint64_t left, uint64_t right) const {
+    uint64_t sum = left + right;
+    return sum >= modulus ? sum - modulus : sum;
+}
+
+/**
+ * @brief Subtract two residues.
+ * @return (left - right) mod p.
+ */
+uint64_t PrimeField::subtract(uint64_t left, uint64_t right) const {
+    return left >= right ? left - right : left + modulus - right;
+}
+
+/**
+ * @brief Multiply two residues.
+ * @return (left * right) mod p.
+ */
+uint64_t PrimeField::multiply(uint64_t left, uint64_t right) const {
+    return multiplyMod(left, right, modulus);
+}
+
+/**
+ * @brief Raise a residue to a power by squaring.
+ * @return base^exponent mod p.
+ */
+uint64_t PrimeField::power(uint64_t base, uint64_t exponent) const {
+    return powerMod(base, exponent, modulus);
+}
+
+/**
+ * @brief Invert a residue by Fermat's little theorem.
+ * @param value The residue.
+ * @return value^(p-2) mod p.
+ * @throws domain_error If the value is 0 mod p.
+ */
+uint64_t PrimeField::inverse(uint64_t value) const {
+    if (value % modulus == 0) {
+        throw domain_error("Value has no inverse modulo the prime");
+    }
+    return powerMod(value, modulus - 2, modulus);
+}
+
+/**
+ * @brief Divide two residues.
+ * @return left / right mod p.
+ * @throws domain_error If right is 0 mod p.
+ */
+uint64_t PrimeField::divide(uint64_t left, uint64_t right) const {
+    return multiply(left, inverse(right));
+}
+
+/**
+ * @brief Map an integer into the field.
+ * @param value The integer.
+ * @return value mod p, in [0, p).
+ */
+uint64_t PrimeField::fromInt(long long value) const {
+    long long residue = value % static_cast<long long>(modulus);
+    return static_cast<uint64_t>(residue < 0 ? residue + static_cast<long long>(modulus) : residue);
+}
+
+/**
+ * @brief Map a fraction into the field.
+ * @param value The fraction.
+ * @return numerator / denominator mod p.
+ * @throws domain_error If p divides the denominator.
+ */
+uint64_t PrimeField::fromFraction(const Fraction& value) const {
+    return divide(fromInt(value.getNumerator()), fromInt(value.getDenominator()));
+}
+
+/**
+ * @brief Recover an exact rational from its images in word-sized prime fields.
+ * The primes are spread over one worker pool; as soon as a run of primes from the first is finished their
+ * residues are folded in by CRT, and after every threads primes a rational reconstruction is attempted.
+ * The result is returned once two attempts in a row reconstruct the same value; primes not yet started are skipped.
+ * @param compute Returns the result modulo field.getModulus(); may throw domain_error for an unlucky prime.
+ * @param threads The number of worker threads, or 0 for one per hardware thread.
+ * @param maxPrimes The number of primes to try before giving up.
+ * @return The exact result.
+ * @throws runtime_error If the result has not stabilized after maxPrimes primes.
+ */
+BigFraction ariel::modular_reconstruct(const function<uint64_t(const PrimeField&)>& compute, unsigned threads, size_t maxPrimes) {
+    if (threads == 0) {
+        threads = max(1U, thread::hardware_concurrency());
+    }
+    enum : char { PENDING, LUCKY, UNLUCKY };
+    vector<uint64_t> primes;
+    vector<uint64_t> residues(maxPrimes);
+    vector<char> states(maxPrimes, PENDING);
+    BigInt value(0), product(1);
+    BigFraction previous, current;
+    bool havePrevious = false;
+    bool added = false;
+    bool converged = false;
+    size_t folded = 0;
+    atomic<bool> done{false};
+    mutex lock;
+
+    // Fold every finished prime that directly follows the ones already folded; the caller holds the lock.
+    auto fold = [&]() {
+        for (; folded < maxPrimes && states[folded] != PENDING && !done; ++folded) {
+            if (states[folded] == LUCKY) {
+                combine(value, product, residues[folded] % primes[folded], primes[folded]);
+                added = true;
+            }
+            if ((folded + 1) % threads != 0 && folded + 1 != maxPrimes) {
+                continue;
+            }
+            if (!added) {
+                continue;
+            }
+            added = false;
+            if (!reconstruct(value, product, current)) {
+                havePrevious = false;
+                continue;
+            }
+            if (havePrevious && current == previous) {
+                converged = true;
+                done = true;
+                break;
+            }
+            previous = current;
+            havePrevious = true;
+        }
+    };
+
+    detail::runParallel(maxPrimes, threads, [&](size_t index) {
+        if (done) {
+            return;
+        }
+        uint64_t prime = 0;
+        {
+            lock_guard<mutex> guard(lock);
+            while (primes.size() <= index) {
+                primes.push_back(primeBelow(primes.empty() ? PRIME_CEILING + 1 : primes.back()));
+            }
+            prime = primes[index];
+        }
+        char state = LUCKY;
+        uint64_t residue = 0;
+        try {
+            residue = compute(PrimeField(prime));
+        } catch (const domain_error&) {
+            state = UNLUCKY;
+        } catch (...) {
+            done = true;
+            throw;
+        }
+        lock_guard<mutex> guard(lock);
+        residues[index] = residue;
+        states[index] = state;
+        fold();
+    });
+    if (converged) {
+        return current;
+    }
+    throw runtime_error("Modular reconstruction did not converge");
+}
+
+/**
+ * @brief Sum fractions exactly. In each field the sum is kept as one numerator over one denominator,
+ * so a term costs three multiplications and only the final division needs an inverse.
+ * @param values The terms.
+ * @param threads The number of worker threads, or 0 for one per hardware thread.
+ * @return The exact sum.
+ */
+BigFraction ariel::modular_sum(const vector<Fraction>& values, unsigned threads) {
+    return modular_reconstruct(
+        [&values](const PrimeField& field) {
+            uint64_t numerator = 0, denominator = 1;
+            for (const Fraction& value : values) {
+                uint64_t termDenominator = field.fromInt(value.getDenominator());
+                numerator = field.add(field.multiply(numerator, termDenominator), field.multiply(field.fromInt(value.getNumerator()), denominator));
+                denominator = field.multiply(denominator, termDenominator);
+            }
+            return field.divide(numerator, denominator);
+        },
+        threads);
+}
+
+/**
+ * @brief Compute a determinant exactly by Gaussian elimination in each field.
+ * @param matrix A square matrix, as rows.
+ * @param threads The number of worker threads, or 0 for one per hardware thread.
+ * @return The exact determinant; 1 for the empty matrix.
+ * @throws invalid_argument If the matrix is not square.
+ */
+BigFraction ariel::modular_determinant(const vector<vector<Fraction>>& matrix, unsigned threads) {
+    size_t size = matrix.size();
+    for (const vector<Fraction>& row : matrix) {
+        if (row.size() != size) {
+            throw invalid_argument("Matrix must be square");
+        }
+    }
+    return modular_reconstruct(
+        [&matrix, size](const PrimeField& field) {
+            vector<vector<uint64_t>> rows(size, vector<uint64_t>(size));
+            for (size_t row = 0; row < size; ++row) {
+                for (size_t column = 0; column < size; ++column) {
+                    rows[row][column] = field.fromFraction(matrix[row][column]);
+                }
+            }
+            uint64_t determinant = 1;
+            for (size_t column = 0; column < size; ++column) {
+                size_t pivot = column;
+                while (pivot < size && rows[pivot][column] == 0) {
+                    ++pivot;
+                }
+                if (pivot == size) {
+                    return uint64_t(0);
+                }
+                if (pivot != column) {
+                    swap(rows[pivot], rows[column]);
+                    determinant = field.subtract(0, determinant);
+                }
+                determinant = field.multiply(determinant, rows[column][column]);
+                uint64_t inverse = field.inverse(rows[column][column]);
+                for (size_t row = column + 1; row < size; ++row) {
+                    uint64_t factor = field.multiply(rows[row][column], inverse);
+                    for (size_t rest = column; rest < size && factor != 0; ++rest) {
+                        rows[row][rest] = field.subtract(rows[row][rest], field.multiply(factor, rows[column][rest]));
+                    }
+                }
+            }
+            return determinant;
+        },
+        threads);
+}
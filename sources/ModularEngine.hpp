@@ -0,0 +1,50 @@
+#ifndef MODULARENGINE_HPP
+#define MODULARENGINE_HPP
+
+#include "BigFraction.hpp"
+#include "Fraction.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ariel {
+
+    // Arithmetic modulo a prime below 2^62. Values are kept in [0, modulus).
+    class PrimeField {
+        private:
+            std::uint64_t modulus;
+
+        public:
+            // constructors
+            explicit PrimeField(std::uint64_t modulus);
+
+            // getter functions
+            std::uint64_t getModulus() const;
+
+            // field arithmetic
+            std::uint64_t add(std::uint64_t left, std::uint64_t right) const;
+            std::uint64_t subtract(std::uint64_t left, std::uint64_t right) const;
+            std::uint64_t multiply(std::uint64_t left, std::uint64_t right) const;
+            std::uint64_t power(std::uint64_t base, std::uint64_t exponent) const;
+            std::uint64_t inverse(std::uint64_t value) const;  // throws std::domain_error for 0: the prime is unlucky
+            std::uint64_t divide(std::uint64_t left, std::uint64_t right) const;
+
+            // mapping into the field
+            std::uint64_t fromInt(long long value) const;
+            std::uint64_t fromFraction(const Fraction& value) const;
+    };
+
+    // Run compute in several prime fields, spread over threads (0 = one per core), and recover the exact
+    // rational by CRT and rational reconstruction. Primes are added in batches until two reconstructions
+    // in a row agree. A prime for which compute throws std::domain_error is skipped as unlucky.
+    // Throws std::runtime_error if maxPrimes primes are not enough.
+    BigFraction modular_reconstruct(const std::function<std::uint64_t(const PrimeField&)>& compute, unsigned threads = 0,
+                                    std::size_t maxPrimes = 4096);
+
+    // Exact helpers built on modular_reconstruct.
+    BigFraction modular_sum(const std::vector<Fraction>& values, unsigned threads = 0);
+    BigFraction modular_determinant(const std::vector<std::vector<Fraction>>& matrix, unsigned threads = 0);  // throws std::invalid_argument unless square
+}
+
+#endif /* MODULARENGINE_HPP */
@@ -0,0 +1,275 @@
+#include "Quantizer.hpp"       // Include header file
+#include "FareySequence.hpp"   // Include the table source
+#include <cmath>               // Include std::floor, std::frexp and std::ldexp
+#include <limits>              // Include numeric limits
+#include <stdexcept>           // Include exception classes
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+    /**
+     * @brief Split a value into its integer part and a remainder in [0, 1).
+     * @throws invalid_argument If the value is not finite.
+     * @throws overflow_error If the integer part does not fit in int.
+     */
+    double splitWhole(double value, double& part) {
+        if (!isfinite(value)) {
+            throw invalid_argument("Cannot quantize a value that is not finite");
+        }
+        double whole = std::floor(value);
+        if (whole < numeric_limits<int>::min() || whole > numeric_limits<int>::max()) {
+            throw overflow_error("Quantizing the value would result in integer overflow!");
+        }
+        part = value - whole;
+        if (part >= 1.0) {  // value - floor(value) rounds up to 1 for tiny negative values
+            part = nextafter(1.0, 0.0);
+        }
+        return whole;
+    }
+
+    // value - whole exactly, as remainder / 2^shift with 0 <= remainder < 2^shift.
+    struct ExactPart {
+        __int128 remainder;
+        int shift;
+    };
+
+    /**
+     * @brief Recover value - whole exactly; part = value - whole in double is rounded for negative values.
+     * @param value A finite value whose floor fits in int.
+     * @param whole The floor of the value.
+     */
+    ExactPart exactPart(double value, double whole) {
+        int exponent = 0;
+        double mantissa = frexp(value, &exponent);
+        // Below 2^-41 every entry but 0/1 and 1/1 is farther away than the value, so a stand-in at 2^-64 from 0 compares the same.
+        if (value != 0 && exponent < -40) {
+            return value > 0 ? ExactPart{1, 64} : ExactPart{(__int128{1} << 64) - 1, 64};
+        }
+        // |value| < 2^31 + 1 and |value| >= 2^-41, so 21 <= shift <= 93 and every product below fits in 128 bits.
+        int shift = 53 - exponent;
+        auto significand = static_cast<long long>(ldexp(mantissa, 53));
+        return ExactPart{significand - static_cast<__int128>(static_cast<long long>(whole)) * (__int128{1} << shift), shift};
+    }
+
+    /**
+     * @brief Measure an exact remainder against a table fraction.
+     * @return (part - term) * denominator * 2^shift: its sign orders the two, and the value is the double
+     * nearest to whole + term exactly when twice its magnitude is at most the denominator (half an ulp).
+     */
+    __int128 gap(const ExactPart& part, const Fraction& term) {
+        return part.remainder * term.getDenominator() - static_cast<__int128>(term.getNumerator()) * (__int128{1} << part.shift);
+    }
+
+    bool roundsTo(const ExactPart& part, const Fraction& term) {
+        __int128 distance = gap(part, term);
+        return 2 * (distance < 0 ? -distance : distance) <= term.getDenominator();
+    }
+}
+
+/**
+ * @brief Precompute the Farey sequence of the given order.
+ * @param order The largest denominator a result may have.
+ * @throws invalid_argument If order is less than 1.
+ */
+Quantizer::Quantizer(int order) : order(order), paddedSize(1) {
+    if (order < 1) {
+        throw invalid_argument("Quantizer order must be at least 1");
+    }
+    for (Fraction term : FareySequence(order)) {
+        fractions.push_back(term);
+    }
+    while (paddedSize < fractions.size()) {
+        paddedSize *= 2;
+    }
+    values.reset(static_cast<double*>(::operator new[](paddedSize * sizeof(double), align_val_t(64))));
+    for (size_t index = 0; index < paddedSize; ++index) {
+        values[index] = index < fractions.size()
+            ? static_cast<double>(fractions[index].getNumerator()) / fractions[index].getDenominator()
+            : numeric_limits<double>::infinity();
+    }
+}
+
+/**
+ * @brief Get the largest denominator a result may have.
+ * @return The order.
+ */
+int Quantizer::getOrder() const {
+    return order;
+}
+
+/**
+ * @brief Get the number of fractions in [0, 1] with denominator at most the order.
+ * @return The table size, without padding.
+ */
+size_t Quantizer::size() const {
+    return fractions.size();
+}
+
+/**
+ * @brief Find the last table entry <= part. The table size is a power of two, so the loop always runs
+ * log2(size) times and compiles to conditional moves instead of branches.
+ * @param part A value in [0, 1).
+ * @return The index of the floor entry.
+ */
+size_t Quantizer::floorIndex(double part) const {
+    size_t base = 0;
+    for (size_t half = paddedSize / 2; half > 0; half /= 2) {
+        base = (values[base + half] <= part) ? base + half : base;
+    }
+    return base;
+}
+
+/**
+ * @brief Shift a table fraction by an integer.
+ * @return whole + fractions[index].
+ * @throws overflow_error If the numerator does not fit in int.
+ */
+Fraction Quantizer::place(double whole, size_t index) const {
+    const Fraction& term = fractions[index];
+    long long numerator = static_cast<long long>(whole) * term.getDenominator() + term.getNumerator();
+    if (numerator < numeric_limits<int>::min() || numerator > numeric_limits<int>::max()) {
+        throw overflow_error("Quantizing the value would result in integer overflow!");
+    }
+    return Fraction::fromReduced(static_cast<int>(numerator), term.getDenominator());
+}
+
+/**
+ * @brief Move a floor index to the entry the rounding mode asks for. The search ran on rounded doubles,
+ * so floor and ceiling first step the index to the exact floor of value - whole. A value that is the
+ * double nearest to a table fraction then counts as that fraction, so floor(1.0 / 3) is 1/3.
+ * @param index The floor index of part.
+ * @param value The value being quantized.
+ * @param whole The floor of the value.
+ * @param part value - whole, rounded to a double in [0, 1).
+ * @return The index of the nearest (ties to the smaller), floor or ceiling entry.
+ */
+size_t Quantizer::round(size_t index, double value, double whole, double part, Rounding rounding) const {
+    // part < 1 = the last real entry, so index + 1 never reaches the padding.
+    if (rounding == Rounding::Nearest) {
+        return index + static_cast<size_t>(values[index + 1] - part < part - values[index]);
+    }
+    ExactPart exact = exactPart(value, whole);
+    while (index > 0 && gap(exact, fractions[index]) < 0) {
+        --index;
+    }
+    while (gap(exact, fractions[index + 1]) >= 0) {
+        ++index;
+    }
+    if (rounding == Rounding::Floor) {
+        return index + static_cast<size_t>(roundsTo(exact, fractions[index + 1]));
+    }
+    return index + static_cast<size_t>(gap(exact, fractions[index]) != 0 && !roundsTo(exact, fractions[index]));
+}
+
+/**
+ * @brief Quantize one value.
+ * @throws invalid_argument If the value is not finite.
+ * @throws overflow_error If the result does not fit in int.
+ */
+Fraction Quantizer::quantize(double value, Rounding rounding) const {
+    double part = 0;
+    double whole = splitWhole(value, part);
+    return place(whole, round(floorIndex(part), value, whole, part, rounding));
+}
+
+/**
+ * @brief Quantize an array. Four searches run in lockstep so their dependent loads overlap
+ * instead of queueing behind each other.
+ * @throws invalid_argument If a value is not finite.
+ * @throws overflow_error If a result does not fit in int.
+ * A throw leaves out partly written: values are checked four at a time before any of the four is
+ * written, so outputs up to three places before the failing value may be missing too.
+ */
+void Quantizer::quantize(const double* input, size_t count, Fraction* out, Rounding rounding) const {
+    size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        double parts[4];
+        double wholes[4];
+        size_t bases[4] = {0, 0, 0, 0};
+        for (size_t lane = 0; lane < 4; ++lane) {
+            wholes[lane] = splitWhole(input[index + lane], parts[lane]);
+        }
+        for (size_t half = paddedSize / 2; half > 0; half /= 2) {
+            bases[0] += (values[bases[0] + half] <= parts[0]) ? half : 0;
+            bases[1] += (values[bases[1] + half] <= parts[1]) ? half : 0;
+            bases[2] += (values[bases[2] + half] <= parts[2]) ? half : 0;
+            bases[3] += (values[bases[3] + half] <= parts[3]) ? half : 0;
+        }
+        for (size_t lane = 0; lane < 4; ++lane) {
+            out[index + lane] = place(wholes[lane], round(bases[lane], input[index + lane], wholes[lane], parts[lane], rounding));
+        }
+    }
+    for (; index < count; ++index) {
+        out[index] = quantize(input[index], rounding);
+    }
+}
+
+/**
+ * @brief Find the closest fraction with denominator at most the order.
+ * @param value The value to quantize.
+ * @return The closest fraction; of two equally close, the smaller.
+ * @throws invalid_argument If the value is not finite.
+ * @throws overflow_error If the result does not fit in int.
+ */
+Fraction Quantizer::nearest(double value) const {
+    return quantize(value, Rounding::Nearest);
+}
+
+/**
+ * @brief Find the largest fraction not greater than the value.
+ * @param value The value to quantize.
+ * @return The floor fraction.
+ * @throws invalid_argument If the value is not finite.
+ * @throws overflow_error If the result does not fit in int.
+ */
+Fraction Quantizer::floor(double value) const {
+    return quantize(value, Rounding::Floor);
+}
+
+/**
+ * @brief Find the smallest fraction not less than the value.
+ * @param value The value to quantize.
+ * @return The ceiling fraction.
+ * @throws invalid_argument If the value is not finite.
+ * @throws overflow_error If the result does not fit in int.
+ */
+Fraction Quantizer::ceil(double value) const {
+    return quantize(value, Rounding::Ceil);
+}
+
+/**
+ * @brief Quantize an array of values to their nearest fractions.
+ * @param input The values.
+ * @param count The number of values.
+ * @param out Receives count fractions.
+ * @throws invalid_argument If a value is not finite.
+ * @throws overflow_error If a result does not fit in int. A throw leaves out partly written.
+ */
+void Quantizer::nearest(const double* input, size_t count, Fraction* out) const {
+    quantize(input, count, out, Rounding::Nearest);
+}
+
+/**
+ * @brief Quantize an array of values to their floor fractions.
+ * @param input The values.
+ * @param count The number of values.
+ * @param out Receives count fractions.
+ * @throws invalid_argument If a value is not finite.
+ * @throws overflow_error If a result does not fit in int. A throw leaves out partly written.
+ */
+void Quantizer::floor(const double* input, size_t count, Fraction* out) const {
+    quantize(input, count, out, Rounding::Floor);
+}
+
+/**
+ * @brief Quantize an array of values to their ceiling fractions.
+ * @param input The values.
+ * @param count The number of values.
+ * @param out Receives count fractions.
+ * @throws invalid_argument If a value is not finite.
+ * @throws overflow_error If a result does not fit in int. A throw leaves out partly written.
+ */
+void Quantizer::ceil(const double* input, size_t count, Fraction* out) const {
+    quantize(input, count, out, Rounding::Ceil);
+}
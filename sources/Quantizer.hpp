@@ -0,0 +1,56 @@
+#ifndef QUANTIZER_HPP
+#define QUANTIZER_HPP
+
+#include "Fraction.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace ariel {
+
+    // Maps doubles to fractions whose denominator is at most a fixed order. The Farey sequence of that
+    // order is precomputed once into a cache-line aligned table of doubles, padded to a power of two so
+    // every lookup is the same branchless binary search, next to the matching Fraction table.
+    // The integer part of a value is split off first, so any value whose result fits in int works.
+    // Floor and ceiling are exact, except that a double that is the closest one to a fraction counts as that fraction.
+    class Quantizer {
+        private:
+            enum class Rounding { Nearest, Floor, Ceil };
+
+            struct AlignedDelete {
+                void operator()(double* table) const { ::operator delete[](table, std::align_val_t(64)); }
+            };
+
+            int order;
+            std::size_t paddedSize;
+            std::unique_ptr<double[], AlignedDelete> values;
+            std::vector<Fraction> fractions;
+
+            std::size_t floorIndex(double part) const;
+            Fraction place(double whole, std::size_t index) const;
+            std::size_t round(std::size_t index, double value, double whole, double part, Rounding rounding) const;
+            Fraction quantize(double value, Rounding rounding) const;
+            void quantize(const double* input, std::size_t count, Fraction* out, Rounding rounding) const;
+
+        public:
+            // constructors
+            explicit Quantizer(int order);
+
+            // getter functions
+            int getOrder() const;
+            std::size_t size() const;  // the number of fractions in [0, 1]
+
+            // single queries
+            Fraction nearest(double value) const;  // ties go to the smaller fraction
+            Fraction floor(double value) const;    // the largest fraction <= value
+            Fraction ceil(double value) const;     // the smallest fraction >= value
+
+            // batch queries: out must have room for count fractions
+            void nearest(const double* input, std::size_t count, Fraction* out) const;
+            void floor(const double* input, std::size_t count, Fraction* out) const;
+            void ceil(const double* input, std::size_t count, Fraction* out) const;
+    };
+}
+
+#endif /* QUANTIZER_HPP */
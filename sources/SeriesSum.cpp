@@ -0,0 +1,114 @@
+#include "SeriesSum.hpp"   // Include header file
+#include <exception>       // Include std::exception_ptr
+#include <stdexcept>       // Include exception classes
+#include <thread>          // Include worker threads
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+    // Ranges shorter than this are summed on the current thread unless a thread count is given.
+    const long long MIN_PARALLEL_TERMS = 2048;
+
+    // The unreduced sum of a range is t / (b * q); p and q are the products of the ratios over the range.
+    struct Split {
+        BigInt p;
+        BigInt q;
+        BigInt b;
+        BigInt t;
+    };
+
+    Split leaf(const function<SeriesTerm(long long)>& term, long long index) {
+        SeriesTerm value = term(index);
+        if (value.q == 0 || value.b == 0) {
+            throw invalid_argument("Denominator cannot be zero");
+        }
+        BigInt p(value.p);
+        return {p, BigInt(value.q), BigInt(value.b), p * BigInt(value.a)};
+    }
+
+    /**
+     * @brief Sum [first, last) as an unreduced split; the left half goes to a new thread while depth lasts.
+     */
+    Split split(const function<SeriesTerm(long long)>& term, long long first, long long last, unsigned depth, long long minParallel) {
+        if (last - first == 1) {
+            return leaf(term, first);
+        }
+        long long middle = first + (last - first) / 2;
+        Split left, right;
+        if (depth > 0 && last - first >= minParallel) {
+            exception_ptr error;
+            thread worker([&]() {
+                try {
+                    left = split(term, first, middle, depth - 1, minParallel);
+                } catch (...) {
+                    error = current_exception();
+                }
+            });
+            try {
+                right = split(term, middle, last, depth - 1, minParallel);
+            } catch (...) {
+                worker.join();
+                throw;
+            }
+            worker.join();
+            if (error) {
+                rethrow_exception(error);
+            }
+        } else {
+            left = split(term, first, middle, 0, minParallel);
+            right = split(term, middle, last, 0, minParallel);
+        }
+        // S = S1 + P1/Q1 * S2 = (T1 * B2 * Q2 + B1 * P1 * T2) / (B1 * B2 * Q1 * Q2)
+        Split merged;
+        merged.t = left.t * right.b * right.q + left.b * left.p * right.t;
+        merged.p = left.p * right.p;
+        merged.q = left.q * right.q;
+        merged.b = left.b * right.b;
+        return merged;
+    }
+}
+
+/**
+ * @brief Sum a series by binary splitting. Every product is formed between operands of similar size,
+ * so the cost follows fast multiplication of the final size rather than growing quadratically per term,
+ * and only the final fraction is reduced.
+ * @param term Gives p, q, a and b for index k; the term is a/b * p(first)...p(k) / (q(first)...q(k)).
+ * @param first The first index.
+ * @param last One past the last index; an empty range sums to 0.
+ * @param threads The number of threads, or 0 to pick one per hardware thread for long ranges.
+ * @return The exact sum in lowest terms.
+ * @throws invalid_argument If a q or b is zero.
+ */
+BigFraction ariel::sum_series(const function<SeriesTerm(long long)>& term, long long first, long long last, unsigned threads) {
+    if (last <= first) {
+        return BigFraction();
+    }
+    long long minParallel = (threads == 0) ? MIN_PARALLEL_TERMS : 2;
+    if (threads == 0) {
+        threads = thread::hardware_concurrency();
+    }
+    unsigned depth = 0;
+    while ((1U << depth) < threads) {
+        ++depth;
+    }
+    Split sum = split(term, first, last, depth, minParallel);
+    return BigFraction(sum.t, sum.b * sum.q);
+}
+
+/**
+ * @brief Sum fractions by binary splitting; each term becomes a/b with unit ratio.
+ * @param term Gives the fraction for index k.
+ * @param first The first index.
+ * @param last One past the last index.
+ * @param threads The number of threads, or 0 to pick one per hardware thread for long ranges.
+ * @return The exact sum in lowest terms.
+ */
+BigFraction ariel::sum_fractions(const function<Fraction(long long)>& term, long long first, long long last, unsigned threads) {
+    return sum_series(
+        [&term](long long index) {
+            Fraction value = term(index);
+            return SeriesTerm{1, 1, value.getNumerator(), value.getDenominator()};
+        },
+        first, last, threads);
+}
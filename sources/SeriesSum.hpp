@@ -0,0 +1,28 @@
+#ifndef SERIESSUM_HPP
+#define SERIESSUM_HPP
+
+#include "BigFraction.hpp"
+#include "Fraction.hpp"
+#include <functional>
+
+namespace ariel {
+
+    // One term of a hypergeometric-style series: the term at k is a/b times the running product of p/q
+    // from the first index through k.
+    struct SeriesTerm {
+        long long p = 1;
+        long long q = 1;
+        long long a = 1;
+        long long b = 1;
+    };
+
+    // Sum term(k) for k in [first, last) by binary splitting: integer P/Q/B/T products are built up a
+    // balanced tree, subtrees on separate threads (0 = one per core for long ranges), and the result is
+    // reduced once at the end. Throws std::invalid_argument if a q or b is zero.
+    BigFraction sum_series(const std::function<SeriesTerm(long long)>& term, long long first, long long last, unsigned threads = 0);
+
+    // The plain sum of term(k) for k in [first, last), by the same method.
+    BigFraction sum_fractions(const std::function<Fraction(long long)>& term, long long first, long long last, unsigned threads = 0);
+}
+
+#endif /* SERIESSUM_HPP */
@@ -0,0 +1,456 @@
+#include "Simplex.hpp"   // Include header file
+#include <stdexcept>     // Include exception classes
+#include <utility>       // Include std::move
+
+using namespace std;     // Use standard namespace
+using namespace ariel;   // Use namespace ariel
+
+namespace {
+    const size_t NO_ROW = static_cast<size_t>(-1);
+
+    /**
+     * @brief Scale a row of fractions and its right-hand side to integers by the lcm of their denominators.
+     * @return The lcm used.
+     */
+    BigInt integerRow(const vector<Fraction>& values, const Fraction& extra, vector<BigInt>& out, BigInt& outExtra) {
+        BigInt common(extra.getDenominator());
+        for (const Fraction& value : values) {
+            BigInt denominator(value.getDenominator());
+            common = common / BigInt::gcd(common, denominator) * denominator;
+        }
+        out.assign(values.size(), BigInt(0));
+        for (size_t index = 0; index < values.size(); ++index) {
+            if (values[index].getNumerator() != 0) {
+                out[index] = BigInt(values[index].getNumerator()) * (common / BigInt(values[index].getDenominator()));
+            }
+        }
+        outExtra = BigInt(extra.getNumerator()) * (common / BigInt(extra.getDenominator()));
+        return common;
+    }
+
+    /**
+     * @brief Divide a row, its right-hand side and its scale (if any) by their common content.
+     */
+    void reduce(vector<BigInt>& entries, BigInt& rhs, BigInt* scale) {
+        BigInt one(1);
+        BigInt content = (scale != nullptr) ? scale->abs() : rhs.abs();
+        if (scale != nullptr) {
+            content = BigInt::gcd(content, rhs);
+        }
+        for (size_t index = 0; index < entries.size() && content != one; ++index) {
+            if (!entries[index].isZero()) {
+                content = BigInt::gcd(content, entries[index]);
+            }
+        }
+        if (content.isZero() || content == one) {
+            return;
+        }
+        for (BigInt& entry : entries) {
+            if (!entry.isZero()) {
+                entry = entry / content;
+            }
+        }
+        rhs = rhs / content;
+        if (scale != nullptr) {
+            *scale = *scale / content;
+        }
+    }
+
+    void negateRow(vector<BigInt>& entries, BigInt& rhs) {
+        for (BigInt& entry : entries) {
+            entry = -entry;
+        }
+        rhs = -rhs;
+    }
+}
+
+/**
+ * @brief Construct a problem with no constraints.
+ * @param objective The coefficients to maximize; its length is the number of variables.
+ */
+SimplexSolver::SimplexSolver(vector<Fraction> objective) : objective(std::move(objective)), pivots(0) {}
+
+/**
+ * @brief Add the constraint coefficients . x (kind) bound.
+ * @param coefficients One coefficient per variable.
+ * @param kind <=, = or >=.
+ * @param bound The right-hand side.
+ * @return The index of the constraint.
+ * @throws invalid_argument If the number of coefficients differs from the number of variables.
+ */
+size_t SimplexSolver::addConstraint(vector<Fraction> coefficients, ConstraintKind kind, const Fraction& bound) {
+    if (coefficients.size() != objective.size()) {
+        throw invalid_argument("Constraint length must match the number of variables");
+    }
+    this->coefficients.push_back(std::move(coefficients));
+    kinds.push_back(kind);
+    bounds.push_back(bound);
+    return bounds.size() - 1;
+}
+
+/**
+ * @brief Replace the objective, keeping the constraints.
+ * @param objective The coefficients to maximize.
+ * @throws invalid_argument If the number of coefficients differs from the number of variables.
+ */
+void SimplexSolver::setObjective(vector<Fraction> objective) {
+    if (objective.size() != this->objective.size()) {
+        throw invalid_argument("Objective length must match the number of variables");
+    }
+    this->objective = std::move(objective);
+}
+
+/**
+ * @brief Replace the right-hand side of one constraint.
+ * @param constraint The index returned by addConstraint().
+ * @param bound The new right-hand side.
+ * @throws invalid_argument If there is no such constraint.
+ */
+void SimplexSolver::setBound(size_t constraint, const Fraction& bound) {
+    if (constraint >= bounds.size()) {
+        throw invalid_argument("Constraint index out of range");
+    }
+    bounds[constraint] = bound;
+}
+
+/**
+ * @brief Get the number of variables.
+ * @return The length of the objective.
+ */
+size_t SimplexSolver::getVariableCount() const {
+    return objective.size();
+}
+
+/**
+ * @brief Get the number of constraints.
+ * @return The number of constraints added.
+ */
+size_t SimplexSolver::getConstraintCount() const {
+    return bounds.size();
+}
+
+/**
+ * @brief Build the integer tableau rows with a slack (+1) or surplus (-1) column per inequality.
+ * Columns from variables + constraints up to width start as zero and cannot enter the basis.
+ * @param width The number of columns.
+ */
+void SimplexSolver::buildRows(size_t width) {
+    size_t variables = objective.size();
+    size_t constraints = bounds.size();
+    rows.assign(constraints, vector<BigInt>());
+    rhs.assign(constraints, BigInt(0));
+    basic.assign(constraints, NO_ROW);
+    constraintOf.resize(constraints);
+    for (size_t row = 0; row < constraints; ++row) {
+        constraintOf[row] = row;
+    }
+    costs.clear();
+    enterable.assign(width, 0);
+    for (size_t column = 0; column < variables; ++column) {
+        enterable[column] = 1;
+    }
+    for (size_t row = 0; row < constraints; ++row) {
+        integerRow(coefficients[row], bounds[row], rows[row], rhs[row]);
+        rows[row].resize(width, BigInt(0));
+        if (kinds[row] != ConstraintKind::Equal) {
+            rows[row][variables + row] = BigInt(kinds[row] == ConstraintKind::LessEqual ? 1 : -1);
+            enterable[variables + row] = 1;
+        }
+        reduce(rows[row], rhs[row], nullptr);
+    }
+}
+
+/**
+ * @brief Subtract a multiple of a tableau row from target so that target[column] becomes zero.
+ * target is first multiplied by the positive pivot entry, so no division is needed, then its content is removed.
+ * @param target The row to update.
+ * @param targetRhs Its right-hand side.
+ * @param targetScale Its objective scale, or nullptr for a constraint row.
+ * @param row The tableau row to subtract; its entry in column must be positive.
+ * @param column The column to clear.
+ */
+void SimplexSolver::eliminate(vector<BigInt>& target, BigInt& targetRhs, BigInt* targetScale, size_t row, size_t column) const {
+    if (target[column].isZero()) {
+        return;
+    }
+    BigInt factor = target[column];
+    const BigInt& pivotEntry = rows[row][column];
+    bool unit = pivotEntry == BigInt(1);
+    const vector<BigInt>& source = rows[row];
+    for (size_t index = 0; index < target.size(); ++index) {
+        if (!unit && !target[index].isZero()) {
+            target[index] *= pivotEntry;
+        }
+        if (!source[index].isZero()) {
+            target[index] -= source[index] * factor;
+        }
+    }
+    if (!unit) {
+        targetRhs *= pivotEntry;
+    }
+    targetRhs -= rhs[row] * factor;
+    if (targetScale != nullptr && !unit) {
+        *targetScale *= pivotEntry;
+    }
+    reduce(target, targetRhs, targetScale);
+}
+
+/**
+ * @brief Make column basic in row: the row is negated if needed so its pivot entry is positive,
+ * then the column is cleared from every other row and from the objective row.
+ * @param row The leaving row.
+ * @param column The entering column.
+ */
+void SimplexSolver::pivot(size_t row, size_t column) {
+    if (rows[row][column].sign() < 0) {
+        negateRow(rows[row], rhs[row]);
+    }
+    for (size_t other = 0; other < rows.size(); ++other) {
+        if (other != row) {
+            eliminate(rows[other], rhs[other], nullptr, row, column);
+        }
+    }
+    if (!costs.empty()) {
+        eliminate(costs, costRhs, &costScale, row, column);
+    }
+    basic[row] = column;
+    ++pivots;
+}
+
+/**
+ * @brief Remove a redundant row from the tableau; its constraint reports DROPPED_ROW in the basis.
+ * @param row The row, which must have no basic column.
+ */
+void SimplexSolver::dropRow(size_t row) {
+    rows.erase(rows.begin() + static_cast<long>(row));
+    rhs.erase(rhs.begin() + static_cast<long>(row));
+    basic.erase(basic.begin() + static_cast<long>(row));
+    constraintOf.erase(constraintOf.begin() + static_cast<long>(row));
+}
+
+/**
+ * @brief Install an objective row and clear it on every basic column.
+ * @param values The integer objective entries, one per column; entry j is -scale * c_j.
+ * @param scale The positive scale of z.
+ */
+void SimplexSolver::setCosts(const vector<BigInt>& values, const BigInt& scale) {
+    costs = values;
+    costs.resize(enterable.size(), BigInt(0));
+    costRhs = BigInt(0);
+    costScale = scale;
+    for (size_t row = 0; row < rows.size(); ++row) {
+        eliminate(costs, costRhs, &costScale, row, basic[row]);
+    }
+}
+
+/**
+ * @brief Pivot until no column improves the objective, using Bland's rule: the lowest enterable column
+ * with a negative cost enters, and ties in the ratio test go to the lowest basic column.
+ * @return false if the entering column is unbounded.
+ */
+bool SimplexSolver::iterate() {
+    for (;;) {
+        size_t entering = 0;
+        while (entering < costs.size() && (enterable[entering] == 0 || costs[entering].sign() >= 0)) {
+            ++entering;
+        }
+        if (entering == costs.size()) {
+            return true;
+        }
+        size_t leaving = NO_ROW;
+        for (size_t row = 0; row < rows.size(); ++row) {
+            const BigInt& entry = rows[row][entering];
+            if (entry.sign() <= 0) {
+                continue;
+            }
+            if (leaving == NO_ROW) {
+                leaving = row;
+                continue;
+            }
+            // rhs[row] / entry against rhs[leaving] / rows[leaving][entering], both denominators positive
+            BigInt candidate = rhs[row] * rows[leaving][entering];
+            BigInt best = rhs[leaving] * entry;
+            if (candidate < best || (candidate == best && basic[row] < basic[leaving])) {
+                leaving = row;
+            }
+        }
+        if (leaving == NO_ROW) {
+            return false;
+        }
+        pivot(leaving, entering);
+    }
+}
+
+/**
+ * @brief Install the real objective, z - c . x = 0 scaled to integers, and pivot to the optimum.
+ * @param warmStarted Whether a given basis was used.
+ * @return The result.
+ */
+SimplexResult SimplexSolver::phaseTwo(bool warmStarted) {
+    vector<BigInt> values;
+    BigInt unused;
+    BigInt scale = integerRow(objective, Fraction(0, 1), values, unused);
+    for (BigInt& value : values) {
+        value = -value;
+    }
+    setCosts(values, scale);
+    return finish(iterate() ? SimplexStatus::Optimal : SimplexStatus::Unbounded, warmStarted);
+}
+
+/**
+ * @brief Read the solution off the tableau.
+ * @param status The outcome.
+ * @param warmStarted Whether a given basis was used.
+ * @return The result; values and objective only when optimal.
+ */
+SimplexResult SimplexSolver::finish(SimplexStatus status, bool warmStarted) const {
+    SimplexResult result;
+    result.status = status;
+    result.basis.assign(bounds.size(), SimplexResult::DROPPED_ROW);
+    for (size_t row = 0; row < rows.size(); ++row) {
+        result.basis[constraintOf[row]] = basic[row];
+    }
+    result.pivots = pivots;
+    result.warmStarted = warmStarted;
+    if (status != SimplexStatus::Optimal) {
+        return result;
+    }
+    result.values.assign(objective.size(), BigFraction());
+    for (size_t row = 0; row < rows.size(); ++row) {
+        if (basic[row] < objective.size()) {
+            result.values[basic[row]] = BigFraction(rhs[row], rows[row][basic[row]]);
+        }
+    }
+    result.objective = BigFraction(costRhs, costScale);
+    return result;
+}
+
+/**
+ * @brief Pivot a given basis into a fresh tableau. For each DROPPED_ROW entry one row must be left
+ * without a basic column, and such rows must have reduced to 0 = 0; they are dropped again.
+ * @param basis One column or DROPPED_ROW per constraint, as in SimplexResult::basis.
+ * @return false if the basis does not fit the problem, is singular or is not primal feasible.
+ */
+bool SimplexSolver::warmStart(const vector<size_t>& basis) {
+    size_t width = objective.size() + bounds.size();
+    if (basis.size() != bounds.size()) {
+        return false;
+    }
+    buildRows(width);
+    vector<char> used(width, 0);
+    for (size_t column : basis) {
+        if (column == SimplexResult::DROPPED_ROW) {
+            continue;
+        }
+        if (column >= width || enterable[column] == 0 || used[column] != 0) {
+            return false;
+        }
+        used[column] = 1;
+        size_t row = 0;
+        while (row < rows.size() && (basic[row] != NO_ROW || rows[row][column].isZero())) {
+            ++row;
+        }
+        if (row == rows.size()) {
+            return false;
+        }
+        pivot(row, column);
+    }
+    for (size_t row = rows.size(); row-- > 0;) {
+        if (basic[row] != NO_ROW) {
+            continue;
+        }
+        for (const BigInt& entry : rows[row]) {
+            if (!entry.isZero()) {
+                return false;
+            }
+        }
+        if (!rhs[row].isZero()) {
+            return false;
+        }
+        dropRow(row);
+    }
+    for (const BigInt& value : rhs) {
+        if (value.sign() < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Solve from scratch. Phase one starts from the slack basis, with an artificial column for each
+ * row whose slack cannot be basic, and minimizes their sum; phase two then maximizes the objective.
+ * @return The status, and the optimum and a basis when optimal.
+ */
+SimplexResult SimplexSolver::solve() {
+    size_t variables = objective.size();
+    size_t constraints = bounds.size();
+    size_t width = variables + constraints;
+    pivots = 0;
+    buildRows(width + constraints);
+    bool phaseOne = false;
+    for (size_t row = 0; row < constraints; ++row) {
+        if (rhs[row].sign() < 0) {
+            negateRow(rows[row], rhs[row]);
+        }
+        if (rows[row][variables + row].sign() > 0) {
+            basic[row] = variables + row;
+        } else {
+            rows[row][width + row] = BigInt(1);
+            basic[row] = width + row;
+            phaseOne = true;
+        }
+    }
+    if (phaseOne) {
+        // maximize -(sum of artificials): z + sum a = 0
+        vector<BigInt> artificial(width + constraints, BigInt(0));
+        for (size_t row = 0; row < constraints; ++row) {
+            if (basic[row] >= width) {
+                artificial[basic[row]] = BigInt(1);
+            }
+        }
+        setCosts(artificial, BigInt(1));
+        iterate();
+        if (!costRhs.isZero()) {
+            return finish(SimplexStatus::Infeasible, false);
+        }
+        // Artificials still basic are at zero: swap them for any real column, or drop the redundant row.
+        for (size_t row = 0; row < rows.size();) {
+            if (basic[row] < width) {
+                ++row;
+                continue;
+            }
+            size_t column = 0;
+            while (column < width && (enterable[column] == 0 || rows[row][column].isZero())) {
+                ++column;
+            }
+            if (column < width) {
+                pivot(row, column);
+                ++row;
+            } else {
+                dropRow(row);
+            }
+        }
+    }
+    for (vector<BigInt>& row : rows) {
+        row.resize(width);
+    }
+    enterable.resize(width);
+    costs.clear();
+    return phaseTwo(false);
+}
+
+/**
+ * @brief Solve starting from a basis of an earlier solve, typically after setObjective() or setBound().
+ * If the basis is still primal feasible, phase one is skipped and phase two continues from it;
+ * otherwise this is a cold solve().
+ * @param basis The basis from an earlier SimplexResult.
+ * @return The status, and the optimum and a basis when optimal.
+ */
+SimplexResult SimplexSolver::solve(const vector<size_t>& basis) {
+    pivots = 0;
+    if (!warmStart(basis)) {
+        return solve();
+    }
+    return phaseTwo(true);
+}
@@ -0,0 +1,90 @@
+#ifndef SIMPLEX_HPP
+#define SIMPLEX_HPP
+
+#include "BigFraction.hpp"
+#include "BigInt.hpp"
+#include "Fraction.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace ariel {
+
+    enum class ConstraintKind {
+        LessEqual,
+        Equal,
+        GreaterEqual,
+    };
+
+    enum class SimplexStatus {
+        Optimal,
+        Infeasible,
+        Unbounded,
+    };
+
+    struct SimplexResult {
+        // The basis entry of a constraint whose row phase one found redundant and dropped.
+        static constexpr std::size_t DROPPED_ROW = static_cast<std::size_t>(-1);
+
+        SimplexStatus status = SimplexStatus::Infeasible;
+        BigFraction objective;            // when Optimal
+        std::vector<BigFraction> values;  // one per variable, when Optimal
+        std::vector<std::size_t> basis;   // the final basic column per constraint, or DROPPED_ROW; to warm-start a later solve
+        std::size_t pivots = 0;
+        bool warmStarted = false;         // whether the given basis was used
+    };
+
+    // An exact dense two-phase simplex: maximize objective . x subject to the constraints and x >= 0.
+    // Each tableau row is kept as integers over an implicit common denominator (an equation may be
+    // scaled freely), so a pivot is a fraction-free integer row operation followed by one content gcd
+    // per row. Bland's rule picks the entering and leaving columns, so degenerate problems cannot cycle.
+    // Columns are the variables, then one slack or surplus column per constraint.
+    class SimplexSolver {
+        private:
+            std::vector<Fraction> objective;
+            std::vector<std::vector<Fraction>> coefficients;
+            std::vector<ConstraintKind> kinds;
+            std::vector<Fraction> bounds;
+
+            // tableau: rows[i] . columns = rhs[i], and basic[i] has a positive coefficient in row i
+            std::vector<std::vector<BigInt>> rows;
+            std::vector<BigInt> rhs;
+            std::vector<std::size_t> basic;
+            std::vector<std::size_t> constraintOf;  // the constraint each row came from; rows are only ever dropped
+            std::vector<char> enterable;
+
+            // objective row: scale * z + costs . columns = costRhs, with scale > 0
+            std::vector<BigInt> costs;
+            BigInt costRhs;
+            BigInt costScale;
+            std::size_t pivots;
+
+            void buildRows(std::size_t width);
+            void setCosts(const std::vector<BigInt>& values, const BigInt& scale);
+            void eliminate(std::vector<BigInt>& target, BigInt& targetRhs, BigInt* targetScale, std::size_t row, std::size_t column) const;
+            void pivot(std::size_t row, std::size_t column);
+            void dropRow(std::size_t row);
+            bool iterate();  // false if unbounded
+            SimplexResult phaseTwo(bool warmStarted);
+            SimplexResult finish(SimplexStatus status, bool warmStarted) const;
+            bool warmStart(const std::vector<std::size_t>& basis);
+
+        public:
+            // constructors
+            explicit SimplexSolver(std::vector<Fraction> objective);  // maximize objective . x
+
+            // building the problem; all throw std::invalid_argument on a length mismatch or bad index
+            std::size_t addConstraint(std::vector<Fraction> coefficients, ConstraintKind kind, const Fraction& bound);  // returns its index
+            void setObjective(std::vector<Fraction> objective);
+            void setBound(std::size_t constraint, const Fraction& bound);
+
+            // getter functions
+            std::size_t getVariableCount() const;
+            std::size_t getConstraintCount() const;
+
+            // solving
+            SimplexResult solve();
+            SimplexResult solve(const std::vector<std::size_t>& basis);  // warm start; falls back to a cold start if the basis is unusable
+    };
+}
+
+#endif /* SIMPLEX_HPP */